@@ -187,6 +187,9 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Threads library, used by the native threads backend (Backend::THREADS)
+THREADS_LIB = $(if $(NOTMAC),-lpthread,)
+
 # SUNDIALS library configuration
 SUNDIALS_DIR = @MFEM_DIR@/../sundials-5.0.0/instdir
 SUNDIALS_OPT = -I$(SUNDIALS_DIR)/include
@@ -114,17 +114,16 @@ FE_Evolution::FE_Evolution(FiniteElementSpace &_vfes,
      flux(vfes.GetNDofs(), dim, num_equation),
      z(A.Height())
 {
-   // Standard local assembly and inversion for energy mass matrices.
+   // Standard local assembly and batched inversion for energy mass matrices.
    const int dof = vfes.GetFE(0)->GetDof();
    DenseMatrix Me(dof);
-   DenseMatrixInverse inv(&Me);
    MassIntegrator mi;
    for (int i = 0; i < vfes.GetNE(); i++)
    {
       mi.AssembleElementMatrix(*vfes.GetFE(i), *vfes.GetElementTransformation(i), Me);
-      inv.Factor();
-      inv.GetInverseMatrix(Me_inv(i));
+      Me_inv(i) = Me;
    }
+   BatchInverse(Me_inv, Me_inv);
 }
 
 void FE_Evolution::Mult(const Vector &x, Vector &y) const
@@ -13,6 +13,9 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace mfem
@@ -63,6 +66,309 @@ void BilinearForm::AllocMat()
    dof_dof.LoseData();
 }
 
+// Return the table of the element vdofs of fes, with decoded signs.
+static void GetElementToVDofTable(const FiniteElementSpace &fes,
+                                  Table &el_vdof)
+{
+   Array<int> vdofs;
+   const int NE = fes.GetNE();
+   el_vdof.MakeI(NE);
+   for (int i = 0; i < NE; i++)
+   {
+      fes.GetElementVDofs(i, vdofs);
+      el_vdof.AddColumnsInRow(i, vdofs.Size());
+   }
+   el_vdof.MakeJ();
+   for (int i = 0; i < NE; i++)
+   {
+      fes.GetElementVDofs(i, vdofs);
+      for (int j = 0; j < vdofs.Size(); j++)
+      {
+         const int vdof = vdofs[j];
+         el_vdof.AddConnection(i, (vdof >= 0) ? vdof : -1-vdof);
+      }
+   }
+   el_vdof.ShiftUpI();
+}
+
+// Finalized matrix, filled with zeros, with the rows and columns coupled by
+// the element vdofs of test_fes and trial_fes, respectively.
+static SparseMatrix *ElementSparsityPattern(const FiniteElementSpace &test_fes,
+                                            const FiniteElementSpace &trial_fes)
+{
+   const int height = test_fes.GetVSize();
+   const int width = trial_fes.GetVSize();
+   Table el_test, el_trial, test_el, test_trial;
+   GetElementToVDofTable(test_fes, el_test);
+   GetElementToVDofTable(trial_fes, el_trial);
+   Transpose(el_test, test_el, height);
+   mfem::Mult(test_el, el_trial, test_trial);
+   test_trial.SortRows();
+
+   int *I = test_trial.GetI();
+   int *J = test_trial.GetJ();
+   double *data = Memory<double>(I[height]);
+
+   SparseMatrix *mat = new SparseMatrix(I, J, data, height, width,
+                                        true, true, true);
+   *mat = 0.0;
+
+   test_trial.LoseData();
+   return mat;
+}
+
+// Add the element matrix 'elmat' to the finalized matrix with row offsets I,
+// sorted column indices J and values A, as SparseMatrix::AddSubMatrix() does.
+// Concurrent calls are safe if they have no rows in common.
+static void AddElementMatrix(const Array<int> &rows, const Array<int> &cols,
+                             const DenseMatrix &elmat, int skip_zeros,
+                             const int *I, const int *J, double *A)
+{
+   for (int i = 0; i < rows.Size(); i++)
+   {
+      int gi = rows[i], s = 1;
+      if (gi < 0) { gi = -1-gi; s = -1; }
+      const int *row_begin = J + I[gi], *row_end = J + I[gi+1];
+      for (int j = 0; j < cols.Size(); j++)
+      {
+         int gj = cols[j], t = s;
+         if (gj < 0) { gj = -1-gj; t = -s; }
+         double a = elmat(i, j);
+         if (skip_zeros && a == 0.0)
+         {
+            // see SparseMatrix::AddSubMatrix()
+            if (&rows != &cols || elmat(j, i) == 0.0) { continue; }
+         }
+         if (t < 0) { a = -a; }
+         const int *pos = std::lower_bound(row_begin, row_end, gj);
+         MFEM_VERIFY(pos != row_end && *pos == gj,
+                     "Entry for column " << gj << " is not allocated.");
+         A[pos - J] += a;
+      }
+   }
+}
+
+// Fill 'map' with the signed indices, in the data of the finalized matrix with
+// row offsets I and sorted column indices J, of the entries of an element
+// matrix with the given vdofs, in column-major order; see elem_scatter.
+static void MakeScatterMap(const Array<int> &vdofs, const int *I, const int *J,
+                           int *map)
+{
+   const int n = vdofs.Size();
+   for (int j = 0; j < n; j++)
+   {
+      int gj = vdofs[j], s = 1;
+      if (gj < 0) { gj = -1-gj; s = -1; }
+      for (int i = 0; i < n; i++)
+      {
+         int gi = vdofs[i], t = s;
+         if (gi < 0) { gi = -1-gi; t = -s; }
+         const int *row_begin = J + I[gi], *row_end = J + I[gi+1];
+         const int *pos = std::lower_bound(row_begin, row_end, gj);
+         MFEM_VERIFY(pos != row_end && *pos == gj,
+                     "Entry for column " << gj << " is not allocated.");
+         const int k = pos - J;
+         map[i + j*n] = (t > 0) ? k : -1-k;
+      }
+   }
+}
+
+// Add the element matrix 'elmat' to the matrix values A through the scatter
+// map of the element, see MakeScatterMap().
+static void AddElementMatrix(const int *map, const DenseMatrix &elmat,
+                             double *A)
+{
+   const int n = elmat.Height()*elmat.Width();
+   const double *data = elmat.Data();
+   for (int p = 0; p < n; p++)
+   {
+      const int k = map[p];
+      if (k >= 0) { A[k] += data[p]; }
+      else { A[-1-k] -= data[p]; }
+   }
+}
+
+bool BilinearForm::UseScatterMaps() const
+{
+   return (reuse_sparsity && !static_cond && !hybridization &&
+           fbfi.Size() == 0);
+}
+
+void BilinearForm::SetupScatterMaps()
+{
+   delete mat_e;
+   mat_e = NULL;
+
+   Array<int> vdofs;
+   if (mat != NULL && mat == scatter_mat &&
+       scatter_sequence == fes->GetSequence())
+   {
+      *mat = 0.0;
+   }
+   else
+   {
+      delete mat;
+      mat = ElementSparsityPattern(*fes, *fes);
+      height = width = fes->GetVSize();
+      const int *I = mat->HostReadI(), *J = mat->HostReadJ();
+
+      const int NE = fes->GetNE();
+      elem_scatter.MakeI(NE);
+      for (int i = 0; i < NE; i++)
+      {
+         const int n = fes->GetFE(i)->GetDof()*fes->GetVDim();
+         elem_scatter.AddColumnsInRow(i, n*n);
+      }
+      elem_scatter.MakeJ();
+      for (int i = 0; i < NE; i++)
+      {
+         fes->GetElementVDofs(i, vdofs);
+         MakeScatterMap(vdofs, I, J, elem_scatter.GetRow(i));
+      }
+      bdr_scatter.Clear();
+
+      scatter_mat = mat;
+      scatter_sequence = fes->GetSequence();
+      scatter_version++;
+   }
+
+   // The boundary maps are built when boundary integrators are present.
+   const int NBE = fes->GetNBE();
+   if (bbfi.Size() && bdr_scatter.Size() != NBE)
+   {
+      const int *I = mat->HostReadI(), *J = mat->HostReadJ();
+      bdr_scatter.MakeI(NBE);
+      for (int i = 0; i < NBE; i++)
+      {
+         const int n = fes->GetBE(i)->GetDof()*fes->GetVDim();
+         bdr_scatter.AddColumnsInRow(i, n*n);
+      }
+      bdr_scatter.MakeJ();
+      for (int i = 0; i < NBE; i++)
+      {
+         fes->GetBdrElementVDofs(i, vdofs);
+         MakeScatterMap(vdofs, I, J, bdr_scatter.GetRow(i));
+      }
+   }
+}
+
+bool BilinearForm::UseColoredAssembly() const
+{
+   return (Device::Allows(Backend::THREADS) && dbfi.Size() > 0 &&
+           !static_cond && !hybridization && fbfi.Size() == 0 &&
+           (mat == NULL || mat->Finalized()));
+}
+
+bool BilinearForm::UseColoredEA() const
+{
+   const Mesh *mesh = fes->GetMesh();
+   if (fes->GetVDim() != 1 || fes->GetNURBSext() || fes->GetNE() == 0 ||
+       mesh->GetNumGeometries(mesh->Dimension()) > 1)
+   {
+      return false;
+   }
+   for (int i = 0; i < dbfi.Size(); i++)
+   {
+      if (!dbfi[i]->SupportsEA()) { return false; }
+   }
+   return true;
+}
+
+void BilinearForm::AssembleColoredElements(int skip_zeros)
+{
+   if (mat == NULL) { mat = ElementSparsityPattern(*fes, *fes); }
+   if (!mat->ColumnsAreSorted()) { mat->SortColumnIndices(); }
+   const int *I = mat->HostReadI();
+   const int *J = mat->HostReadJ();
+   double *A = mat->HostReadWriteData();
+   const int *elems = fes->GetElementColoring().GetJ();
+   const bool scatter = UseScatterMaps();
+
+   // The integrators and finite elements keep shared scratch data unless MFEM
+   // is built with MFEM_THREAD_SAFE. The element assembly kernels, see
+   // BilinearFormIntegrator::AssembleEA(), do not, so the element matrices
+   // are computed with them up front when possible; then only the scatter
+   // runs inside the colored traversal.
+   const bool ea = !element_matrices && UseColoredEA();
+   const int ne = fes->GetNE();
+   const int nd = (ea && ne > 0) ? fes->GetFE(0)->GetDof() : 0;
+   Vector ea_data;
+   const int *dof_map = NULL;
+   if (ea)
+   {
+      ea_data.SetSize(ne*nd*nd, Device::GetMemoryType());
+      ea_data.UseDevice(true);
+      ea_data = 0.0;
+      for (int n = 0; n < dbfi.Size(); n++)
+      {
+         dbfi[n]->AssembleEA(*fes, ea_data);
+      }
+      const TensorBasisElement *tfe =
+         dynamic_cast<const TensorBasisElement*>(fes->GetFE(0));
+      if (tfe && tfe->GetDofMap().Size() > 0)
+      {
+         dof_map = tfe->GetDofMap().GetData();
+      }
+   }
+   // The matrix of element e is E(j,i,e) in the row i and the column j, in
+   // the lexicographic ordering of the dofs for tensor product elements.
+   const auto E = Reshape(ea_data.HostRead(), nd, nd, ne);
+
+   fes->ForAllColoredElements([&](int begin, int end)
+   {
+      Array<int> vdofs;
+      DenseMatrix elmat, elmat_k;
+      IsoparametricTransformation eltrans;
+      for (int k = begin; k < end; k++)
+      {
+         const int i = elems[k];
+         fes->GetElementVDofs(i, vdofs);
+         if (element_matrices)
+         {
+            elmat.UseExternalData(element_matrices->GetData(i),
+                                  element_matrices->SizeI(),
+                                  element_matrices->SizeJ());
+         }
+         else if (ea)
+         {
+            elmat.SetSize(nd);
+            for (int c = 0; c < nd; c++)
+            {
+               const int sc = dof_map ? dof_map[c] : c;
+               const int jc = (sc >= 0) ? sc : -1-sc;
+               for (int r = 0; r < nd; r++)
+               {
+                  const int sr = dof_map ? dof_map[r] : r;
+                  const int ir = (sr >= 0) ? sr : -1-sr;
+                  const bool plus = (sr >= 0) == (sc >= 0);
+                  elmat(ir, jc) = plus ? E(c, r, i) : -E(c, r, i);
+               }
+            }
+         }
+         else
+         {
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int n = 1; n < dbfi.Size(); n++)
+            {
+               dbfi[n]->AssembleElementMatrix(fe, eltrans, elmat_k);
+               elmat += elmat_k;
+            }
+         }
+         if (scatter)
+         {
+            AddElementMatrix(elem_scatter.GetRow(i), elmat, A);
+         }
+         else
+         {
+            AddElementMatrix(vdofs, vdofs, elmat, skip_zeros, I, J, A);
+         }
+         if (element_matrices) { elmat.ClearExternalData(); }
+      }
+   }, element_matrices || ea);
+}
+
 BilinearForm::BilinearForm(FiniteElementSpace * f)
    : Matrix (f->GetVSize())
 {
@@ -74,9 +380,14 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   reuse_sparsity = false;
+   scatter_mat = NULL;
+   scatter_sequence = -1;
+   scatter_version = 0;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
+   explicit_full = false;
    batch = 1;
    ext = NULL;
 }
@@ -92,9 +403,14 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   reuse_sparsity = false;
+   scatter_mat = NULL;
+   scatter_sequence = -1;
+   scatter_version = 0;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
+   explicit_full = false;
    batch = 1;
    ext = NULL;
 
@@ -122,8 +438,9 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    switch (assembly)
    {
       case AssemblyLevel::FULL:
-         // ext = new FABilinearFormExtension(this);
-         // Use the original BilinearForm implementation for now
+         // The FABilinearFormExtension, if any, is created in Assemble() when
+         // the integrators are known.
+         explicit_full = true;
          break;
       case AssemblyLevel::ELEMENT:
          ext = new EABilinearFormExtension(this);
@@ -132,8 +449,7 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
          ext = new PABilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFBilinearFormExtension(this);
+         ext = new MFBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
@@ -191,6 +507,7 @@ void BilinearForm::UseSparsity(int *I, int *J, bool isSorted)
          return; // mat is already using the given sparsity
       }
       delete mat;
+      scatter_mat = NULL;
    }
    height = width = fes->GetVSize();
    mat = new SparseMatrix(I, J, NULL, height, width, false, true, isSorted);
@@ -375,6 +692,17 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_SCOPE("BilinearForm::Assemble");
+   if (explicit_full)
+   {
+      // With a device backend, build the matrix from the element matrices on
+      // the device when the form allows it; otherwise, use the original
+      // BilinearForm implementation below.
+      const bool device_fa = Device::IsEnabled() &&
+                             FABilinearFormExtension::SupportsForm(*this);
+      if (device_fa && !ext) { ext = new FABilinearFormExtension(this); }
+      if (!device_fa && ext) { delete ext; ext = NULL; }
+   }
    if (ext)
    {
       ext->Assemble();
@@ -385,10 +713,17 @@ void BilinearForm::Assemble(int skip_zeros)
    Mesh *mesh = fes -> GetMesh();
    DenseMatrix elmat, *elmat_p;
 
-   if (mat == NULL)
+   const bool scatter = UseScatterMaps();
+   if (scatter)
+   {
+      SetupScatterMaps();
+   }
+   const bool colored = UseColoredAssembly();
+   if (mat == NULL && !colored)
    {
       AllocMat();
    }
+   double *A = scatter ? mat->HostReadWriteData() : NULL;
 
 #ifdef MFEM_USE_LEGACY_OPENMP
    int free_element_matrices = 0;
@@ -399,7 +734,11 @@ void BilinearForm::Assemble(int skip_zeros)
    }
 #endif
 
-   if (dbfi.Size())
+   if (colored)
+   {
+      AssembleColoredElements(skip_zeros);
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -424,6 +763,10 @@ void BilinearForm::Assemble(int skip_zeros)
          {
             static_cond->AssembleMatrix(i, *elmat_p);
          }
+         else if (scatter)
+         {
+            AddElementMatrix(elem_scatter.GetRow(i), *elmat_p, A);
+         }
          else
          {
             mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
@@ -484,7 +827,11 @@ void BilinearForm::Assemble(int skip_zeros)
             bbfi[k]->AssembleElementMatrix(be, *eltrans, elemmat);
             elmat += elemmat;
          }
-         if (!static_cond)
+         if (scatter)
+         {
+            AddElementMatrix(bdr_scatter.GetRow(i), elmat, A);
+         }
+         else if (!static_cond)
          {
             mat->AddSubMatrix(vdofs, vdofs, elmat, skip_zeros);
             if (hybridization)
@@ -584,6 +931,73 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+BSRMatrix *BilinearForm::AssembleBSR()
+{
+   const int vdim = fes->GetVDim();
+   MFEM_VERIFY(vdim == 1 || fes->GetOrdering() == Ordering::byVDIM,
+               "the block CSR assembly requires Ordering::byVDIM");
+   MFEM_VERIFY(!ext && !static_cond && !hybridization && fbfi.Size() == 0 &&
+               bfbfi.Size() == 0, "the block CSR assembly does not support "
+               "partial assembly, static condensation, hybridization or face "
+               "integrators");
+
+   // The block pattern is defined from the map: element->dof
+   const Table &elem_dof = fes->GetElementToDofTable();
+   const int ndofs = fes->GetNDofs();
+   for (int k = 0; k < elem_dof.Size_of_connections(); k++)
+   {
+      MFEM_VERIFY(elem_dof.GetJ()[k] >= 0, "the block CSR assembly does not "
+                  "support dofs with orientation");
+   }
+   Table dof_elem, dof_dof;
+   Transpose(elem_dof, dof_elem, ndofs);
+   mfem::Mult(dof_elem, elem_dof, dof_dof);
+   dof_dof.SortRows();
+   BSRMatrix *bsr = new BSRMatrix(dof_dof.GetI(), dof_dof.GetJ(), ndofs, ndofs,
+                                  vdim);
+   dof_dof.LoseData();
+
+   ElementTransformation *eltrans;
+   Mesh *mesh = fes->GetMesh();
+   DenseMatrix elmat;
+   if (dbfi.Size())
+   {
+      for (int i = 0; i < fes->GetNE(); i++)
+      {
+         const FiniteElement &fe = *fes->GetFE(i);
+         fes->GetElementVDofs(i, vdofs);
+         eltrans = fes->GetElementTransformation(i);
+         dbfi[0]->AssembleElementMatrix(fe, *eltrans, elmat);
+         for (int k = 1; k < dbfi.Size(); k++)
+         {
+            dbfi[k]->AssembleElementMatrix(fe, *eltrans, elemmat);
+            elmat += elemmat;
+         }
+         bsr->AddSubMatrix(vdofs, vdofs, elmat);
+      }
+   }
+
+   if (bbfi.Size())
+   {
+      for (int i = 0; i < fes->GetNBE(); i++)
+      {
+         const int bdr_attr = mesh->GetBdrAttribute(i);
+         const FiniteElement &be = *fes->GetBE(i);
+         fes->GetBdrElementVDofs(i, vdofs);
+         eltrans = fes->GetBdrElementTransformation(i);
+         for (int k = 0; k < bbfi.Size(); k++)
+         {
+            if (bbfi_marker[k] &&
+                (*bbfi_marker[k])[bdr_attr-1] == 0) { continue; }
+
+            bbfi[k]->AssembleElementMatrix(be, *eltrans, elmat);
+            bsr->AddSubMatrix(vdofs, vdofs, elmat);
+         }
+      }
+   }
+   return bsr;
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -599,6 +1013,7 @@ void BilinearForm::ConformingAssemble()
    SparseMatrix *R = Transpose(*P);
    SparseMatrix *RA = mfem::Mult(*R, *mat);
    delete mat;
+   scatter_mat = NULL;
    if (mat_e)
    {
       SparseMatrix *RAe = mfem::Mult(*R, *mat_e);
@@ -648,7 +1063,9 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
                                     Vector &b, OperatorHandle &A, Vector &X,
                                     Vector &B, int copy_interior)
 {
-   if (ext)
+   // The extension of AssemblyLevel::FULL only assembles 'mat', which is then
+   // used as with the original implementation.
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
       return;
@@ -716,7 +1133,7 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
 void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                     OperatorHandle &A)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
       return;
@@ -759,7 +1176,7 @@ void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 void BilinearForm::RecoverFEMSolution(const Vector &X,
                                       const Vector &b, Vector &x)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->RecoverFEMSolution(X, b, x);
       return;
@@ -1006,6 +1423,18 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultiMult(const MultiVector &X, MultiVector &Y) const
+{
+   if (ext)
+   {
+      ext->MultiMult(X, Y);
+   }
+   else
+   {
+      mat->MultiMult(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1033,6 +1462,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
    {
       delete mat;
       mat = NULL;
+      scatter_mat = NULL;
       delete hybridization;
       hybridization = NULL;
       sequence = fes->GetSequence();
@@ -1258,6 +1688,44 @@ void MixedBilinearForm::AddBdrTraceFaceIntegrator(BilinearFormIntegrator *bfi,
    btfbfi_marker.Append(&bdr_marker);
 }
 
+bool MixedBilinearForm::UseColoredAssembly() const
+{
+   return (Device::Allows(Backend::THREADS) && dbfi.Size() > 0 &&
+           tfbfi.Size() == 0 && btfbfi.Size() == 0 &&
+           (mat == NULL || mat->Finalized()));
+}
+
+void MixedBilinearForm::AssembleColoredElements(int skip_zeros)
+{
+   if (mat == NULL) { mat = ElementSparsityPattern(*test_fes, *trial_fes); }
+   if (!mat->ColumnsAreSorted()) { mat->SortColumnIndices(); }
+   const int *I = mat->HostReadI();
+   const int *J = mat->HostReadJ();
+   double *A = mat->HostReadWriteData();
+   const int *elems = test_fes->GetElementColoring().GetJ();
+
+   test_fes->ForAllColoredElements([&](int begin, int end)
+   {
+      Array<int> tr_vdofs, te_vdofs;
+      DenseMatrix elmat;
+      IsoparametricTransformation eltrans;
+      for (int k = begin; k < end; k++)
+      {
+         const int i = elems[k];
+         trial_fes->GetElementVDofs(i, tr_vdofs);
+         test_fes->GetElementVDofs(i, te_vdofs);
+         test_fes->GetElementTransformation(i, &eltrans);
+         for (int n = 0; n < dbfi.Size(); n++)
+         {
+            dbfi[n]->AssembleElementMatrix2(*trial_fes->GetFE(i),
+                                            *test_fes->GetFE(i),
+                                            eltrans, elmat);
+            AddElementMatrix(te_vdofs, tr_vdofs, elmat, skip_zeros, I, J, A);
+         }
+      }
+   });
+}
+
 void MixedBilinearForm::Assemble (int skip_zeros)
 {
    if (ext)
@@ -1272,12 +1740,17 @@ void MixedBilinearForm::Assemble (int skip_zeros)
 
    Mesh *mesh = test_fes -> GetMesh();
 
-   if (mat == NULL)
+   const bool colored = UseColoredAssembly();
+   if (colored)
+   {
+      AssembleColoredElements(skip_zeros);
+   }
+   else if (mat == NULL)
    {
       mat = new SparseMatrix(height, width);
    }
 
-   if (dbfi.Size())
+   if (dbfi.Size() && !colored)
    {
       for (int i = 0; i < test_fes -> GetNE(); i++)
       {
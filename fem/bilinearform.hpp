@@ -50,6 +50,8 @@ enum class AssemblyLevel
     SetAssemblyLevel() function. */
 class BilinearForm : public Matrix
 {
+   friend class FABilinearFormExtension;
+
 protected:
    /// Sparse matrix \f$ M \f$ to be associated with the form. Owned.
    SparseMatrix *mat;
@@ -64,6 +66,8 @@ protected:
 
    /// The assembly level of the form (full, partial, etc.)
    AssemblyLevel assembly;
+   /// True if AssemblyLevel::FULL was set with SetAssemblyLevel().
+   bool explicit_full;
    /// Element batch size used in the form action (1, 8, num_elems, etc.)
    int batch;
    /** @brief Extension for supporting Full Assembly (FA), Element Assembly (EA),
@@ -109,6 +113,42 @@ protected:
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /// Reuse the sparsity pattern of #mat in Assemble(), see
+   /// EnableSparsityReuse().
+   bool reuse_sparsity;
+
+   /** @brief Scatter maps of the elements and boundary elements: row i holds,
+       for each entry of the element matrix of element i in column-major
+       order, the index k of the corresponding entry in the data of #mat, or
+       -1-k if the sign of the entry has to be flipped. */
+   Table elem_scatter, bdr_scatter;
+
+   /// The matrix for which the scatter maps were built, NULL if none.
+   const SparseMatrix *scatter_mat;
+   /// FiniteElementSpace sequence of the scatter maps.
+   long scatter_sequence;
+   /// Incremented every time the scatter maps are rebuilt.
+   long scatter_version;
+
+   // Return true if Assemble() uses the cached pattern and scatter maps.
+   bool UseScatterMaps() const;
+
+   // Zero #mat and delete #mat_e if the scatter maps are valid; otherwise
+   // rebuild #mat with the element sparsity pattern, and the scatter maps.
+   void SetupScatterMaps();
+
+   // Return true if the domain integrators can be assembled with
+   // AssembleColoredElements().
+   bool UseColoredAssembly() const;
+
+   // Return true if AssembleColoredElements() can compute the element matrices
+   // of the domain integrators with BilinearFormIntegrator::AssembleEA().
+   bool UseColoredEA() const;
+
+   // Assemble the domain integrators into the finalized matrix 'mat', which is
+   // allocated if needed, traversing the elements by colors.
+   void AssembleColoredElements(int skip_zeros);
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -118,6 +158,8 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      reuse_sparsity = false;
+      scatter_mat = NULL; scatter_sequence = -1; scatter_version = 0;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::FULL;
       batch = 1;
@@ -159,6 +201,16 @@ public:
        - AssemblyLevel::ELEMENT
        - AssemblyLevel::NONE
 
+       When a device backend is enabled, see Device::IsEnabled(), setting
+       AssemblyLevel::FULL explicitly builds the SparseMatrix on the device from
+       the element matrices of the domain integrators, see
+       FABilinearFormExtension, if the form is supported by
+       FABilinearFormExtension::SupportsForm() at the time of Assemble(). Other
+       forms use the original host assembly. The elimination of the essential
+       dofs then proceeds as usual.
+
+       AssemblyLevel::NONE requires a mesh with nodes, see Mesh::EnsureNodes().
+
        This method must be called before assembly. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
@@ -206,6 +258,22 @@ public:
    /// Use the sparsity of @a A to allocate the internal SparseMatrix.
    void UseSparsity(SparseMatrix &A);
 
+   /** @brief Reuse the sparsity pattern and the element scatter maps of the
+       internal SparseMatrix in the subsequent calls to Assemble(). */
+   /** With this option, the first call to Assemble() builds the finalized
+       matrix with the sparsity pattern of the element dofs, and a map from the
+       entries of every element (and boundary element) matrix to the entries of
+       the SparseMatrix. The following calls reset the matrix to zero, delete
+       the matrix of eliminated b.c., and add the element matrices through the
+       cached maps, without allocation or search. The pattern and the maps are
+       rebuilt when the FiniteElementSpace changes, or when the internal matrix
+       is replaced, e.g. by ConformingAssemble() or LoseMat().
+
+       Note that, unlike the default behavior, Assemble() does not add to the
+       previously assembled values. The option is ignored with static
+       condensation, hybridization or interior face integrators. */
+   void EnableSparsityReuse(bool enable = true) { reuse_sparsity = enable; }
+
    /// Pre-allocate the internal SparseMatrix before assembly.
    /**  If the flag 'precompute sparsity'
        is set, the matrix is allocated in CSR format (i.e.
@@ -244,6 +312,9 @@ public:
    /// Matrix vector multiplication:  \f$ y = M x \f$
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Apply the matrix to all vectors of @a X, see Operator::MultiMult().
+   virtual void MultiMult(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Matrix vector multiplication with the original uneliminated
        matrix.  The original matrix is \f$ M + M_e \f$ so we have:
        \f$ y = M x + M_e x \f$ */
@@ -301,7 +372,8 @@ public:
 
    /**  @brief Nullifies the internal matrix \f$ M \f$ and returns a pointer
         to it.  Used for transfering ownership. */
-   SparseMatrix *LoseMat() { SparseMatrix *tmp = mat; mat = NULL; return tmp; }
+   SparseMatrix *LoseMat()
+   { SparseMatrix *tmp = mat; mat = NULL; scatter_mat = NULL; return tmp; }
 
    /// Returns a const reference to the sparse matrix of eliminated b.c.: \f$ M_e \f$
    const SparseMatrix &SpMatElim() const
@@ -353,8 +425,29 @@ public:
    }
 
    /// Assembles the form i.e. sums over all domain/bdr integrators.
+   /** When Backend::THREADS is enabled, the domain integrators are assembled by
+       traversing the elements by colors, see
+       FiniteElementSpace::ForAllColoredElements(), into a matrix with the
+       sparsity pattern of the element dofs. This requires that no static
+       condensation, hybridization or interior face integrators are used; the
+       coefficients must be thread-safe. The element matrices are computed
+       concurrently by BilinearFormIntegrator::AssembleEA() if all domain
+       integrators support it on a scalar space with one element geometry;
+       otherwise, the elements are processed concurrently only in builds with
+       MFEM_THREAD_SAFE.
+
+       See EnableSparsityReuse() for the reassembly into a cached pattern. */
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Assemble the domain and boundary integrators into a new block
+       CSR matrix with blocks of size vdim x vdim, returned to the caller. */
+   /** The FiniteElementSpace must use Ordering::byVDIM (or have vdim = 1) and
+       no static condensation, hybridization, interior face integrators or
+       partial assembly may be used. The block pattern is the one of the scalar
+       dofs of the elements, so that every block couples the vdim components
+       of two nodes. The internal SparseMatrix is not assembled. */
+   BSRMatrix *AssembleBSR();
+
    /** @brief Assemble the diagonal of the bilinear form into diag
 
        For adaptively refined meshes, this returns P^T d_e, where d_e is the
@@ -645,6 +738,14 @@ protected:
    DenseMatrix elemmat;
    Array<int>  trial_vdofs, test_vdofs;
 
+   // Return true if the domain integrators can be assembled with
+   // AssembleColoredElements().
+   bool UseColoredAssembly() const;
+
+   // Assemble the domain integrators into the finalized matrix 'mat', which is
+   // allocated if needed, traversing the elements by the colors of test_fes.
+   void AssembleColoredElements(int skip_zeros);
+
 private:
    /// Copy construction is not supported; body is undefined.
    MixedBilinearForm(const MixedBilinearForm &);
@@ -760,6 +861,13 @@ public:
    /** This method must be called before assembly. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
+   /** @brief Assemble the form, i.e. sum over all domain, boundary and trace
+       integrators. */
+   /** When Backend::THREADS is enabled and there are no trace face
+       integrators, the domain integrators are assembled by traversing the
+       elements by colors of the test space, see BilinearForm::Assemble().
+       The traversal is sequential unless MFEM is built with MFEM_THREAD_SAFE.
+   */
    void Assemble(int skip_zeros = 1);
 
    /** @brief Assemble the diagonal of ADA^T into diag, where A is this mixed
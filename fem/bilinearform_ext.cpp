@@ -13,6 +13,7 @@
 // PABilinearFormExtension and MFBilinearFormExtension.
 
 #include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
 #include "bilinearform.hpp"
 #include "libceed/ceed.hpp"
 
@@ -45,6 +46,8 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   batch_restrict = NULL;
+   batch_size = 0;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -53,6 +56,7 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
                                  ElementDofOrdering::LEXICOGRAPHIC:
                                  ElementDofOrdering::NATIVE;
    elem_restrict = trialFes->GetElementRestriction(ordering);
+   batch_restrict = dynamic_cast<const ElementRestriction*>(elem_restrict);
    if (elem_restrict)
    {
       localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
@@ -86,6 +90,7 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::Assemble");
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -154,6 +159,7 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   batch_restrict = nullptr;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -175,12 +181,52 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
    A.Reset(oper); // A will own oper
 }
 
+bool PABilinearFormExtension::UseElementBatches() const
+{
+   if (!batch_restrict || Device::IsEnabled()) { return false; }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   if (integrators.Size() == 0) { return false; }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPABatches()) { return false; }
+   }
+   return true;
+}
+
+int PABilinearFormExtension::GetElementBatchSize() const
+{
+   if (batch_size > 0) { return batch_size; }
+   const int ne = trialFes->GetNE();
+   const int nde = ne > 0 ? batch_restrict->Height() / ne : 1;
+   return std::max(8192 / nde, 1);
+}
+
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::Mult");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
-   if (DeviceCanUseCeed() || !elem_restrict)
+   if (UseElementBatches())
+   {
+      // Gather, apply and scatter-add batches of elements that stay in cache
+      const int ne = trialFes->GetNE();
+      const int nb_max = GetElementBatchSize();
+      y = 0.0;
+      for (int e0 = 0; e0 < ne; e0 += nb_max)
+      {
+         const int nb = std::min(nb_max, ne - e0);
+         batch_restrict->MultBatch(e0, nb, x, batchX);
+         batchY.SetSize(batchX.Size());
+         batchY = 0.0;
+         for (int i = 0; i < iSz; ++i)
+         {
+            integrators[i]->AddMultPABatch(e0, nb, batchX, batchY);
+         }
+         batch_restrict->AddMultTransposeBatch(e0, nb, batchY, y);
+      }
+   }
+   else if (DeviceCanUseCeed() || !elem_restrict)
    {
       y.UseDevice(true); // typically this is a large vector, so store on device
       y = 0.0;
@@ -233,8 +279,44 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::MultiMult(const MultiVector &X,
+                                        MultiVector &Y) const
+{
+   if (!UseElementBatches() || a->GetFBFI()->Size() > 0 ||
+       a->GetBFBFI()->Size() > 0)
+   {
+      Operator::MultiMult(X, Y);
+      return;
+   }
+   MFEM_PERF_SCOPE("PABilinearFormExtension::MultiMult");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   const int ne = trialFes->GetNE();
+   const int nb_max = GetElementBatchSize();
+   Vector x, y;
+   Y = 0.0;
+   for (int e0 = 0; e0 < ne; e0 += nb_max)
+   {
+      const int nb = std::min(nb_max, ne - e0);
+      for (int j = 0; j < X.NumVectors(); j++)
+      {
+         X.GetVectorView(j, x);
+         Y.GetVectorView(j, y);
+         batch_restrict->MultBatch(e0, nb, x, batchX);
+         batchY.SetSize(batchX.Size());
+         batchY = 0.0;
+         for (int i = 0; i < iSz; ++i)
+         {
+            integrators[i]->AddMultPABatch(e0, nb, batchX, batchY);
+         }
+         batch_restrict->AddMultTransposeBatch(e0, nb, batchY, y);
+      }
+   }
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::MultTranspose");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
@@ -351,6 +433,7 @@ void EABilinearFormExtension::Assemble()
 
 void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("EABilinearFormExtension::Mult");
    // Apply the Element Restriction
    const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
    if (!useRestrict)
@@ -474,6 +557,7 @@ void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("EABilinearFormExtension::MultTranspose");
    // Apply the Element Restriction
    const bool useRestrict = DeviceCanUseCeed() || !elem_restrict;
    if (!useRestrict)
@@ -595,6 +679,215 @@ void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+// Data and methods for fully-assembled bilinear forms
+FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
+   : EABilinearFormExtension(form)
+{
+}
+
+bool FABilinearFormExtension::SupportsForm(const BilinearForm &form)
+{
+   if (form.bbfi.Size() > 0 || form.fbfi.Size() > 0 || form.bfbfi.Size() > 0 ||
+       form.static_cond || form.hybridization)
+   {
+      return false;
+   }
+   const FiniteElementSpace *fes = form.fes;
+   const Mesh *mesh = fes->GetMesh();
+   if (fes->GetVDim() != 1 || fes->GetNURBSext() ||
+       mesh->GetNumGeometries(mesh->Dimension()) > 1)
+   {
+      return false;
+   }
+   for (int i = 0; i < form.dbfi.Size(); i++)
+   {
+      if (!form.dbfi[i]->SupportsEA()) { return false; }
+   }
+   return true;
+}
+
+void FABilinearFormExtension::Assemble()
+{
+   MFEM_PERF_SCOPE("FABilinearFormExtension::Assemble");
+   MFEM_VERIFY(a->GetBBFI()->Size() == 0 && a->GetFBFI()->Size() == 0 &&
+               a->GetBFBFI()->Size() == 0,
+               "only domain integrators are supported by the full assembly on "
+               "the device");
+   MFEM_VERIFY(!a->static_cond && !a->hybridization,
+               "static condensation and hybridization are not supported by the"
+               " full assembly on the device");
+
+   EABilinearFormExtension::Assemble();
+
+   const ElementRestriction *H1elem_restrict =
+      dynamic_cast<const ElementRestriction*>(elem_restrict);
+   const L2ElementRestriction *L2elem_restrict =
+      dynamic_cast<const L2ElementRestriction*>(elem_restrict);
+   MFEM_VERIFY(H1elem_restrict || L2elem_restrict,
+               "an element restriction is required");
+
+   const int n = trialFes->GetVSize();
+   delete a->mat_e;
+   a->mat_e = NULL;
+   delete a->mat;
+   a->mat = new SparseMatrix(n, n, 0);
+   SparseMatrix &mat = *a->mat;
+
+   const int nnz = H1elem_restrict ? H1elem_restrict->FillI(mat) :
+                   L2elem_restrict->FillI(mat);
+   mat.GetMemoryJ().Delete();
+   mat.GetMemoryJ().New(nnz, Device::GetMemoryType());
+   mat.GetMemoryData().Delete();
+   mat.GetMemoryData().New(nnz, Device::GetMemoryType());
+   if (H1elem_restrict) { H1elem_restrict->FillJAndData(ea_data, mat); }
+   else { L2elem_restrict->FillJAndData(ea_data, mat); }
+
+   // The original implementation, e.g. the elimination of the essential dofs,
+   // accesses the arrays of the matrix on the host.
+   mat.HostReadI();
+   mat.HostReadJ();
+   mat.HostReadData();
+}
+
+void FABilinearFormExtension::AssembleDiagonal(Vector &diag) const
+{
+   a->SpMat().GetDiag(diag);
+}
+
+void FABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
+                                               OperatorHandle &A)
+{
+   a->FormSystemMatrix(ess_tdof_list, A);
+}
+
+void FABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
+                                               Vector &x, Vector &b,
+                                               OperatorHandle &A,
+                                               Vector &X, Vector &B,
+                                               int copy_interior)
+{
+   a->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
+}
+
+void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   a->SpMat().Mult(x, y);
+}
+
+void FABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   a->SpMat().MultTranspose(x, y);
+}
+
+
+// Data and methods for matrix-free bilinear forms
+MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
+   : PABilinearFormExtension(form)
+{
+}
+
+void MFBilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported with AssemblyLevel::NONE");
+   SetupRestrictionOperators(L2FaceValues::DoubleValued);
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleMF(*a->FESpace());
+   }
+}
+
+void MFBilinearFormExtension::AssembleDiagonal(Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(localY);
+      }
+      const ElementRestriction* H1elem_restrict =
+         dynamic_cast<const ElementRestriction*>(elem_restrict);
+      if (H1elem_restrict)
+      {
+         H1elem_restrict->MultTransposeUnsigned(localY, y);
+      }
+      else
+      {
+         elem_restrict->MultTranspose(localY, y);
+      }
+   }
+   else
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PERF_SCOPE("MFBilinearFormExtension::Mult");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultMF(localX, localY);
+      }
+      elem_restrict->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultMF(x, y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_PERF_SCOPE("MFBilinearFormExtension::MultTranspose");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposeMF(localX, localY);
+      }
+      elem_restrict->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposeMF(x, y);
+      }
+   }
+}
+
 MixedBilinearFormExtension::MixedBilinearFormExtension(MixedBilinearForm *form)
    : Operator(form->Height(), form->Width()), a(form)
 {
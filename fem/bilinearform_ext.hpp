@@ -62,27 +62,6 @@ public:
    virtual void Update() = 0;
 };
 
-/** @brief Data and methods for fully-assembled bilinear forms.
-    Not yet implemented!  Use the BilinearForm Class instead. */
-class FABilinearFormExtension : public BilinearFormExtension
-{
-public:
-   FABilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
-
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~FABilinearFormExtension() {}
-};
-
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -95,6 +74,21 @@ protected:
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
 
+   /// The element restriction, if it supports the element-batched action.
+   const ElementRestriction *batch_restrict; // Not owned
+   /// Number of elements per batch of the element-batched action, or 0.
+   int batch_size;
+   /// E-vectors of one batch of elements, see Mult().
+   mutable Vector batchX, batchY;
+
+   /** @brief Return true if Mult() can use the element-batched action, which
+       requires a host-only execution, an ElementRestriction, and domain
+       integrators that all support BilinearFormIntegrator::AddMultPABatch(). */
+   bool UseElementBatches() const;
+
+   /// Return the number of elements per batch, see SetElementBatchSize().
+   int GetElementBatchSize() const;
+
 public:
    PABilinearFormExtension(BilinearForm*);
 
@@ -105,10 +99,28 @@ public:
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
                          int copy_interior = 0);
+   /** @brief Compute y = A x. On the host, the element restriction, the
+       domain integrators and the transposed restriction are fused: the
+       elements are processed in batches, gathered directly from @a x and
+       scatter-added to @a y, so the full E-vectors are not formed. */
+   /** See UseElementBatches() for the conditions of the fused action and
+       SetElementBatchSize() for the size of the batches. */
    void Mult(const Vector &x, Vector &y) const;
+   /** @brief Compute Y_j = A X_j for all vectors of @a X, applying every batch
+       of elements to all vectors while its partial assembly data is in
+       cache. */
+   /** Without the element-batched action or with face integrators, the
+       vectors are processed one by one with Mult(). */
+   void MultiMult(const MultiVector &X, MultiVector &Y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
+   /** @brief Set the number of elements per batch of the element-batched
+       action in Mult(). */
+   /** The default, @a nb = 0, selects the size from the number of dofs per
+       element, so that the two batch E-vectors take about 128 KB. */
+   void SetElementBatchSize(int nb) { batch_size = nb; }
+
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
 };
@@ -132,24 +144,50 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
 };
 
-/// Data and methods for matrix-free bilinear forms NOT YET IMPLEMENTED.
-class MFBilinearFormExtension : public BilinearFormExtension
+/** @brief Data and methods for fully-assembled bilinear forms, built from the
+    element matrices of EABilinearFormExtension. */
+/** The sparsity pattern and the values of the SparseMatrix of the form are
+    computed through MFEM_FORALL from the element restriction, see
+    ElementRestriction::FillI() and ElementRestriction::FillJAndData(), so that
+    the assembly runs on the device or with Backend::THREADS. Only the domain
+    integrators and scalar spaces are supported, see SupportsForm(). The matrix
+    is stored in the BilinearForm, which handles the essential dofs as in the
+    original full assembly. */
+class FABilinearFormExtension : public EABilinearFormExtension
 {
 public:
-   MFBilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
+   FABilinearFormExtension(BilinearForm *form);
+
+   /** @brief Return true if the extension can assemble @a form: only domain
+       integrators implementing AssembleEA(), a scalar space on a mesh with a
+       single element geometry, and neither static condensation nor
+       hybridization. */
+   static bool SupportsForm(const BilinearForm &form);
 
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
    void FormLinearSystem(const Array<int> &ess_tdof_list,
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~MFBilinearFormExtension() {}
+                         int copy_interior = 0);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+};
+
+/** @brief Data and methods for matrix-free bilinear forms. */
+/** No operator data is stored: the integrators recompute the geometric factors
+    and the coefficients at the quadrature points inside every action, see
+    BilinearFormIntegrator::AddMultMF(). Face integrators are not supported. */
+class MFBilinearFormExtension : public PABilinearFormExtension
+{
+public:
+   MFBilinearFormExtension(BilinearForm *form);
+
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
 };
 
 /// Class extending the MixedBilinearForm class to support different AssemblyLevels.
@@ -12,6 +12,7 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -51,6 +52,110 @@ void BilinearFormIntegrator::AssembleDiagonalPA(Vector &)
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposeMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposeMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleDiagonalMF(Vector &)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleDiagonalMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::ComputeBatchJacobians(const Mesh &mesh,
+                                                   const IntegrationRule &ir,
+                                                   const int e0, const int nb,
+                                                   Vector &J)
+{
+   const GridFunction *nodes = mesh.GetNodes();
+   MFEM_VERIFY(nodes, "the mesh nodes must be set, see Mesh::EnsureNodes()");
+   const FiniteElementSpace *nfes = nodes->FESpace();
+   const FiniteElement *fe = nfes->GetFE(0);
+   const Table &e2dof = nfes->GetElementToDofTable();
+   const int dim = fe->GetDim();
+   const int sdim = nfes->GetVDim();
+   const int ND = fe->GetDof();
+   const int NQ = ir.GetNPoints();
+   const int NE = mesh.GetNE();
+   const int ndofs = nfes->GetNDofs();
+   const bool by_vdim = nfes->GetOrdering() == Ordering::byVDIM;
+   MFEM_VERIFY(e2dof.Size_of_connections() == ND*NE,
+               "mixed element types are not supported");
+   const DofToQuad &maps = fe->GetDofToQuad(ir, DofToQuad::FULL);
+   auto G = Reshape(maps.G.Read(), NQ, dim, ND);
+   auto E2D = Reshape(Read(e2dof.GetJMemory(), ND*NE), ND, NE);
+   auto X = nodes->Read();
+   J.SetSize(NQ*sdim*dim*nb, Device::GetDeviceMemoryType());
+   auto DX = Reshape(J.Write(), NQ, sdim, dim, nb);
+   MFEM_FORALL(e, nb,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int c = 0; c < sdim; ++c)
+         {
+            for (int d = 0; d < dim; ++d)
+            {
+               double s = 0.0;
+               for (int n = 0; n < ND; ++n)
+               {
+                  const int j = E2D(n, e0 + e);
+                  const int dof = j >= 0 ? j : -1 - j;
+                  const int vdof = by_vdim ? c + sdim*dof : dof + c*ndofs;
+                  s += G(q, d, n) * X[vdof];
+               }
+               DX(q, c, d, e) = s;
+            }
+         }
+      }
+   });
+}
+
+void BilinearFormIntegrator::EvalBatchCoefficient(Coefficient *Q,
+                                                  const FiniteElementSpace &fes,
+                                                  const IntegrationRule &ir,
+                                                  const int e0, const int nb,
+                                                  Vector &coeff)
+{
+   if (Q == NULL)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      const int nq = ir.GetNPoints();
+      coeff.SetSize(nq * nb);
+      auto C = Reshape(coeff.HostWrite(), nq, nb);
+      for (int e = 0; e < nb; ++e)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e0 + e);
+         for (int q = 0; q < nq; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir.IntPoint(q));
+         }
+      }
+   }
+}
+
 void BilinearFormIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                         Vector &emat)
 {
@@ -93,6 +198,13 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPABatch(int, int, const Vector &,
+                                            Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPABatch(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
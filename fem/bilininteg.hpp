@@ -17,15 +17,57 @@
 #include "fespace.hpp"
 #include "libceed/ceed.hpp"
 
+// Host versions of the 3D partial assembly kernels that are vectorized across
+// elements with the AutoSIMD types are built when MFEM_USE_SIMD is enabled and
+// the build does not target CUDA or HIP.
+#if defined(MFEM_USE_SIMD) && !defined(MFEM_USE_CUDA) && !defined(MFEM_USE_HIP)
+#define MFEM_PA_HOST_SIMD
+#endif
+
 namespace mfem
 {
 
+/** @brief Return true if the partial assembly kernels that are vectorized
+    across elements should be used: they run on the host and are selected when
+    no device, RAJA, OCCA or libCEED backend is enabled. */
+inline bool PAHostSIMD()
+{
+#ifdef MFEM_PA_HOST_SIMD
+   return !Device::Allows(Backend::DEVICE_MASK | Backend::RAJA_MASK |
+                          Backend::OCCA_MASK | Backend::CEED_MASK);
+#else
+   return false;
+#endif
+}
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
 protected:
+   /// Number of elements processed per batch by the matrix-free methods.
+   int mf_batch;
+
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
-      : NonlinearFormIntegrator(ir) { }
+      : NonlinearFormIntegrator(ir), mf_batch(4096) { }
+
+   /** @brief Compute the Jacobians of the mesh elements [@a e0, @a e0 + @a nb)
+       at the points of @a ir, directly from the mesh nodes. */
+   /** The layout of @a J is the same as the one of GeometricFactors::J,
+       restricted to the given batch of elements. The nodes are gathered inside
+       the kernel, so no E-vector of the mesh nodes is formed. Used by the
+       matrix-free actions, see AddMultMF(). */
+   static void ComputeBatchJacobians(const Mesh &mesh,
+                                     const IntegrationRule &ir,
+                                     const int e0, const int nb, Vector &J);
+
+   /** @brief Evaluate the coefficient @a Q at the points of @a ir in the
+       elements [@a e0, @a e0 + @a nb). */
+   /** If @a Q is NULL or a ConstantCoefficient, @a coeff is set to a single
+       value, otherwise it has size ir.GetNPoints() x @a nb. */
+   static void EvalBatchCoefficient(Coefficient *Q,
+                                    const FiniteElementSpace &fes,
+                                    const IntegrationRule &ir,
+                                    const int e0, const int nb, Vector &coeff);
 
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
@@ -78,6 +120,52 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on a batch of elements.
+   /** Same as AddMultPA(), restricted to the @a nb elements [@a e0, @a e0 +
+       @a nb): @a x and @a y are the E-vectors of these elements only. This
+       allows PABilinearFormExtension::Mult() to gather, apply and scatter the
+       elements in batches that stay in cache, instead of forming the full
+       E-vectors. Available when SupportsPABatches() returns true. */
+   virtual void AddMultPABatch(int e0, int nb, const Vector &x,
+                               Vector &y) const;
+
+   /// Return true if the integrator implements AddMultPABatch().
+   virtual bool SupportsPABatches() const { return false; }
+
+   /// Method defining matrix-free assembly.
+   /** The matrix-free setup only records the data (e.g. the basis functions at
+       the quadrature points) needed by the methods AddMultMF() and
+       AssembleDiagonalMF(). The geometric factors and the coefficients are
+       recomputed during each action, so no operator data is stored. The mesh
+       must have nodes, see Mesh::EnsureNodes(). */
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   /// Method for matrix-free action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   /// Method for matrix-free transposed action.
+   /** Perform the transpose action of integrator on the input @a x and add the
+       result to the output @a y. Both @a x and @a y are E-vectors.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
+   /// Assemble diagonal using the matrix-free setup and add it to @a diag.
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   /** @brief Set the number of elements processed at once by the matrix-free
+       methods AddMultMF() and AssembleDiagonalMF(). */
+   /** Larger batches expose more parallelism, smaller batches reduce the size
+       of the temporary quadrature data. The default is 4096 elements. */
+   void SetMFBatchSize(int nb) { mf_batch = nb; }
+
    /// Method defining element assembly.
    /** The result of the element assembly is added and stored in the @a emat
        Vector. */
@@ -94,6 +182,9 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   /// Return true if the integrator implements AssembleEA().
+   virtual bool SupportsEA() const { return false; }
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -264,6 +355,8 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   virtual bool SupportsEA() const { return bfi->SupportsEA(); }
+
    virtual ~TransposeIntegrator() { if (own_bfi) { delete bfi; } }
 };
 
@@ -1917,10 +2010,26 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPABatch(int e0, int nb, const Vector &x,
+                               Vector &y) const;
+
+   virtual bool SupportsPABatches() const { return pa_data.Size() > 0; }
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -1992,10 +2101,26 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPABatch(int e0, int nb, const Vector &x,
+                               Vector &y) const;
+
+   virtual bool SupportsPABatches() const { return pa_data.Size() > 0; }
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2018,12 +2143,15 @@ public:
 };
 
 /// alpha (q . grad u, v)
+/** The partial assembly and matrix-free levels only implement the action; the
+    diagonal and the transposed action are not available. */
 class ConvectionIntegrator : public BilinearFormIntegrator
 {
 protected:
    VectorCoefficient *Q;
    double alpha;
    // PA extension
+   const FiniteElementSpace *fespace;
    Vector pa_data;
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
@@ -2037,7 +2165,7 @@ private:
 
 public:
    ConvectionIntegrator(VectorCoefficient &q, double a = 1.0)
-      : Q(&q) { alpha = a; }
+      : Q(&q), fespace(NULL), maps(NULL), geom(NULL) { alpha = a; }
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
@@ -2048,8 +2176,14 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &el,
                                          ElementTransformation &Trans);
 
@@ -32,7 +32,7 @@ static void EAConvectionAssemble1D(const int NE,
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, NE);
-   auto A = Reshape(eadata.Write(), D1D, D1D, NE);
+   auto A = Reshape(eadata.ReadWrite(), D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -54,7 +54,7 @@ static void EAConvectionAssemble1D(const int NE,
             {
                val += r_Bj[k1] * D(k1, e) * r_Gi[k1];
             }
-            A(i1, j1, e) = val;
+            A(i1, j1, e) += val;
          }
       }
    });
@@ -76,7 +76,7 @@ static void EAConvectionAssemble2D(const int NE,
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, Q1D, 2, NE);
-   auto A = Reshape(eadata.Write(), D1D, D1D, D1D, D1D, NE);
+   auto A = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -121,7 +121,7 @@ static void EAConvectionAssemble2D(const int NE,
                                * r_B[k1][j1]* r_B[k2][j2];
                      }
                   }
-                  A(i1, i2, j1, j2, e) = val;
+                  A(i1, i2, j1, j2, e) += val;
                }
             }
          }
@@ -145,7 +145,7 @@ static void EAConvectionAssemble3D(const int NE,
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, 3, NE);
-   auto A = Reshape(eadata.Write(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   auto A = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, D1D,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -191,7 +191,7 @@ static void EAConvectionAssemble3D(const int NE,
                               }
                            }
                         }
-                        A(i1, i2, i3, j1, j2, j3, e) = val;
+                        A(i1, i2, i3, j1, j2, j3, e) += val;
                      }
                   }
                }
@@ -201,6 +201,40 @@ static void EAConvectionAssemble3D(const int NE,
    });
 }
 
+// Element matrices of non-tensor elements, e.g. simplices, computed with the
+// dense basis and gradient matrices of the DofToQuad::FULL maps.
+template<int DIM>
+static void EAConvectionAssembleFull(const int NE,
+                                     const int ND,
+                                     const int NQ,
+                                     const Array<double> &b,
+                                     const Array<double> &g,
+                                     const Vector &padata,
+                                     Vector &eadata)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(padata.Read(), NQ, DIM, NE);
+   auto A = Reshape(eadata.ReadWrite(), ND, ND, NE);
+   MFEM_FORALL_3D(e, NE, ND, 1, 1,
+   {
+      MFEM_FOREACH_THREAD(i,x,ND)
+      {
+         for (int j = 0; j < ND; ++j)
+         {
+            double val = 0.0;
+            for (int q = 0; q < NQ; ++q)
+            {
+               double DGi = 0.0;
+               for (int k = 0; k < DIM; ++k) { DGi += D(q,k,e) * G(q,k,i); }
+               val += B(q,j) * DGi;
+            }
+            A(i, j, e) += val;
+         }
+      }
+   });
+}
+
 void ConvectionIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                       Vector &ea_data)
 {
@@ -208,6 +242,18 @@ void ConvectionIntegrator::AssembleEA(const FiniteElementSpace &fes,
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    const Array<double> &G = maps->G;
+   if (maps->mode == DofToQuad::FULL)
+   {
+      const int nd = dofs1D, nq = quad1D;
+      if (dim == 2)
+      {
+         return EAConvectionAssembleFull<2>(ne,nd,nq,B,G,pa_data,ea_data);
+      }
+      if (dim == 3)
+      {
+         return EAConvectionAssembleFull<3>(ne,nd,nq,B,G,pa_data,ea_data);
+      }
+   }
    if (dim == 1)
    {
       switch ((dofs1D << 4 ) | quad1D)
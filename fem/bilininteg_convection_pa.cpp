@@ -21,8 +21,7 @@ namespace mfem
 // PA Convection Integrator
 
 // PA Convection Assemble 2D kernel
-static void PAConvectionSetup2D(const int Q1D,
-                                const int ne,
+static void PAConvectionSetup2D(const int ne,
                                 const Array<double> &w,
                                 const Vector &j,
                                 const Vector &vel,
@@ -30,7 +29,7 @@ static void PAConvectionSetup2D(const int Q1D,
                                 Vector &op)
 {
    const int NE = ne;
-   const int NQ = Q1D*Q1D;
+   const int NQ = w.Size();
    auto W = w.Read();
 
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
@@ -60,15 +59,14 @@ static void PAConvectionSetup2D(const int Q1D,
 }
 
 // PA Convection Assemble 3D kernel
-static void PAConvectionSetup3D(const int Q1D,
-                                const int NE,
+static void PAConvectionSetup3D(const int NE,
                                 const Array<double> &w,
                                 const Vector &j,
                                 const Vector &vel,
                                 const double alpha,
                                 Vector &op)
 {
-   const int NQ = Q1D*Q1D*Q1D;
+   const int NQ = w.Size();
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
    const bool const_v = vel.Size() == 3;
@@ -114,8 +112,6 @@ static void PAConvectionSetup3D(const int Q1D,
 }
 
 static void PAConvectionSetup(const int dim,
-                              const int D1D,
-                              const int Q1D,
                               const int NE,
                               const Array<double> &W,
                               const Vector &J,
@@ -126,11 +122,11 @@ static void PAConvectionSetup(const int dim,
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PAConvectionSetup"); }
    if (dim == 2)
    {
-      PAConvectionSetup2D(Q1D, NE, W, J, coeff, alpha, op);
+      PAConvectionSetup2D(NE, W, J, coeff, alpha, op);
    }
    if (dim == 3)
    {
-      PAConvectionSetup3D(Q1D, NE, W, J, coeff, alpha, op);
+      PAConvectionSetup3D(NE, W, J, coeff, alpha, op);
    }
 }
 
@@ -766,39 +762,29 @@ void SmemPAConvectionApply3D(const int ne,
    });
 }
 
-void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
+// Evaluate the velocity coefficient in the elements [e0, e0 + nb)
+static void EvalVelocity(VectorCoefficient &Q, const FiniteElementSpace &fes,
+                         const IntegrationRule &ir, const int e0, const int nb,
+                         Vector &vel)
 {
-   // Assumes tensor-product elements
-   Mesh *mesh = fes.GetMesh();
-   const FiniteElement &el = *fes.GetFE(0);
-   ElementTransformation &Trans = *fes.GetElementTransformation(0);
-   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
-   const int dims = el.GetDim();
-   const int symmDims = dims;
-   const int nq = ir->GetNPoints();
-   dim = mesh->Dimension();
-   ne = fes.GetNE();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
-   dofs1D = maps->ndof;
-   quad1D = maps->nqpt;
-   pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
-   Vector vel;
-   if (VectorConstantCoefficient *cQ = dynamic_cast<VectorConstantCoefficient*>(Q))
+   VectorConstantCoefficient *cQ = dynamic_cast<VectorConstantCoefficient*>(&Q);
+   if (cQ)
    {
       vel = cQ->GetVec();
    }
    else
    {
-      vel.SetSize(dim * nq * ne);
-      auto C = Reshape(vel.HostWrite(), dim, nq, ne);
+      const int dim = fes.GetMesh()->Dimension();
+      const int nq = ir.GetNPoints();
+      vel.SetSize(dim * nq * nb);
+      auto C = Reshape(vel.HostWrite(), dim, nq, nb);
       Vector Vq(dim);
-      for (int e = 0; e < ne; ++e)
+      for (int e = 0; e < nb; ++e)
       {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
+         ElementTransformation& T = *fes.GetElementTransformation(e0 + e);
          for (int q = 0; q < nq; ++q)
          {
-            Q->Eval(Vq, T, ir->IntPoint(q));
+            Q.Eval(Vq, T, ir.IntPoint(q));
             for (int i = 0; i < dim; ++i)
             {
                C(i,q,e) = Vq(i);
@@ -806,8 +792,28 @@ void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       }
    }
-   PAConvectionSetup(dim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
-                     vel, alpha, pa_data);
+}
+
+void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &Trans = *fes.GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
+   const int dims = el.GetDim();
+   const int symmDims = dims;
+   const int nq = ir->GetNPoints();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
+   Vector vel;
+   EvalVelocity(*Q, fes, *ir, 0, ne, vel);
+   PAConvectionSetup(dim, ne, ir->GetWeights(), geom->J, vel, alpha, pa_data);
 }
 
 static void PAConvectionApply(const int dim,
@@ -854,12 +860,128 @@ static void PAConvectionApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Convection Apply kernel for non-tensor elements, e.g. simplices: the
+// reference gradients and the basis functions are applied with the dense
+// matrices of the DofToQuad::FULL maps.
+template<int DIM>
+static void PAConvectionApplyFull(const int NE,
+                                  const int ND,
+                                  const int NQ,
+                                  const Array<double> &b,
+                                  const Array<double> &g,
+                                  const Vector &op,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   MFEM_VERIFY(ND <= MAX_ND, "");
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(op.Read(), NQ, DIM, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double s_X[MAX_ND], s_Y[MAX_ND];
+      for (int i = 0; i < ND; ++i)
+      {
+         s_X[i] = X(i,e);
+         s_Y[i] = 0.0;
+      }
+      for (int q = 0; q < NQ; ++q)
+      {
+         double u = 0.0;
+         for (int k = 0; k < DIM; ++k)
+         {
+            double grad = 0.0;
+            for (int i = 0; i < ND; ++i) { grad += G(q,k,i) * s_X[i]; }
+            u += D(q,k,e) * grad;
+         }
+         for (int i = 0; i < ND; ++i) { s_Y[i] += B(q,i) * u; }
+      }
+      for (int i = 0; i < ND; ++i) { Y(i,e) += s_Y[i]; }
+   });
+}
+
+static void PAConvectionApplyFull(const int dim,
+                                  const int ND,
+                                  const int NQ,
+                                  const int NE,
+                                  const Array<double> &B,
+                                  const Array<double> &G,
+                                  const Vector &op,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   if (dim == 2) { return PAConvectionApplyFull<2>(NE,ND,NQ,B,G,op,x,y); }
+   if (dim == 3) { return PAConvectionApplyFull<3>(NE,ND,NQ,B,G,op,x,y); }
+   MFEM_ABORT("Unknown kernel.");
+}
+
 // PA Convection Apply kernel
 void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAConvectionApplyFull(dim, dofs1D, quad1D, ne, maps->B, maps->G,
+                            pa_data, x, y);
+      return;
+   }
    PAConvectionApply(dim, dofs1D, quad1D, ne,
                      maps->B, maps->G, maps->Bt, maps->Gt,
                      pa_data, x, y);
 }
 
+// MF Convection Integrator: the PA kernels are applied to batches of elements,
+// with the geometric factors and the velocity recomputed for each batch.
+
+void ConvectionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   pa_data.Destroy();
+   geom = NULL;
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   MFEM_VERIFY(mesh->GetNodes(),
+               "the mesh nodes must be set, see Mesh::EnsureNodes()");
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &Trans = *fes.GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
+   nq = ir->GetNPoints();
+   dim = mesh->Dimension();
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+}
+
+void ConvectionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = *maps->IntRule;
+   const int ND = x.Size() / ne;
+   Vector J, vel, qdata, xb, yb;
+   // Move x and y to the device before creating aliases to them
+   x.Read();
+   y.ReadWrite();
+   for (int e0 = 0; e0 < ne; e0 += mf_batch)
+   {
+      const int nb = std::min(mf_batch, ne - e0);
+      ComputeBatchJacobians(*fespace->GetMesh(), ir, e0, nb, J);
+      EvalVelocity(*Q, *fespace, ir, e0, nb, vel);
+      qdata.SetSize(dim*nq*nb, Device::GetDeviceMemoryType());
+      PAConvectionSetup(dim, nb, ir.GetWeights(), J, vel, alpha, qdata);
+      xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      yb.MakeRef(y, e0*ND, nb*ND);
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PAConvectionApplyFull(dim, dofs1D, quad1D, nb, maps->B, maps->G,
+                               qdata, xb, yb);
+         continue;
+      }
+      PAConvectionApply(dim, dofs1D, quad1D, nb,
+                        maps->B, maps->G, maps->Bt, maps->Gt, qdata, xb, yb);
+   }
+}
+
 } // namespace mfem
@@ -10,9 +10,13 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
+#ifdef MFEM_PA_HOST_SIMD
+#include "../linalg/simd.hpp"
+#endif
 
 using namespace std;
 
@@ -82,21 +86,19 @@ static void OccaPADiffusionSetup3D(const int D1D,
 
 // PA Diffusion Assemble 2D kernel
 template<const int T_SDIM>
-static void PADiffusionSetup2D(const int Q1D,
-                               const int NE,
+static void PADiffusionSetup2D(const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d);
 template<>
-void PADiffusionSetup2D<2>(const int Q1D,
-                           const int NE,
+void PADiffusionSetup2D<2>(const int NE,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
                            Vector &d)
 {
-   const int NQ = Q1D*Q1D;
+   const int NQ = w.Size();
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
@@ -122,8 +124,7 @@ void PADiffusionSetup2D<2>(const int Q1D,
 
 // PA Diffusion Assemble 2D kernel with 3D node coords
 template<>
-void PADiffusionSetup2D<3>(const int Q1D,
-                           const int NE,
+void PADiffusionSetup2D<3>(const int NE,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
@@ -131,7 +132,7 @@ void PADiffusionSetup2D<3>(const int Q1D,
 {
    constexpr int DIM = 2;
    constexpr int SDIM = 3;
-   const int NQ = Q1D*Q1D;
+   const int NQ = w.Size();
    const bool const_c = c.Size() == 1;
 
    auto W = w.Read();
@@ -163,14 +164,13 @@ void PADiffusionSetup2D<3>(const int Q1D,
 }
 
 // PA Diffusion Assemble 3D kernel
-static void PADiffusionSetup3D(const int Q1D,
-                               const int NE,
+static void PADiffusionSetup3D(const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d)
 {
-   const int NQ = Q1D*Q1D*Q1D;
+   const int NQ = w.Size();
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
@@ -226,10 +226,13 @@ static void PADiffusionSetup(const int dim,
                              Vector &D)
 {
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADiffusionSetup"); }
+   // The OCCA kernels assume tensor-product quadrature rules
+   const bool tensor = W.Size() == (dim == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D);
+   MFEM_CONTRACT_VAR(tensor);
    if (dim == 2)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && tensor)
       {
          OccaPADiffusionSetup2D(D1D, Q1D, NE, W, J, C, D);
          return;
@@ -237,19 +240,19 @@ static void PADiffusionSetup(const int dim,
 #else
       MFEM_CONTRACT_VAR(D1D);
 #endif // MFEM_USE_OCCA
-      if (sdim == 2) { PADiffusionSetup2D<2>(Q1D, NE, W, J, C, D); }
-      if (sdim == 3) { PADiffusionSetup2D<3>(Q1D, NE, W, J, C, D); }
+      if (sdim == 2) { PADiffusionSetup2D<2>(NE, W, J, C, D); }
+      if (sdim == 3) { PADiffusionSetup2D<3>(NE, W, J, C, D); }
    }
    if (dim == 3)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && tensor)
       {
          OccaPADiffusionSetup3D(D1D, Q1D, NE, W, J, C, D);
          return;
       }
 #endif // MFEM_USE_OCCA
-      PADiffusionSetup3D(Q1D, NE, W, J, C, D);
+      PADiffusionSetup3D(NE, W, J, C, D);
    }
 }
 
@@ -281,41 +284,134 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    ne = fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
    const int sdim = mesh->SpaceDimension();
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(symmDims * nq * ne, Device::GetDeviceMemoryType());
    Vector coeff;
-   if (Q == nullptr)
-   {
-      coeff.SetSize(1);
-      coeff(0) = 1.0;
-   }
-   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   EvalBatchCoefficient(Q, fes, *ir, 0, ne, coeff);
+   PADiffusionSetup(dim, sdim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
+                    coeff, pa_data);
+}
+
+void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   SetupPA(fes);
+}
+
+// PA Diffusion kernels for non-tensor elements, e.g. simplices: the reference
+// gradients are applied with the dense NQ x DIM x ND matrix of the
+// DofToQuad::FULL maps, and D holds the upper triangle of the symmetric DIM x
+// DIM matrix at each quadrature point, stored by rows.
+template<int DIM>
+static void PADiffusionApplyFull(const int NE,
+                                 const int ND,
+                                 const int NQ,
+                                 const Array<double> &g,
+                                 const Vector &d,
+                                 const Vector &x,
+                                 Vector &y)
+{
+   constexpr int SYM = (DIM * (DIM + 1)) / 2;
+   MFEM_VERIFY(ND <= MAX_ND, "");
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, SYM, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
    {
-      coeff.SetSize(1);
-      coeff(0) = cQ->constant;
-   }
-   else
+      double s_X[MAX_ND], s_Y[MAX_ND];
+      for (int i = 0; i < ND; ++i)
+      {
+         s_X[i] = X(i,e);
+         s_Y[i] = 0.0;
+      }
+      for (int q = 0; q < NQ; ++q)
+      {
+         double grad[DIM], flux[DIM];
+         for (int k = 0; k < DIM; ++k)
+         {
+            grad[k] = 0.0;
+            for (int i = 0; i < ND; ++i) { grad[k] += G(q,k,i) * s_X[i]; }
+         }
+         for (int k = 0; k < DIM; ++k)
+         {
+            flux[k] = 0.0;
+            for (int l = 0; l < DIM; ++l)
+            {
+               const int kl = k <= l ? k*DIM - (k*(k-1))/2 + l - k :
+                              l*DIM - (l*(l-1))/2 + k - l;
+               flux[k] += D(q,kl,e) * grad[l];
+            }
+         }
+         for (int i = 0; i < ND; ++i)
+         {
+            for (int k = 0; k < DIM; ++k) { s_Y[i] += G(q,k,i) * flux[k]; }
+         }
+      }
+      for (int i = 0; i < ND; ++i) { Y(i,e) += s_Y[i]; }
+   });
+}
+
+template<int DIM>
+static void PADiffusionDiagonalFull(const int NE,
+                                    const int ND,
+                                    const int NQ,
+                                    const Array<double> &g,
+                                    const Vector &d,
+                                    Vector &y)
+{
+   constexpr int SYM = (DIM * (DIM + 1)) / 2;
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, SYM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
+      for (int i = 0; i < ND; ++i)
       {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q)
          {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
+            for (int k = 0, kl = 0; k < DIM; ++k)
+            {
+               val += G(q,k,i) * D(q,kl++,e) * G(q,k,i);
+               for (int l = k + 1; l < DIM; ++l)
+               {
+                  val += 2.0 * G(q,k,i) * D(q,kl++,e) * G(q,l,i);
+               }
+            }
          }
+         Y(i,e) += val;
       }
-   }
-   PADiffusionSetup(dim, sdim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
-                    coeff, pa_data);
+   });
 }
 
-void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
+static void PADiffusionApplyFull(const int dim,
+                                 const int ND,
+                                 const int NQ,
+                                 const int NE,
+                                 const Array<double> &G,
+                                 const Vector &D,
+                                 const Vector &X,
+                                 Vector &Y)
 {
-   SetupPA(fes);
+   if (dim == 2) { return PADiffusionApplyFull<2>(NE,ND,NQ,G,D,X,Y); }
+   if (dim == 3) { return PADiffusionApplyFull<3>(NE,ND,NQ,G,D,X,Y); }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+static void PADiffusionDiagonalFull(const int dim,
+                                    const int ND,
+                                    const int NQ,
+                                    const int NE,
+                                    const Array<double> &G,
+                                    const Vector &D,
+                                    Vector &Y)
+{
+   if (dim == 2) { return PADiffusionDiagonalFull<2>(NE,ND,NQ,G,D,Y); }
+   if (dim == 3) { return PADiffusionDiagonalFull<3>(NE,ND,NQ,G,D,Y); }
+   MFEM_ABORT("Unknown kernel.");
 }
 
 
@@ -737,6 +833,11 @@ static void PADiffusionAssembleDiagonal(const int dim,
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PADiffusionDiagonalFull(dim, dofs1D, quad1D, ne, maps->G, pa_data, diag);
+      return;
+   }
    PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
                                maps->B, maps->G, pa_data, diag);
 }
@@ -1546,6 +1647,203 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+#ifdef MFEM_PA_HOST_SIMD
+// Host PA Diffusion Apply 3D kernel, vectorized across batches of elements: the
+// lanes of the AutoSIMD type hold the same quantity for consecutive elements.
+template<int D1D, int Q1D>
+static void SimdPADiffusionApply3D(const int NE,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_)
+{
+   typedef AutoSIMDTraits<double,double>::vreal_t vreal_t;
+   constexpr int VS = vreal_t::size;
+   const int NB = (NE + VS - 1) / VS;
+   auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D*Q1D*Q1D, 6, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL_2D(eb, NB, 1, 1, 1,
+   {
+      const int e0 = eb * VS;
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      vreal_t u[D1D][D1D][D1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int v = 0; v < VS; ++v)
+               {
+                  u[dz][dy][dx][v] = (v < nv) ? X(dx,dy,dz,e0+v) : 0.0;
+               }
+            }
+         }
+      }
+      // Contract in x: B u and G u
+      vreal_t DDQ[2][D1D][D1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t bu, gu; bu = 0.0; gu = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  bu.fma(u[dz][dy][dx], B(qx,dx));
+                  gu.fma(u[dz][dy][dx], G(qx,dx));
+               }
+               DDQ[0][dz][dy][qx] = bu;
+               DDQ[1][dz][dy][qx] = gu;
+            }
+         }
+      }
+      // Contract in y: (G_x B_y, B_x G_y, B_x B_y) u
+      vreal_t DQQ[3][D1D][Q1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t s0, s1, s2; s0 = 0.0; s1 = 0.0; s2 = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  s0.fma(DDQ[1][dz][dy][qx], B(qy,dy));
+                  s1.fma(DDQ[0][dz][dy][qx], G(qy,dy));
+                  s2.fma(DDQ[0][dz][dy][qx], B(qy,dy));
+               }
+               DQQ[0][dz][qy][qx] = s0;
+               DQQ[1][dz][qy][qx] = s1;
+               DQQ[2][dz][qy][qx] = s2;
+            }
+         }
+      }
+      // Contract in z and apply the symmetric quadrature data
+      vreal_t QQQ[3][Q1D][Q1D][Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t g0, g1, g2; g0 = 0.0; g1 = 0.0; g2 = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  g0.fma(DQQ[0][dz][qy][qx], B(qz,dz));
+                  g1.fma(DQQ[1][dz][qy][qx], B(qz,dz));
+                  g2.fma(DQQ[2][dz][qy][qx], G(qz,dz));
+               }
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               vreal_t O[6];
+               for (int k = 0; k < 6; ++k)
+               {
+                  for (int v = 0; v < VS; ++v)
+                  {
+                     O[k][v] = (v < nv) ? D(q,k,e0+v) : 0.0;
+                  }
+               }
+               QQQ[0][qz][qy][qx] = O[0]*g0 + O[1]*g1 + O[2]*g2;
+               QQQ[1][qz][qy][qx] = O[1]*g0 + O[3]*g1 + O[4]*g2;
+               QQQ[2][qz][qy][qx] = O[2]*g0 + O[4]*g1 + O[5]*g2;
+            }
+         }
+      }
+      // Transposed contraction in x: (G_x, B_x, B_x)
+      vreal_t QQD[3][Q1D][Q1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s0, s1, s2; s0 = 0.0; s1 = 0.0; s2 = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  s0.fma(QQQ[0][qz][qy][qx], G(qx,dx));
+                  s1.fma(QQQ[1][qz][qy][qx], B(qx,dx));
+                  s2.fma(QQQ[2][qz][qy][qx], B(qx,dx));
+               }
+               QQD[0][qz][qy][dx] = s0;
+               QQD[1][qz][qy][dx] = s1;
+               QQD[2][qz][qy][dx] = s2;
+            }
+         }
+      }
+      // Transposed contraction in y: (B_y, G_y, B_y), the first two summed
+      vreal_t QDD[2][Q1D][D1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s01, s2; s01 = 0.0; s2 = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s01.fma(QQD[0][qz][qy][dx], B(qy,dy));
+                  s01.fma(QQD[1][qz][qy][dx], G(qy,dy));
+                  s2.fma(QQD[2][qz][qy][dx], B(qy,dy));
+               }
+               QDD[0][qz][dy][dx] = s01;
+               QDD[1][qz][dy][dx] = s2;
+            }
+         }
+      }
+      // Transposed contraction in z: (B_z, G_z)
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s; s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s.fma(QDD[0][qz][dy][dx], B(qz,dz));
+                  s.fma(QDD[1][qz][dy][dx], G(qz,dz));
+               }
+               for (int v = 0; v < nv; ++v)
+               {
+                  Y(dx,dy,dz,e0+v) += s[v];
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no host SIMD kernel for the given D1D and Q1D.
+static bool SimdPADiffusionApply3D(const int D1D,
+                                   const int Q1D,
+                                   const int NE,
+                                   const Array<double> &B,
+                                   const Array<double> &G,
+                                   const Vector &D,
+                                   const Vector &X,
+                                   Vector &Y)
+{
+   switch ((D1D << 4) | Q1D)
+   {
+      case 0x23: SimdPADiffusionApply3D<2,3>(NE,B,G,D,X,Y); return true;
+      case 0x34: SimdPADiffusionApply3D<3,4>(NE,B,G,D,X,Y); return true;
+      case 0x45: SimdPADiffusionApply3D<4,5>(NE,B,G,D,X,Y); return true;
+      case 0x46: SimdPADiffusionApply3D<4,6>(NE,B,G,D,X,Y); return true;
+      case 0x56: SimdPADiffusionApply3D<5,6>(NE,B,G,D,X,Y); return true;
+      case 0x58: SimdPADiffusionApply3D<5,8>(NE,B,G,D,X,Y); return true;
+      case 0x67: SimdPADiffusionApply3D<6,7>(NE,B,G,D,X,Y); return true;
+      case 0x78: SimdPADiffusionApply3D<7,8>(NE,B,G,D,X,Y); return true;
+      case 0x89: SimdPADiffusionApply3D<8,9>(NE,B,G,D,X,Y); return true;
+      default: return false;
+   }
+}
+#endif // MFEM_PA_HOST_SIMD
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1574,6 +1872,12 @@ static void PADiffusionApply(const int dim,
       MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+#ifdef MFEM_PA_HOST_SIMD
+   if (dim == 3 && PAHostSIMD())
+   {
+      if (SimdPADiffusionApply3D(D1D,Q1D,NE,B,G,D,X,Y)) { return; }
+   }
+#endif
    if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
@@ -1608,6 +1912,16 @@ static void PADiffusionApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// Floating point operations of the sum factorization per element, or of the
+// dense gradient application for non-tensor elements.
+static double PADiffusionApplyFlops(const int dim, const DofToQuad &maps)
+{
+   const double D = maps.ndof, Q = maps.nqpt;
+   if (maps.mode == DofToQuad::FULL) { return 4*dim*D*Q + 2*dim*dim*Q; }
+   if (dim == 2) { return 8*(D*D*Q + D*Q*Q) + 6*Q*Q; }
+   return 8*D*D*D*Q + 12*(D*D*Q*Q + D*Q*Q*Q) + 15*Q*Q*Q;
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
@@ -1641,10 +1955,125 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    else
 #endif
    {
+      MFEM_PERF_SCOPE("DiffusionIntegrator::AddMultPA");
+      MFEM_PERF_FLOPS(ne*PADiffusionApplyFlops(dim, *maps));
+      MFEM_PERF_BYTES(8.0*(pa_data.Size() + x.Size() + 2*y.Size()));
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PADiffusionApplyFull(dim, dofs1D, quad1D, ne, maps->G, pa_data, x, y);
+         return;
+      }
       PADiffusionApply(dim, dofs1D, quad1D, ne,
                        maps->B, maps->G, maps->Bt, maps->Gt,
                        pa_data, x, y);
    }
 }
 
+void DiffusionIntegrator::AddMultPABatch(int e0, int nb, const Vector &x,
+                                         Vector &y) const
+{
+   MFEM_ASSERT(e0 >= 0 && nb >= 0 && e0 + nb <= ne, "invalid batch");
+   MFEM_PERF_SCOPE("DiffusionIntegrator::AddMultPABatch");
+   MFEM_PERF_FLOPS(nb*PADiffusionApplyFlops(dim, *maps));
+   // Size of the quadrature data of one element
+   const int QD = pa_data.Size() / ne;
+   Vector qdata;
+   qdata.MakeRef(const_cast<Vector&>(pa_data), e0*QD, nb*QD);
+   MFEM_PERF_BYTES(8.0*(qdata.Size() + x.Size() + 2*y.Size()));
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PADiffusionApplyFull(dim, dofs1D, quad1D, nb, maps->G, qdata, x, y);
+      return;
+   }
+   PADiffusionApply(dim, dofs1D, quad1D, nb,
+                    maps->B, maps->G, maps->Bt, maps->Gt, qdata, x, y);
+}
+
+// MF Diffusion Integrator: the PA kernels are applied to batches of elements,
+// with the geometric factors and the coefficient recomputed for each batch.
+
+void DiffusionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   pa_data.Destroy();
+   geom = NULL;
+   if (mesh->GetNE() == 0) { return; }
+   MFEM_VERIFY(MQ == NULL, "matrix coefficients are not supported");
+   MFEM_VERIFY(mesh->GetNodes(),
+               "the mesh nodes must be set, see Mesh::EnsureNodes()");
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+}
+
+void DiffusionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = *maps->IntRule;
+   const Mesh &mesh = *fespace->GetMesh();
+   const int sdim = mesh.SpaceDimension();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   const int nq = ir.GetNPoints();
+   const int ND = x.Size() / ne;
+   Vector J, coeff, qdata, xb, yb;
+   // Move x and y to the device before creating aliases to them
+   x.Read();
+   y.ReadWrite();
+   for (int e0 = 0; e0 < ne; e0 += mf_batch)
+   {
+      const int nb = std::min(mf_batch, ne - e0);
+      ComputeBatchJacobians(mesh, ir, e0, nb, J);
+      EvalBatchCoefficient(Q, *fespace, ir, e0, nb, coeff);
+      qdata.SetSize(symmDims*nq*nb, Device::GetDeviceMemoryType());
+      PADiffusionSetup(dim, sdim, dofs1D, quad1D, nb, ir.GetWeights(), J,
+                       coeff, qdata);
+      xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      yb.MakeRef(y, e0*ND, nb*ND);
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PADiffusionApplyFull(dim, dofs1D, quad1D, nb, maps->G, qdata, xb, yb);
+         continue;
+      }
+      PADiffusionApply(dim, dofs1D, quad1D, nb,
+                       maps->B, maps->G, maps->Bt, maps->Gt, qdata, xb, yb);
+   }
+}
+
+void DiffusionIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = *maps->IntRule;
+   const Mesh &mesh = *fespace->GetMesh();
+   const int sdim = mesh.SpaceDimension();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   const int nq = ir.GetNPoints();
+   const int ND = diag.Size() / ne;
+   Vector J, coeff, qdata, db;
+   diag.ReadWrite();
+   for (int e0 = 0; e0 < ne; e0 += mf_batch)
+   {
+      const int nb = std::min(mf_batch, ne - e0);
+      ComputeBatchJacobians(mesh, ir, e0, nb, J);
+      EvalBatchCoefficient(Q, *fespace, ir, e0, nb, coeff);
+      qdata.SetSize(symmDims*nq*nb, Device::GetDeviceMemoryType());
+      PADiffusionSetup(dim, sdim, dofs1D, quad1D, nb, ir.GetWeights(), J,
+                       coeff, qdata);
+      db.MakeRef(diag, e0*ND, nb*ND);
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PADiffusionDiagonalFull(dim, dofs1D, quad1D, nb, maps->G, qdata, db);
+         continue;
+      }
+      PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, nb,
+                                  maps->B, maps->G, qdata, db);
+   }
+}
+
 } // namespace mfem
@@ -30,7 +30,7 @@ static void EAMassAssemble1D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(basis.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, NE);
-   auto M = Reshape(eadata.Write(), D1D, D1D, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -52,7 +52,7 @@ static void EAMassAssemble1D(const int NE,
             {
                val += r_Bi[k1] * r_Bj[k1] * D(k1, e);
             }
-            M(i1, j1, e) = val;
+            M(i1, j1, e) += val;
          }
       }
    });
@@ -72,7 +72,7 @@ static void EAMassAssemble2D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(basis.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, Q1D, NE);
-   auto M = Reshape(eadata.Write(), D1D, D1D, D1D, D1D, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -114,7 +114,7 @@ static void EAMassAssemble2D(const int NE,
                                * s_D[k1][k2];
                      }
                   }
-                  M(i1, i2, j1, j2, e) = val;
+                  M(i1, i2, j1, j2, e) += val;
                }
             }
          }
@@ -136,7 +136,7 @@ static void EAMassAssemble3D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(basis.Read(), Q1D, D1D);
    auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, NE);
-   auto M = Reshape(eadata.Write(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, D1D, D1D, D1D,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
@@ -189,7 +189,7 @@ static void EAMassAssemble3D(const int NE,
                               }
                            }
                         }
-                        M(i1, i2, i3, j1, j2, j3, e) = val;
+                        M(i1, i2, i3, j1, j2, j3, e) += val;
                      }
                   }
                }
@@ -199,12 +199,45 @@ static void EAMassAssemble3D(const int NE,
    });
 }
 
+// Element matrices of non-tensor elements, e.g. simplices, computed with the
+// dense basis matrix of the DofToQuad::FULL maps.
+static void EAMassAssembleFull(const int NE,
+                               const int ND,
+                               const int NQ,
+                               const Array<double> &basis,
+                               const Vector &padata,
+                               Vector &eadata)
+{
+   auto B = Reshape(basis.Read(), NQ, ND);
+   auto D = Reshape(padata.Read(), NQ, NE);
+   auto M = Reshape(eadata.ReadWrite(), ND, ND, NE);
+   MFEM_FORALL_3D(e, NE, ND, 1, 1,
+   {
+      MFEM_FOREACH_THREAD(i,x,ND)
+      {
+         for (int j = 0; j < ND; ++j)
+         {
+            double val = 0.0;
+            for (int q = 0; q < NQ; ++q)
+            {
+               val += B(q,i) * B(q,j) * D(q,e);
+            }
+            M(i, j, e) += val;
+         }
+      }
+   });
+}
+
 void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                 Vector &ea_data)
 {
    AssemblePA(fes);
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
+   if (maps->mode == DofToQuad::FULL)
+   {
+      return EAMassAssembleFull(ne, dofs1D, quad1D, B, pa_data, ea_data);
+   }
    if (dim == 1)
    {
       switch ((dofs1D << 4 ) | quad1D)
@@ -10,9 +10,13 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/mass.hpp"
+#ifdef MFEM_PA_HOST_SIMD
+#include "../linalg/simd.hpp"
+#endif
 
 using namespace std;
 
@@ -22,70 +26,23 @@ namespace mfem
 // PA Mass Integrator
 
 // PA Mass Assemble kernel
-
-void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
+static void PAMassSetup(const int dim,
+                        const int NQ,
+                        const int NE,
+                        const Array<double> &w,
+                        const Vector &j,
+                        const Vector &coeff,
+                        Vector &op)
 {
-   // Assuming the same element type
-   fespace = &fes;
-   Mesh *mesh = fes.GetMesh();
-   if (mesh->GetNE() == 0) { return; }
-   const FiniteElement &el = *fes.GetFE(0);
-   ElementTransformation *T = mesh->GetElementTransformation(0);
-   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
-#ifdef MFEM_USE_CEED
-   if (DeviceCanUseCeed() && !force)
-   {
-      if (ceedDataPtr) { delete ceedDataPtr; }
-      CeedData* ptr = new CeedData();
-      ceedDataPtr = ptr;
-      InitCeedCoeff(Q, ptr);
-      return CeedPAMassAssemble(fes, *ir, *ptr);
-   }
-#endif
-   dim = mesh->Dimension();
-   ne = fes.GetMesh()->GetNE();
-   nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
-                                    GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
-   dofs1D = maps->ndof;
-   quad1D = maps->nqpt;
-   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
-   Vector coeff;
-   if (Q == nullptr)
-   {
-      coeff.SetSize(1);
-      coeff(0) = 1.0;
-   }
-   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
-   {
-      coeff.SetSize(1);
-      coeff(0) = cQ->constant;
-   }
-   else
-   {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
-   }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
+   const bool const_c = coeff.Size() == 1;
+   auto C =
+      const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
    if (dim==2)
    {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto w = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ, NE);
+      auto W = w.Read();
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      auto v = Reshape(op.Write(), NQ, NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -96,20 +53,15 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
             const double J22 = J(q,1,1,e);
             const double detJ = (J11*J22)-(J21*J12);
             const double coeff = const_c ? C(0,0) : C(q,e);
-            v(q,e) =  w[q] * coeff * detJ;
+            v(q,e) =  W[q] * coeff * detJ;
          }
       });
    }
    if (dim==3)
    {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto W = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ,NE);
+      auto W = w.Read();
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      auto v = Reshape(op.Write(), NQ,NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -127,11 +79,100 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    }
 }
 
+void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+#ifdef MFEM_USE_CEED
+   if (DeviceCanUseCeed() && !force)
+   {
+      if (ceedDataPtr) { delete ceedDataPtr; }
+      CeedData* ptr = new CeedData();
+      ceedDataPtr = ptr;
+      InitCeedCoeff(Q, ptr);
+      return CeedPAMassAssemble(fes, *ir, *ptr);
+   }
+#endif
+   dim = mesh->Dimension();
+   ne = fes.GetMesh()->GetNE();
+   nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
+                                    GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
+   Vector coeff;
+   EvalBatchCoefficient(Q, fes, *ir, 0, ne, coeff);
+   PAMassSetup(dim, nq, ne, ir->GetWeights(), geom->J, coeff, pa_data);
+}
+
 void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    SetupPA(fes);
 }
 
+// PA Mass kernels for non-tensor elements, e.g. simplices: the basis functions
+// are applied with the dense ND x NQ matrix of the DofToQuad::FULL maps.
+static void PAMassApplyFull(const int NE,
+                            const int ND,
+                            const int NQ,
+                            const Array<double> &b,
+                            const Vector &d,
+                            const Vector &x,
+                            Vector &y)
+{
+   MFEM_VERIFY(ND <= MAX_ND, "");
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double s_X[MAX_ND], s_Y[MAX_ND];
+      for (int i = 0; i < ND; ++i)
+      {
+         s_X[i] = X(i,e);
+         s_Y[i] = 0.0;
+      }
+      for (int q = 0; q < NQ; ++q)
+      {
+         double u = 0.0;
+         for (int i = 0; i < ND; ++i) { u += B(q,i) * s_X[i]; }
+         u *= D(q,e);
+         for (int i = 0; i < ND; ++i) { s_Y[i] += B(q,i) * u; }
+      }
+      for (int i = 0; i < ND; ++i) { Y(i,e) += s_Y[i]; }
+   });
+}
+
+static void PAMassAssembleDiagonalFull(const int NE,
+                                       const int ND,
+                                       const int NQ,
+                                       const Array<double> &b,
+                                       const Vector &d,
+                                       Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; ++i)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q) { val += B(q,i) * B(q,i) * D(q,e); }
+         Y(i,e) += val;
+      }
+   });
+}
+
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassAssembleDiagonal2D(const int NE,
@@ -441,6 +482,11 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAMassAssembleDiagonalFull(ne, dofs1D, quad1D, maps->B, pa_data, diag);
+      return;
+   }
    PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
 }
 
@@ -1118,6 +1164,176 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+#ifdef MFEM_PA_HOST_SIMD
+// Host PA Mass Apply 3D kernel, vectorized across batches of elements: the
+// lanes of the AutoSIMD type hold the same quantity for consecutive elements.
+template<int D1D, int Q1D>
+static void SimdPAMassApply3D(const int NE,
+                              const Array<double> &b_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_)
+{
+   typedef AutoSIMDTraits<double,double>::vreal_t vreal_t;
+   constexpr int VS = vreal_t::size;
+   const int NB = (NE + VS - 1) / VS;
+   auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL_2D(eb, NB, 1, 1, 1,
+   {
+      const int e0 = eb * VS;
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      vreal_t u[D1D][D1D][D1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int v = 0; v < VS; ++v)
+               {
+                  u[dz][dy][dx][v] = (v < nv) ? X(dx,dy,dz,e0+v) : 0.0;
+               }
+            }
+         }
+      }
+      vreal_t DDQ[D1D][D1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t s; s = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  s.fma(u[dz][dy][dx], B(qx,dx));
+               }
+               DDQ[dz][dy][qx] = s;
+            }
+         }
+      }
+      vreal_t DQQ[D1D][Q1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t s; s = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  s.fma(DDQ[dz][dy][qx], B(qy,dy));
+               }
+               DQQ[dz][qy][qx] = s;
+            }
+         }
+      }
+      vreal_t QQQ[Q1D][Q1D][Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t s; s = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  s.fma(DQQ[dz][qy][qx], B(qz,dz));
+               }
+               vreal_t d;
+               for (int v = 0; v < VS; ++v)
+               {
+                  d[v] = (v < nv) ? D(qx,qy,qz,e0+v) : 0.0;
+               }
+               QQQ[qz][qy][qx] = s * d;
+            }
+         }
+      }
+      vreal_t QQD[Q1D][Q1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s; s = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  s.fma(QQQ[qz][qy][qx], B(qx,dx));
+               }
+               QQD[qz][qy][dx] = s;
+            }
+         }
+      }
+      vreal_t QDD[Q1D][D1D][D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s; s = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  s.fma(QQD[qz][qy][dx], B(qy,dy));
+               }
+               QDD[qz][dy][dx] = s;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t s; s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s.fma(QDD[qz][dy][dx], B(qz,dz));
+               }
+               for (int v = 0; v < nv; ++v)
+               {
+                  Y(dx,dy,dz,e0+v) += s[v];
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no host SIMD kernel for the given D1D and Q1D.
+static bool SimdPAMassApply3D(const int D1D,
+                              const int Q1D,
+                              const int NE,
+                              const Array<double> &B,
+                              const Vector &D,
+                              const Vector &X,
+                              Vector &Y)
+{
+   switch ((D1D << 4) | Q1D)
+   {
+      case 0x23: SimdPAMassApply3D<2,3>(NE,B,D,X,Y); return true;
+      case 0x24: SimdPAMassApply3D<2,4>(NE,B,D,X,Y); return true;
+      case 0x34: SimdPAMassApply3D<3,4>(NE,B,D,X,Y); return true;
+      case 0x36: SimdPAMassApply3D<3,6>(NE,B,D,X,Y); return true;
+      case 0x45: SimdPAMassApply3D<4,5>(NE,B,D,X,Y); return true;
+      case 0x46: SimdPAMassApply3D<4,6>(NE,B,D,X,Y); return true;
+      case 0x48: SimdPAMassApply3D<4,8>(NE,B,D,X,Y); return true;
+      case 0x56: SimdPAMassApply3D<5,6>(NE,B,D,X,Y); return true;
+      case 0x58: SimdPAMassApply3D<5,8>(NE,B,D,X,Y); return true;
+      case 0x67: SimdPAMassApply3D<6,7>(NE,B,D,X,Y); return true;
+      case 0x78: SimdPAMassApply3D<7,8>(NE,B,D,X,Y); return true;
+      case 0x89: SimdPAMassApply3D<8,9>(NE,B,D,X,Y); return true;
+      case 0x9A: SimdPAMassApply3D<9,10>(NE,B,D,X,Y); return true;
+      default: return false;
+   }
+}
+#endif // MFEM_PA_HOST_SIMD
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1142,6 +1358,12 @@ static void PAMassApply(const int dim,
       MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+#ifdef MFEM_PA_HOST_SIMD
+   if (dim == 3 && PAHostSIMD())
+   {
+      if (SimdPAMassApply3D(D1D,Q1D,NE,B,D,X,Y)) { return; }
+   }
+#endif
    const int id = (D1D << 4) | Q1D;
    if (dim == 2)
    {
@@ -1187,6 +1409,16 @@ static void PAMassApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// Floating point operations of the sum factorization per element, or of the
+// dense basis application for non-tensor elements.
+static double PAMassApplyFlops(const int dim, const DofToQuad &maps)
+{
+   const double D = maps.ndof, Q = maps.nqpt;
+   if (maps.mode == DofToQuad::FULL) { return 4*D*Q + Q; }
+   if (dim == 2) { return 4*(D*D*Q + D*Q*Q) + Q*Q; }
+   return 4*(D*D*D*Q + D*D*Q*Q + D*Q*Q*Q) + Q*Q*Q;
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
 #ifdef MFEM_USE_CEED
@@ -1219,8 +1451,109 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    else
 #endif
    {
+      MFEM_PERF_SCOPE("MassIntegrator::AddMultPA");
+      MFEM_PERF_FLOPS(ne*PAMassApplyFlops(dim, *maps));
+      MFEM_PERF_BYTES(8.0*(pa_data.Size() + x.Size() + 2*y.Size()));
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PAMassApplyFull(ne, dofs1D, quad1D, maps->B, pa_data, x, y);
+         return;
+      }
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
    }
 }
 
+void MassIntegrator::AddMultPABatch(int e0, int nb, const Vector &x,
+                                    Vector &y) const
+{
+   MFEM_ASSERT(e0 >= 0 && nb >= 0 && e0 + nb <= ne, "invalid batch");
+   MFEM_PERF_SCOPE("MassIntegrator::AddMultPABatch");
+   MFEM_PERF_FLOPS(nb*PAMassApplyFlops(dim, *maps));
+   Vector qdata;
+   qdata.MakeRef(const_cast<Vector&>(pa_data), e0*nq, nb*nq);
+   MFEM_PERF_BYTES(8.0*(qdata.Size() + x.Size() + 2*y.Size()));
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAMassApplyFull(nb, dofs1D, quad1D, maps->B, qdata, x, y);
+      return;
+   }
+   PAMassApply(dim, dofs1D, quad1D, nb, maps->B, maps->Bt, qdata, x, y);
+}
+
+// MF Mass Integrator: the PA kernels are applied to batches of elements, with
+// the geometric factors and the coefficient recomputed for each batch.
+
+void MassIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   pa_data.Destroy();
+   geom = NULL;
+   if (mesh->GetNE() == 0) { return; }
+   MFEM_VERIFY(mesh->GetNodes(),
+               "the mesh nodes must be set, see Mesh::EnsureNodes()");
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   dim = mesh->Dimension();
+   ne = mesh->GetNE();
+   nq = ir->GetNPoints();
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+}
+
+void MassIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = *maps->IntRule;
+   const int ND = x.Size() / ne;
+   Vector J, coeff, qdata, xb, yb;
+   // Move x and y to the device before creating aliases to them
+   x.Read();
+   y.ReadWrite();
+   for (int e0 = 0; e0 < ne; e0 += mf_batch)
+   {
+      const int nb = std::min(mf_batch, ne - e0);
+      ComputeBatchJacobians(*fespace->GetMesh(), ir, e0, nb, J);
+      EvalBatchCoefficient(Q, *fespace, ir, e0, nb, coeff);
+      qdata.SetSize(nq*nb, Device::GetDeviceMemoryType());
+      PAMassSetup(dim, nq, nb, ir.GetWeights(), J, coeff, qdata);
+      xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      yb.MakeRef(y, e0*ND, nb*ND);
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PAMassApplyFull(nb, dofs1D, quad1D, maps->B, qdata, xb, yb);
+         continue;
+      }
+      PAMassApply(dim, dofs1D, quad1D, nb, maps->B, maps->Bt, qdata, xb, yb);
+   }
+}
+
+void MassIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   const IntegrationRule &ir = *maps->IntRule;
+   const int ND = diag.Size() / ne;
+   Vector J, coeff, qdata, db;
+   diag.ReadWrite();
+   for (int e0 = 0; e0 < ne; e0 += mf_batch)
+   {
+      const int nb = std::min(mf_batch, ne - e0);
+      ComputeBatchJacobians(*fespace->GetMesh(), ir, e0, nb, J);
+      EvalBatchCoefficient(Q, *fespace, ir, e0, nb, coeff);
+      qdata.SetSize(nq*nb, Device::GetDeviceMemoryType());
+      PAMassSetup(dim, nq, nb, ir.GetWeights(), J, coeff, qdata);
+      db.MakeRef(diag, e0*ND, nb*ND);
+      if (maps->mode == DofToQuad::FULL)
+      {
+         PAMassAssembleDiagonalFull(nb, dofs1D, quad1D, maps->B, qdata, db);
+         continue;
+      }
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, nb, maps->B, qdata, db);
+   }
+}
+
 } // namespace mfem
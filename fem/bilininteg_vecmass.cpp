@@ -35,7 +35,8 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    nq = ir->GetNPoints();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
                                     GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
@@ -359,8 +360,51 @@ static void PAVectorMassApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Vector Mass Apply kernel for non-tensor elements, e.g. simplices, using
+// the dense basis matrix of the DofToQuad::FULL maps for each component.
+static void PAVectorMassApplyFull(const int NE,
+                                  const int VDIM,
+                                  const int ND,
+                                  const int NQ,
+                                  const Array<double> &b,
+                                  const Vector &op,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   MFEM_VERIFY(ND <= MAX_ND, "");
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(op.Read(), NQ, NE);
+   auto X = Reshape(x.Read(), ND, VDIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VDIM; ++c)
+      {
+         double s_X[MAX_ND], s_Y[MAX_ND];
+         for (int i = 0; i < ND; ++i)
+         {
+            s_X[i] = X(i,c,e);
+            s_Y[i] = 0.0;
+         }
+         for (int q = 0; q < NQ; ++q)
+         {
+            double u = 0.0;
+            for (int i = 0; i < ND; ++i) { u += B(q,i) * s_X[i]; }
+            u *= D(q,e);
+            for (int i = 0; i < ND; ++i) { s_Y[i] += B(q,i) * u; }
+         }
+         for (int i = 0; i < ND; ++i) { Y(i,c,e) += s_Y[i]; }
+      }
+   });
+}
+
 void VectorMassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAVectorMassApplyFull(ne, dim, dofs1D, quad1D, maps->B, pa_data, x, y);
+      return;
+   }
    PAVectorMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
 }
 
@@ -512,8 +556,36 @@ static void PAVectorMassAssembleDiagonal(const int dim,
    MFEM_ABORT("Dimension not implemented.");
 }
 
+static void PAVectorMassAssembleDiagonalFull(const int NE,
+                                             const int VDIM,
+                                             const int ND,
+                                             const int NQ,
+                                             const Array<double> &b,
+                                             const Vector &op,
+                                             Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(op.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; ++i)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q) { val += B(q,i) * B(q,i) * D(q,e); }
+         for (int c = 0; c < VDIM; ++c) { Y(i,c,e) += val; }
+      }
+   });
+}
+
 void VectorMassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAVectorMassAssembleDiagonalFull(ne, dim, dofs1D, quad1D, maps->B,
+                                       pa_data, diag);
+      return;
+   }
    PAVectorMassAssembleDiagonal(dim,
                                 dofs1D,
                                 quad1D,
@@ -332,6 +332,48 @@ void FiniteElementSpace::BuildDofToArrays()
    }
 }
 
+const Table &FiniteElementSpace::GetElementColoring() const
+{
+   if (elem_colors.Size() < 0)
+   {
+      BuildElementToDofTable();
+      // Only the dof indices matter, so decode the signed dofs
+      Table el_dof(*elem_dof);
+      int *J = el_dof.GetJ();
+      for (int k = 0; k < el_dof.Size_of_connections(); k++)
+      {
+         if (J[k] < 0) { J[k] = -1 - J[k]; }
+      }
+      ColorRows(el_dof, elem_colors, ndofs);
+   }
+   return elem_colors;
+}
+
+void FiniteElementSpace::ForAllColoredElements(
+   const ThreadExecutor::RangeBody &body, bool concurrent) const
+{
+   const Table &colors = GetElementColoring();
+#ifdef MFEM_THREAD_SAFE
+   concurrent = true;
+#endif
+   if (!concurrent)
+   {
+      body(0, colors.Size_of_connections());
+      return;
+   }
+   ThreadExecutor &exec = GetThreadExecutor();
+   for (int c = 0; c < colors.Size(); c++)
+   {
+      const int offset = colors.GetI()[c];
+      const int n = colors.RowSize(c);
+      const int grain = ThreadsGrainSize(n, exec.NumThreads(), 1);
+      exec.ParallelFor(n, grain, [&](int begin, int end)
+      {
+         body(offset + begin, offset + end);
+      });
+   }
+}
+
 static void mark_dofs(const Array<int> &dofs, Array<int> &mark_array)
 {
    for (int i = 0; i < dofs.Size(); i++)
@@ -2141,6 +2183,7 @@ void FiniteElementSpace::Destroy()
 
    dof_elem_array.DeleteAll();
    dof_ldof_array.DeleteAll();
+   elem_colors.Clear();
 
    if (NURBSext)
    {
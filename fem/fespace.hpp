@@ -13,6 +13,7 @@
 #define MFEM_FESPACE
 
 #include "../config/config.hpp"
+#include "../general/threads.hpp"
 #include "../linalg/sparsemat.hpp"
 #include "../mesh/mesh.hpp"
 #include "fe_coll.hpp"
@@ -117,6 +118,9 @@ protected:
 
    Array<int> dof_elem_array, dof_ldof_array;
 
+   /// Coloring of the mesh elements, see GetElementColoring().
+   mutable Table elem_colors;
+
    NURBSExtension *NURBSext;
    int own_ext;
 
@@ -569,6 +573,20 @@ public:
        BuildDofToArrays(). */
    int GetLocalDofForDof(int i) const { return dof_ldof_array[i]; }
 
+   /** @brief Return a Table whose row c lists the mesh elements of color c,
+       where elements of the same color have no common dof. */
+   /** The coloring is computed on first use from the element-to-dof table. */
+   const Table &GetElementColoring() const;
+
+   /** @brief Call @a body(begin, end) on ranges [begin, end) of the entries of
+       GetElementColoring().GetJ(), covering all elements, color by color. */
+   /** If @a concurrent is true, or in builds with MFEM_THREAD_SAFE, the ranges
+       of each color are executed concurrently by GetThreadExecutor(), so
+       @a body must only write to the dofs of its elements and must not use
+       shared scratch data; otherwise, the traversal is sequential. */
+   void ForAllColoredElements(const ThreadExecutor::RangeBody &body,
+                              bool concurrent = false) const;
+
    /** @brief Returns pointer to the FiniteElement in the FiniteElementCollection
         associated with i'th element in the mesh object. */
    const FiniteElement *GetFE(int i) const;
@@ -76,6 +76,36 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+void LinearForm::AssembleColoredElements()
+{
+   // The elements of one color have no common dofs
+   double *b = HostReadWrite();
+   const int *elems = fes->GetElementColoring().GetJ();
+   fes->ForAllColoredElements([&](int begin, int end)
+   {
+      Array<int> vdofs;
+      Vector elemvect;
+      IsoparametricTransformation eltrans;
+      for (int k = begin; k < end; k++)
+      {
+         const int i = elems[k];
+         const FiniteElement &fe = *fes->GetFE(i);
+         fes->GetElementVDofs(i, vdofs);
+         fes->GetElementTransformation(i, &eltrans);
+         for (int n = 0; n < dlfi.Size(); n++)
+         {
+            dlfi[n]->AssembleRHSElementVect(fe, eltrans, elemvect);
+            for (int j = 0; j < vdofs.Size(); j++)
+            {
+               const int vdof = vdofs[j];
+               if (vdof >= 0) { b[vdof] += elemvect(j); }
+               else { b[-1-vdof] -= elemvect(j); }
+            }
+         }
+      }
+   });
+}
+
 void LinearForm::Assemble()
 {
    Array<int> vdofs;
@@ -90,7 +120,11 @@ void LinearForm::Assemble()
    // The first use of AddElementVector() below will move it back to host
    // because both 'vdofs' and 'elemvect' are on host.
 
-   if (dlfi.Size())
+   if (dlfi.Size() && Device::Allows(Backend::THREADS))
+   {
+      AssembleColoredElements();
+   }
+   else if (dlfi.Size())
    {
       for (i = 0; i < fes -> GetNE(); i++)
       {
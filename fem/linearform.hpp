@@ -56,6 +56,9 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Assemble the domain integrators, traversing the elements by colors.
+   void AssembleColoredElements();
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -153,6 +156,11 @@ public:
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
+   /** When Backend::THREADS is enabled, the domain integrators are assembled by
+       traversing the elements by colors, see
+       FiniteElementSpace::ForAllColoredElements(), which is sequential unless
+       MFEM is built with MFEM_THREAD_SAFE; the coefficients must then be
+       thread-safe. */
    void Assemble();
 
    /// Assembles delta functions of the linear form
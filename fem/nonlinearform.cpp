@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -138,6 +139,16 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
    if (ext)
    {
       ext->Mult(px, py);
+      if (Serial())
+      {
+         if (cP) { cP->MultTranspose(py, y); }
+         const int N = ess_tdof_list.Size();
+         const auto tdof = ess_tdof_list.Read();
+         auto Y = y.ReadWrite();
+         MFEM_FORALL(i, N, Y[tdof[i]] = 0.0; );
+      }
+      // In parallel, the result is in aux2 which is assembled by
+      // ParNonlinearForm::Mult.
       return;
    }
 
@@ -264,7 +275,13 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
    if (ext)
    {
-      MFEM_ABORT("Not yet implemented!");
+      // The matrix-free gradient is restricted to the true dofs by RAP with
+      // the prolongation of the FE space and the essential boundary
+      // conditions are imposed by a ConstrainedOperator.
+      Operator *Gop;
+      ext->GetGradient(Prolongate(x)).FormSystemOperator(ess_tdof_list, Gop);
+      hGrad.Reset(Gop);
+      return *hGrad.Ptr();
    }
 
    const int skip_zeros = 0;
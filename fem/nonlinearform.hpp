@@ -46,6 +46,9 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// Gradient Operator when the assembly level is not AssemblyLevel::NONE.
+   mutable OperatorHandle hGrad;
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -154,6 +157,10 @@ public:
 
        In general, @a x may have non-homogeneous essential boundary values.
 
+       With AssemblyLevel::PARTIAL, the returned Operator applies the gradient
+       without assembling a matrix, see
+       NonlinearFormIntegrator::AssembleGradPA().
+
        The state @a x must be a true-dof vector. */
    virtual Operator &GetGradient(const Vector &x) const;
 
@@ -26,7 +26,9 @@ NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
 PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form):
    NonlinearFormExtension(form), fes(*form->FESpace())
 {
-   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+   const ElementDofOrdering ordering = UsesTensorBasis(fes) ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
    elem_restrict_lex = fes.GetElementRestriction(ordering);
    if (elem_restrict_lex)
    {
@@ -71,4 +73,61 @@ void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   grad.Reset(new Gradient(x, *this));
+   return *grad.Ptr();
+}
+
+PANonlinearFormExtension::Gradient::Gradient(const Vector &x,
+                                             const PANonlinearFormExtension &e)
+   : Operator(e.fes.GetVSize()), ext(e)
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   if (ext.elem_restrict_lex)
+   {
+      localX.SetSize(ext.localX.Size(), Device::GetMemoryType());
+      localY.SetSize(ext.localY.Size(), Device::GetMemoryType());
+      localY.UseDevice(true);
+      ext.elem_restrict_lex->Mult(x, localX);
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradPA(localX, ext.fes);
+      }
+   }
+   else
+   {
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradPA(x, ext.fes);
+      }
+   }
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   if (ext.elem_restrict_lex)
+   {
+      ext.elem_restrict_lex->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(localX, localY);
+      }
+      ext.elem_restrict_lex->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(x, y);
+      }
+   }
+}
+
 }
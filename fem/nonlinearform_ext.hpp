@@ -26,19 +26,40 @@ protected:
 public:
    NonlinearFormExtension(NonlinearForm *form);
    virtual void AssemblePA() = 0;
+   /** @brief Return the gradient Operator at the state @a x, an L-vector,
+       without essential boundary conditions. */
+   virtual Operator &GetGradient(const Vector &x) const = 0;
 };
 
 /// Data and methods for partially-assembled nonlinear forms
 class PANonlinearFormExtension : public NonlinearFormExtension
 {
 protected:
+   /// Matrix-free action of the gradient of the domain integrators.
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+      mutable Vector localX, localY;
+   public:
+      /// Assemble the gradient of the integrators at the state @a x.
+      Gradient(const Vector &x, const PANonlinearFormExtension &e);
+      virtual void Mult(const Vector &x, Vector &y) const;
+      virtual const Operator *GetProlongation() const
+      { return ext.fes.GetProlongationMatrix(); }
+      virtual const Operator *GetRestriction() const
+      { return ext.fes.GetRestrictionMatrix(); }
+   };
+
    const FiniteElementSpace &fes; // Not owned
    mutable Vector localX, localY;
    const Operator *elem_restrict_lex; // Not owned
+   mutable OperatorHandle grad;
 public:
    PANonlinearFormExtension(NonlinearForm*);
    void AssemblePA();
    void Mult(const Vector &x, Vector &y) const;
+   Operator &GetGradient(const Vector &x) const;
 };
 }
 #endif // NONLINEARFORM_EXT_HPP
@@ -34,6 +34,19 @@ void NonlinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void NonlinearFormIntegrator::AssembleGradPA(const Vector &,
+                                             const FiniteElementSpace &)
+{
+   mfem_error ("NonlinearFormIntegrator::AssembleGradPA(...)\n"
+               "   is not implemented for this class.");
+}
+
+void NonlinearFormIntegrator::AddMultGradPA(const Vector &, Vector &) const
+{
+   mfem_error ("NonlinearFormIntegrator::AddMultGradPA(...)\n"
+               "   is not implemented for this class.");
+}
+
 void NonlinearFormIntegrator::AssembleElementVector(
    const FiniteElement &el, ElementTransformation &Tr,
    const Vector &elfun, Vector &elvect)
@@ -240,6 +253,18 @@ inline void NeoHookeanModel::EvalCoeffs() const
    }
 }
 
+void NeoHookeanModel::EvalParameters(double &mu_, double &K_,
+                                     double &g_) const
+{
+   if (have_coeffs)
+   {
+      EvalCoeffs();
+   }
+   mu_ = mu;
+   K_ = K;
+   g_ = g;
+}
+
 double NeoHookeanModel::EvalW(const DenseMatrix &J) const
 {
    int dim = J.Width();
@@ -88,6 +88,21 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Prepare the partially assembled action of the gradient.
+   /** The data needed to apply the gradient of the integrator at the state
+       @a x, an E-vector, is stored internally so that it can be used later in
+       the method AddMultGradPA().
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for partially assembled gradient action.
+   /** Perform the action of the gradient of the integrator, at the state given
+       to AssembleGradPA(), on the input @a x and add the result to the output
+       @a y. Both @a x and @a y are E-vectors. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -226,6 +241,10 @@ public:
 
    virtual void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   /** @brief Evaluate the parameters @a mu_, @a K_ and @a g_ at the current
+       integration point of the transformation set with SetTransformation(). */
+   void EvalParameters(double &mu_, double &K_, double &g_) const;
 };
 
 
@@ -253,6 +272,14 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   int dim, ne, nd, nq, pa_model;
+   Vector pa_G;     ///< Reference gradients of the basis (NQ x DIM x ND)
+   Vector pa_Jinv;  ///< Inverse reference-to-target Jacobians (Jrt)
+   Vector pa_W;     ///< Quadrature weights times the target determinants
+   Vector pa_coeff; ///< NeoHookeanModel parameters mu, K, g at the points
+   Vector pa_F;     ///< Jpt at the state given to AssembleGradPA()
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
    HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
@@ -272,6 +299,20 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /** @brief Partial assembly for the NeoHookeanModel and the
+       InverseHarmonicModel. */
+   /** The target configuration is given by the mesh at the time of the call;
+       this method must be called again if the mesh nodes change. */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
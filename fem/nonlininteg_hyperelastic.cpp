@@ -0,0 +1,378 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "fem.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// Hyperelastic models supported by the PA kernels.
+enum { PA_INVERSE_HARMONIC = 0, PA_NEO_HOOKEAN = 1 };
+
+// In the pointwise functions below, all matrices are DIM x DIM and stored in
+// column-major order.
+
+template<int DIM> MFEM_HOST_DEVICE static inline
+double DDot(const double *A, const double *B)
+{
+   double s = 0.0;
+   for (int i = 0; i < DIM*DIM; i++) { s += A[i]*B[i]; }
+   return s;
+}
+
+// M = J^{-t}
+template<int DIM> MFEM_HOST_DEVICE static inline
+void InverseTranspose(const double *J, double *M)
+{
+   double Jinv[DIM*DIM];
+   kernels::CalcInverse<DIM>(J, Jinv);
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++) { M[i+DIM*j] = Jinv[j+DIM*i]; }
+   }
+}
+
+// dM = -M H^t M, the derivative of M = J^{-t} in the direction H.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void InverseTransposeDerivative(const double *M, const double *H, double *dM)
+{
+   double MHt[DIM*DIM];
+   kernels::MultABt(DIM, DIM, DIM, M, H, MHt);
+   kernels::Mult(DIM, DIM, DIM, MHt, M, dM);
+   for (int i = 0; i < DIM*DIM; i++) { dM[i] = -dM[i]; }
+}
+
+/// The first Piola-Kirchhoff stress P(J), see NeoHookeanModel::EvalP() and
+/// InverseHarmonicModel::EvalP(). The NeoHookeanModel parameters (mu, K, g)
+/// are given in @a c.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void HyperelasticEvalP(const int model, const double *c, const double *J,
+                       double *P)
+{
+   double M[DIM*DIM];
+   InverseTranspose<DIM>(J, M);
+   const double dJ = kernels::Det<DIM>(J);
+   if (model == PA_NEO_HOOKEAN)
+   {
+      // P = a J + beta J^{-t}
+      const double mu = c[0], K = c[1], g = c[2];
+      const double a = mu*pow(dJ, -2.0/DIM);
+      const double beta = K*dJ*(dJ/g - 1.0)/g - a*DDot<DIM>(J, J)/DIM;
+      for (int i = 0; i < DIM*DIM; i++) { P[i] = a*J[i] + beta*M[i]; }
+   }
+   else
+   {
+      // P = -det(J) (M M^t M - (1/2) |M|^2 M)
+      double MMt[DIM*DIM], T[DIM*DIM];
+      const double t = DDot<DIM>(M, M);
+      kernels::MultABt(DIM, DIM, DIM, M, M, MMt);
+      kernels::Mult(DIM, DIM, DIM, MMt, M, T);
+      for (int i = 0; i < DIM*DIM; i++) { P[i] = -dJ*(T[i] - 0.5*t*M[i]); }
+   }
+}
+
+/// The derivative dP = dP/dJ(J)[H] of the stress in HyperelasticEvalP() in the
+/// direction @a H.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void HyperelasticEvaldP(const int model, const double *c, const double *J,
+                        const double *H, double *dP)
+{
+   double M[DIM*DIM], dM[DIM*DIM];
+   InverseTranspose<DIM>(J, M);
+   InverseTransposeDerivative<DIM>(M, H, dM);
+   const double dJ = kernels::Det<DIM>(J);
+   const double tr = DDot<DIM>(M, H); // d(det(J)) = det(J) tr
+   if (model == PA_NEO_HOOKEAN)
+   {
+      const double mu = c[0], K = c[1], g = c[2];
+      const double JJ = DDot<DIM>(J, J);
+      const double a = mu*pow(dJ, -2.0/DIM);
+      const double beta = K*dJ*(dJ/g - 1.0)/g - a*JJ/DIM;
+      const double da = -2.0*a*tr/DIM;
+      const double dbeta = K*dJ*tr*(2.0*dJ/g - 1.0)/g
+                           - da*JJ/DIM - 2.0*a*DDot<DIM>(J, H)/DIM;
+      for (int i = 0; i < DIM*DIM; i++)
+      {
+         dP[i] = da*J[i] + a*H[i] + dbeta*M[i] + beta*dM[i];
+      }
+   }
+   else
+   {
+      double MMt[DIM*DIM], MtM[DIM*DIM], T[DIM*DIM], dT[DIM*DIM];
+      double W1[DIM*DIM], W2[DIM*DIM];
+      const double t = DDot<DIM>(M, M);
+      const double dt = 2.0*DDot<DIM>(M, dM);
+      kernels::MultABt(DIM, DIM, DIM, M, M, MMt);
+      kernels::Mult(DIM, DIM, DIM, MMt, M, T);
+      for (int i = 0; i < DIM; i++)
+      {
+         for (int j = 0; j < DIM; j++)
+         {
+            double s = 0.0;
+            for (int k = 0; k < DIM; k++) { s += M[k+DIM*i]*M[k+DIM*j]; }
+            MtM[i+DIM*j] = s;
+         }
+      }
+      // dT = dM M^t M + M dM^t M + M M^t dM
+      kernels::Mult(DIM, DIM, DIM, dM, MtM, dT);
+      kernels::MultABt(DIM, DIM, DIM, M, dM, W1);
+      kernels::Mult(DIM, DIM, DIM, W1, M, W2);
+      for (int i = 0; i < DIM*DIM; i++) { dT[i] += W2[i]; }
+      kernels::Mult(DIM, DIM, DIM, MMt, dM, W2);
+      for (int i = 0; i < DIM*DIM; i++)
+      {
+         dT[i] += W2[i];
+         dP[i] = -dJ*tr*(T[i] - 0.5*t*M[i])
+                 - dJ*(dT[i] - 0.5*dt*M[i] - 0.5*t*dM[i]);
+      }
+   }
+}
+
+// PA hyperelastic setup: the inverse of the reference-to-target Jacobian and
+// the quadrature weights scaled by its determinant.
+template<int DIM> static
+void PAHyperelasticSetup(const int NE, const int NQ, const Array<double> &w,
+                         const Vector &j, const Vector &detj, Vector &jinv,
+                         Vector &wdetj)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto detJ = Reshape(detj.Read(), NQ, NE);
+   auto Jinv = Reshape(jinv.Write(), DIM, DIM, NQ, NE);
+   auto WdetJ = Reshape(wdetj.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jq[DIM*DIM];
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int d = 0; d < DIM; d++) { Jq[c+DIM*d] = J(q,c,d,e); }
+         }
+         kernels::CalcInverse<DIM>(Jq, &Jinv(0,0,q,e));
+         WdetJ(q,e) = W[q] * detJ(q,e);
+      }
+   });
+}
+
+// Evaluate the target-to-physical Jacobian, X^t DS, at the quadrature point q
+// of element e.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void PAHyperelasticJacobian(const int ND, const int q, const int e,
+                            const DeviceTensor<3, const double> &G,
+                            const DeviceTensor<4, const double> &Jinv,
+                            const DeviceTensor<3, const double> &X,
+                            double *Jpt)
+{
+   double Jpr[DIM*DIM];
+   for (int i = 0; i < DIM*DIM; i++) { Jpr[i] = 0.0; }
+   for (int d = 0; d < ND; d++)
+   {
+      for (int k = 0; k < DIM; k++)
+      {
+         const double g = G(q,k,d);
+         for (int c = 0; c < DIM; c++) { Jpr[c+DIM*k] += X(d,c,e) * g; }
+      }
+   }
+   kernels::Mult(DIM, DIM, DIM, Jpr, &Jinv(0,0,q,e), Jpt);
+}
+
+// Store the target-to-physical Jacobian at the state x.
+template<int DIM> static
+void PAHyperelasticAssembleGrad(const int NE, const int ND, const int NQ,
+                                const Vector &g, const Vector &jinv,
+                                const Vector &x, Vector &f)
+{
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto Jinv = Reshape(jinv.Read(), DIM, DIM, NQ, NE);
+   auto X = Reshape(x.Read(), ND, DIM, NE);
+   auto F = Reshape(f.Write(), DIM, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         PAHyperelasticJacobian<DIM>(ND, q, e, G, Jinv, X, &F(0,0,q,e));
+      }
+   });
+}
+
+// Apply the residual (grad == false) at the state x or the gradient at the
+// stored state f (grad == true) to the direction x.
+template<int DIM> static
+void PAHyperelasticApply(const int model, const bool grad, const int NE,
+                         const int ND, const int NQ, const Vector &g,
+                         const Vector &jinv, const Vector &wdetj,
+                         const Vector &coeff, const Vector &f,
+                         const Vector &x, Vector &y)
+{
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto Jinv = Reshape(jinv.Read(), DIM, DIM, NQ, NE);
+   auto WdetJ = Reshape(wdetj.Read(), NQ, NE);
+   auto C = Reshape(coeff.Read(), 3, NQ, NE);
+   auto F = Reshape(f.Read(), DIM, DIM, NQ, NE);
+   auto X = Reshape(x.Read(), ND, DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double A[DIM*DIM], P[DIM*DIM], Q[DIM*DIM];
+         PAHyperelasticJacobian<DIM>(ND, q, e, G, Jinv, X, A);
+         const double *c = (model == PA_NEO_HOOKEAN) ? &C(0,q,e) : NULL;
+         if (grad) { HyperelasticEvaldP<DIM>(model, c, &F(0,0,q,e), A, P); }
+         else { HyperelasticEvalP<DIM>(model, c, A, P); }
+         // Q = w det(J) P Jinv^t, so that Y(d,c) += sum_k G(q,k,d) Q(c,k)
+         kernels::MultABt(DIM, DIM, DIM, P, &Jinv(0,0,q,e), Q);
+         const double w = WdetJ(q,e);
+         for (int d = 0; d < ND; d++)
+         {
+            for (int c = 0; c < DIM; c++)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += G(q,k,d) * Q[c+DIM*k]; }
+               Y(d,c,e) += w * s;
+            }
+         }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (!ir)
+   {
+      ir = &(IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3));
+   }
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   nd = el.GetDof();
+   nq = ir->GetNPoints();
+   MFEM_VERIFY(dim == 2 || dim == 3, "PA is only implemented in 2D and 3D!");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "invalid vector dimension of the FE space");
+
+   NeoHookeanModel *nh = dynamic_cast<NeoHookeanModel*>(model);
+   if (nh) { pa_model = PA_NEO_HOOKEAN; }
+   else if (dynamic_cast<InverseHarmonicModel*>(model))
+   {
+      pa_model = PA_INVERSE_HARMONIC;
+   }
+   else
+   {
+      MFEM_ABORT("PA is only implemented for NeoHookeanModel and "
+                 "InverseHarmonicModel!");
+   }
+
+   // Reference gradients of the basis functions, using the dof ordering of the
+   // E-vectors of PANonlinearFormExtension.
+   const TensorBasisElement *tbe =
+      dynamic_cast<const TensorBasisElement*>(&el);
+   const int *dof_map = (UsesTensorBasis(fes) && tbe->GetDofMap().Size()) ?
+                        tbe->GetDofMap().GetData() : NULL;
+   DenseMatrix dshape(nd, dim);
+   pa_G.SetSize(nq*dim*nd, Device::GetMemoryType());
+   auto G = Reshape(pa_G.HostWrite(), nq, dim, nd);
+   for (int q = 0; q < nq; q++)
+   {
+      el.CalcDShape(ir->IntPoint(q), dshape);
+      for (int k = 0; k < dim; k++)
+      {
+         for (int d = 0; d < nd; d++)
+         {
+            G(q,k,d) = dshape(dof_map ? dof_map[d] : d, k);
+         }
+      }
+   }
+
+   const int flags = GeometricFactors::JACOBIANS |
+                     GeometricFactors::DETERMINANTS;
+   const GeometricFactors *geom = mesh->GetGeometricFactors(*ir, flags);
+   pa_Jinv.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   pa_W.SetSize(nq*ne, Device::GetMemoryType());
+   pa_F.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   if (dim == 2)
+   {
+      PAHyperelasticSetup<2>(ne, nq, ir->GetWeights(), geom->J, geom->detJ,
+                             pa_Jinv, pa_W);
+   }
+   else
+   {
+      PAHyperelasticSetup<3>(ne, nq, ir->GetWeights(), geom->J, geom->detJ,
+                             pa_Jinv, pa_W);
+   }
+
+   pa_coeff.SetSize(nh ? 3*nq*ne : 0, Device::GetMemoryType());
+   if (nh)
+   {
+      auto C = Reshape(pa_coeff.HostWrite(), 3, nq, ne);
+      for (int e = 0; e < ne; e++)
+      {
+         ElementTransformation &T = *mesh->GetElementTransformation(e);
+         model->SetTransformation(T);
+         for (int q = 0; q < nq; q++)
+         {
+            T.SetIntPoint(&ir->IntPoint(q));
+            nh->EvalParameters(C(0,q,e), C(1,q,e), C(2,q,e));
+         }
+      }
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (dim == 2)
+   {
+      PAHyperelasticApply<2>(pa_model, false, ne, nd, nq, pa_G, pa_Jinv, pa_W,
+                             pa_coeff, pa_F, x, y);
+   }
+   else
+   {
+      PAHyperelasticApply<3>(pa_model, false, ne, nd, nq, pa_G, pa_Jinv, pa_W,
+                             pa_coeff, pa_F, x, y);
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &)
+{
+   if (dim == 2)
+   {
+      PAHyperelasticAssembleGrad<2>(ne, nd, nq, pa_G, pa_Jinv, x, pa_F);
+   }
+   else
+   {
+      PAHyperelasticAssembleGrad<3>(ne, nd, nq, pa_G, pa_Jinv, x, pa_F);
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x,
+                                              Vector &y) const
+{
+   if (dim == 2)
+   {
+      PAHyperelasticApply<2>(pa_model, true, ne, nd, nq, pa_G, pa_Jinv, pa_W,
+                             pa_coeff, pa_F, x, y);
+   }
+   else
+   {
+      PAHyperelasticApply<3>(pa_model, true, ne, nd, nq, pa_G, pa_Jinv, pa_W,
+                             pa_coeff, pa_F, x, y);
+   }
+}
+
+} // namespace mfem
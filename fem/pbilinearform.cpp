@@ -15,6 +15,7 @@
 
 #include "fem.hpp"
 #include "../general/sort_pairs.hpp"
+#include <algorithm>
 
 namespace mfem
 {
@@ -130,7 +131,41 @@ void ParBilinearForm::ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local)
 
    OperatorHandle dA(A.Type()), Ph(A.Type()), hdA;
 
-   if (fbfi.Size() == 0)
+   if (fbfi.Size() == 0 && A.Type() == Operator::Hypre_ParCSR &&
+       UseScatterMaps() && A_local == scatter_mat)
+   {
+      // reuse the parallel block-diagonal matrix, updating only its values
+      if (p_diag_version != scatter_version)
+      {
+         p_diag.Clear();
+         delete p_diag_local;
+         // the HypreParMatrix shares the arrays of 'p_diag_local' and moves
+         // the diagonal entries first, so 'A_local' keeps its sorted columns
+         p_diag_local = new SparseMatrix(*A_local);
+         p_diag.Reset(new HypreParMatrix(pfes->GetComm(), pfes->GlobalVSize(),
+                                         pfes->GetDofOffsets(), p_diag_local));
+         const int *I = A_local->GetI(), *J = A_local->GetJ();
+         const int *pJ = p_diag_local->GetJ();
+         p_diag_map.SetSize(A_local->NumNonZeroElems());
+         for (int i = 0; i < A_local->Height(); i++)
+         {
+            for (int k = I[i]; k < I[i+1]; k++)
+            {
+               const int *pos = std::lower_bound(J + I[i], J + I[i+1], pJ[k]);
+               p_diag_map[pos - J] = k;
+            }
+         }
+         p_diag_version = scatter_version;
+      }
+      const double *data = A_local->HostReadData();
+      double *p_data = p_diag_local->HostReadWriteData();
+      for (int k = 0; k < p_diag_map.Size(); k++)
+      {
+         p_data[p_diag_map[k]] = data[k];
+      }
+      dA = p_diag;
+   }
+   else if (fbfi.Size() == 0)
    {
       // construct a parallel block-diagonal matrix 'A' based on 'a'
       dA.MakeSquareBlockDiag(pfes->GetComm(), pfes->GlobalVSize(),
@@ -298,7 +333,8 @@ void ParBilinearForm::FormLinearSystem(
    const Array<int> &ess_tdof_list, Vector &x, Vector &b,
    OperatorHandle &A, Vector &X, Vector &B, int copy_interior)
 {
-   if (ext)
+   // The extension of AssemblyLevel::FULL only assembles the local matrix.
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
       return;
@@ -347,7 +383,7 @@ void ParBilinearForm::FormLinearSystem(
 void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                        OperatorHandle &A)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
       return;
@@ -371,12 +407,22 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
       {
          const int remove_zeros = 0;
          Finalize(remove_zeros);
+         const bool reuse = UseScatterMaps() && mat == scatter_mat;
+         if (reuse)
+         {
+            // the local matrix was reassembled into the cached pattern
+            p_mat.Clear();
+            p_mat_e.Clear();
+         }
          MFEM_VERIFY(p_mat.Ptr() == NULL && p_mat_e.Ptr() == NULL,
                      "The ParBilinearForm must be updated with Update() before "
                      "re-assembling the ParBilinearForm.");
          ParallelAssemble(p_mat, mat);
-         delete mat;
-         mat = NULL;
+         if (!reuse)
+         {
+            delete mat;
+            mat = NULL;
+         }
          delete mat_e;
          mat_e = NULL;
          p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
@@ -395,7 +441,7 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 void ParBilinearForm::RecoverFEMSolution(
    const Vector &X, const Vector &b, Vector &x)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->RecoverFEMSolution(X, b, x);
       return;
@@ -439,6 +485,8 @@ void ParBilinearForm::Update(FiniteElementSpace *nfes)
 
    p_mat.Clear();
    p_mat_e.Clear();
+   p_diag.Clear();
+   p_diag_version = -1;
 }
 
 
@@ -37,6 +37,17 @@ protected:
 
    bool keep_nbr_block;
 
+   /** @brief Block-diagonal parallel matrix reused by ParallelAssemble() with
+       EnableSparsityReuse(). It shares the data of #p_diag_local. */
+   OperatorHandle p_diag;
+   /** @brief Copy of the local matrix #mat in which the diagonal entries have
+       been moved first in each row by hypre. Owned. */
+   SparseMatrix *p_diag_local;
+   /// Index in the data of #p_diag_local of each entry of #mat.
+   Array<int> p_diag_map;
+   /// Value of #scatter_version for which #p_diag was built.
+   long p_diag_version;
+
    // Allocate mat - called when (mat == NULL && fbfi.Size() > 0)
    void pAllocMat();
 
@@ -54,7 +65,8 @@ public:
    /** The pointer @a pf is not owned by the newly constructed object. */
    ParBilinearForm(ParFiniteElementSpace *pf)
       : BilinearForm(pf), pfes(pf),
-        p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
+        p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR),
+        p_diag(Operator::Hypre_ParCSR), p_diag_local(NULL), p_diag_version(-1)
    { keep_nbr_block = false; }
 
    /** @brief Create a ParBilinearForm on the ParFiniteElementSpace @a *pf,
@@ -66,7 +78,8 @@ public:
        the newly constructed ParBilinearForm. */
    ParBilinearForm(ParFiniteElementSpace *pf, ParBilinearForm *bf)
       : BilinearForm(pf, bf), pfes(pf),
-        p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
+        p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR),
+        p_diag(Operator::Hypre_ParCSR), p_diag_local(NULL), p_diag_version(-1)
    { keep_nbr_block = false; }
 
    /** When set to true and the ParBilinearForm has interior face integrators,
@@ -112,7 +125,12 @@ public:
    { ParallelAssemble(A_elim, mat_e); }
 
    /** Returns the matrix @a A_local assembled on the true dofs, i.e.
-       @a A = P^t A_local P in the format (type id) specified by @a A. */
+       @a A = P^t A_local P in the format (type id) specified by @a A.
+
+       With EnableSparsityReuse(), when @a A_local is the internal matrix and
+       @a A has type Operator::Hypre_ParCSR, the block-diagonal parallel matrix
+       is built once for the cached sparsity pattern and only its values are
+       updated by the subsequent calls. */
    void ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local);
 
    /// Eliminate essential boundary DOFs from a parallel assembled system.
@@ -181,7 +199,7 @@ public:
 
    virtual void Update(FiniteElementSpace *nfes = NULL);
 
-   virtual ~ParBilinearForm() { }
+   virtual ~ParBilinearForm() { p_diag.Clear(); delete p_diag_local; }
 };
 
 /// Class for parallel bilinear form using different test and trial FE spaces.
@@ -16,6 +16,7 @@
 #include "pfespace.hpp"
 #include "prestriction.hpp"
 #include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../mesh/mesh_headers.hpp"
 #include "../general/binaryio.hpp"
@@ -925,6 +926,7 @@ void ParFiniteElementSpace::ExchangeFaceNbrData()
 {
    if (num_face_nbr_dofs >= 0) { return; }
 
+   MFEM_PERF_SCOPE("ParFiniteElementSpace::ExchangeFaceNbrData");
    pmesh->ExchangeFaceNbrData();
 
    int num_face_nbrs = pmesh->GetNFaceNeighbors();
@@ -3002,6 +3004,7 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("ConformingProlongationOperator::Mult");
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
 
@@ -3028,6 +3031,7 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("ConformingProlongationOperator::MultTranspose");
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
 
@@ -3169,6 +3173,7 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
 void DeviceConformingProlongationOperator::Mult(const Vector &x,
                                                 Vector &y) const
 {
+   MFEM_PERF_SCOPE("DeviceConformingProlongationOperator::Mult");
    const GroupTopology &gtopo = gc.GetGroupTopology();
    BcastBeginCopy(x); // copy to 'shr_buf'
    int req_counter = 0;
@@ -3194,7 +3199,10 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
       }
    }
    BcastLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   {
+      MFEM_PERF_SCOPE("MPI_Waitall");
+      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   }
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
@@ -3257,6 +3265,7 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
 void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                                                          Vector &y) const
 {
+   MFEM_PERF_SCOPE("DeviceConformingProlongationOperator::MultTranspose");
    const GroupTopology &gtopo = gc.GetGroupTopology();
    ReduceBeginCopy(x); // copy to 'ext_buf'
    int req_counter = 0;
@@ -3282,7 +3291,10 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
       }
    }
    ReduceLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   {
+      MFEM_PERF_SCOPE("MPI_Waitall");
+      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   }
    ReduceEndAssemble(y); // assemble from 'shr_buf'
 }
 
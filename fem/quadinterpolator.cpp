@@ -415,6 +415,100 @@ void QuadratureInterpolator::MultTranspose(
 }
 
 
+// Evaluation with the byVDIM output layout for non-tensor elements, e.g.
+// simplices, using the dense matrices of the DofToQuad::FULL maps.
+static void D2QValuesFull(const int NE,
+                          const int vdim,
+                          const DofToQuad &maps,
+                          const Vector &e_vec,
+                          Vector &q_val)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto x = Reshape(e_vec.Read(), ND, vdim, NE);
+   auto y = Reshape(q_val.Write(), vdim, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            double u = 0.0;
+            for (int d = 0; d < ND; ++d) { u += B(q,d) * x(d,c,e); }
+            y(c,q,e) = u;
+         }
+      }
+   });
+}
+
+// Reference derivatives, or physical derivatives when 'geom' is not NULL, with
+// the byVDIM output layout for non-tensor elements.
+template<int DIM>
+static void D2QGradFull(const int NE,
+                        const int vdim,
+                        const DofToQuad &maps,
+                        const GeometricFactors *geom,
+                        const Vector &e_vec,
+                        Vector &q_der)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const bool phys = geom != NULL;
+   auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+   auto j = Reshape(phys ? geom->J.Read() : NULL, NQ, DIM, DIM, NE);
+   auto x = Reshape(e_vec.Read(), ND, vdim, NE);
+   auto y = Reshape(q_der.Write(), vdim, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double Jinv[DIM*DIM];
+         if (phys)
+         {
+            double Jloc[DIM*DIM];
+            for (int k = 0; k < DIM; ++k)
+            {
+               for (int l = 0; l < DIM; ++l) { Jloc[k+DIM*l] = j(q,k,l,e); }
+            }
+            kernels::CalcInverse<DIM>(Jloc, Jinv);
+         }
+         for (int c = 0; c < vdim; ++c)
+         {
+            double grad[DIM];
+            for (int k = 0; k < DIM; ++k)
+            {
+               grad[k] = 0.0;
+               for (int d = 0; d < ND; ++d) { grad[k] += G(q,k,d) * x(d,c,e); }
+            }
+            for (int l = 0; l < DIM; ++l)
+            {
+               double u = phys ? 0.0 : grad[l];
+               for (int k = 0; phys && k < DIM; ++k)
+               {
+                  u += Jinv[k+DIM*l] * grad[k];
+               }
+               y(c,l,q,e) = u;
+            }
+         }
+      }
+   });
+}
+
+static void D2QGradFull(const FiniteElementSpace &fes,
+                        const GeometricFactors *geom,
+                        const DofToQuad &maps,
+                        const Vector &e_vec,
+                        Vector &q_der)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int vdim = fes.GetVDim();
+   const int NE = fes.GetNE();
+   if (dim == 2) { return D2QGradFull<2>(NE, vdim, maps, geom, e_vec, q_der); }
+   if (dim == 3) { return D2QGradFull<3>(NE, vdim, maps, geom, e_vec, q_der); }
+   MFEM_ABORT("Unknown kernel");
+}
+
 template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void D2QValues2D(const int NE,
                         const Array<double> &b_,
@@ -685,6 +779,13 @@ void QuadratureInterpolator::Values(const Vector &e_vec, Vector &q_val) const
    // q_layout == QVectorLayout::byVDIM
    if (fespace->GetNE() == 0) { return; }
    const IntegrationRule &ir = *IntRule;
+   if (!UsesTensorBasis(*fespace))
+   {
+      const DofToQuad::Mode mode = DofToQuad::FULL;
+      const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
+      D2QValuesFull(fespace->GetNE(), fespace->GetVDim(), d2q, e_vec, q_val);
+      return;
+   }
    const DofToQuad::Mode mode = DofToQuad::TENSOR;
    const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
    D2QValues(*fespace, &d2q, e_vec, q_val);
@@ -1321,6 +1422,13 @@ void QuadratureInterpolator::Derivatives(const Vector &e_vec,
    // q_layout == QVectorLayout::byVDIM
    if (fespace->GetNE() == 0) { return; }
    const IntegrationRule &ir = *IntRule;
+   if (!UsesTensorBasis(*fespace))
+   {
+      const DofToQuad::Mode mode = DofToQuad::FULL;
+      const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
+      D2QGradFull(*fespace, NULL, d2q, e_vec, q_der);
+      return;
+   }
    const DofToQuad::Mode mode = DofToQuad::TENSOR;
    const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
    D2QGrad(*fespace, &d2q, e_vec, q_der);
@@ -1343,6 +1451,13 @@ void QuadratureInterpolator::PhysDerivatives(const Vector &e_vec,
    const IntegrationRule &ir = *IntRule;
    const GeometricFactors *geom =
       mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+   if (!UsesTensorBasis(*fespace))
+   {
+      const DofToQuad::Mode mode = DofToQuad::FULL;
+      const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
+      D2QGradFull(*fespace, geom, d2q, e_vec, q_der);
+      return;
+   }
    const DofToQuad::Mode mode = DofToQuad::TENSOR;
    const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
    D2QPhysGrad(*fespace, geom, &d2q, e_vec, q_der);
@@ -13,6 +13,8 @@
 #include "gridfunc.hpp"
 #include "fespace.hpp"
 #include "../general/forall.hpp"
+#include "../general/perf_regions.hpp"
+#include "../linalg/sparsemat.hpp"
 
 namespace mfem
 {
@@ -30,6 +32,7 @@ L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
 
 void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("L2ElementRestriction::Mult");
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -49,6 +52,7 @@ void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 
 void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("L2ElementRestriction::MultTranspose");
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -66,6 +70,34 @@ void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
    });
 }
 
+int L2ElementRestriction::FillI(SparseMatrix &mat) const
+{
+   MFEM_VERIFY(vdim == 1, "vector spaces are not supported");
+   const int nd = ndof;
+   auto d_I = mat.WriteI();
+   MFEM_FORALL(i, ndofs + 1, d_I[i] = i*nd;);
+   return ndofs*nd;
+}
+
+void L2ElementRestriction::FillJAndData(const Vector &ea_data,
+                                        SparseMatrix &mat) const
+{
+   const int nd = ndof;
+   auto d_A = Reshape(ea_data.Read(), nd, nd, ne);
+   auto d_J = mat.WriteJ();
+   auto d_data = mat.WriteData();
+   MFEM_FORALL(i, ndofs,
+   {
+      const int e = i / nd;
+      const int r = i % nd;
+      for (int c = 0; c < nd; c++)
+      {
+         d_J[i*nd + c] = e*nd + c;
+         d_data[i*nd + c] = d_A(c, r, e);
+      }
+   });
+}
+
 ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
                                        ElementDofOrdering e_ordering)
    : fes(f),
@@ -148,6 +180,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("ElementRestriction::Mult");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -191,6 +224,7 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("ElementRestriction::MultTranspose");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -217,6 +251,61 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultBatch(int e0, int nb, const Vector &x,
+                                   Vector &y) const
+{
+   MFEM_ASSERT(e0 >= 0 && nb >= 0 && e0 + nb <= ne, "invalid batch");
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   y.SetSize(nd*vd*nb);
+   auto d_x = Reshape(x.HostRead(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.HostWrite(), nd, vd, nb);
+   const int *d_gatherMap = gatherMap.HostRead() + e0*nd;
+   for (int e = 0; e < nb; e++)
+   {
+      for (int d = 0; d < nd; d++)
+      {
+         const int gid = d_gatherMap[e*nd + d];
+         const bool plus = gid >= 0;
+         const int j = plus ? gid : -1-gid;
+         for (int c = 0; c < vd; ++c)
+         {
+            const double dofValue = d_x(t?c:j, t?j:c);
+            d_y(d, c, e) = plus ? dofValue : -dofValue;
+         }
+      }
+   }
+}
+
+void ElementRestriction::AddMultTransposeBatch(int e0, int nb,
+                                               const Vector &x,
+                                               Vector &y) const
+{
+   MFEM_ASSERT(e0 >= 0 && nb >= 0 && e0 + nb <= ne, "invalid batch");
+   MFEM_ASSERT(x.Size() == dof*vdim*nb, "invalid batch E-vector");
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.HostRead(), nd, vd, nb);
+   auto d_y = Reshape(y.HostReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   const int *d_gatherMap = gatherMap.HostRead() + e0*nd;
+   for (int e = 0; e < nb; e++)
+   {
+      for (int d = 0; d < nd; d++)
+      {
+         const int gid = d_gatherMap[e*nd + d];
+         const bool plus = gid >= 0;
+         const int j = plus ? gid : -1-gid;
+         for (int c = 0; c < vd; ++c)
+         {
+            const double dofValue = d_x(d, c, e);
+            d_y(t?c:j, t?j:c) += plus ? dofValue : -dofValue;
+         }
+      }
+   }
+}
+
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -281,6 +370,130 @@ void ElementRestriction::BooleanMask(Vector& y) const
    }
 }
 
+// Return the position, in the list 'i_lids' of the local ids of a global dof,
+// of the first entry whose element also contains the global dof with the list
+// 'j_lids', and set 'j_lid' to the smallest local id of the latter in that
+// element. The lists hold signed local ids, see ElementRestriction::indices.
+MFEM_HOST_DEVICE static inline
+int FirstCommonElement(const int *i_lids, const int i_n,
+                       const int *j_lids, const int j_n,
+                       const int nd, int &j_lid)
+{
+   for (int a = 0; a < i_n; a++)
+   {
+      const int e = ((i_lids[a] >= 0) ? i_lids[a] : -1-i_lids[a]) / nd;
+      int min_lid = -1;
+      for (int b = 0; b < j_n; b++)
+      {
+         const int lid = (j_lids[b] >= 0) ? j_lids[b] : -1-j_lids[b];
+         if (lid / nd == e && (min_lid < 0 || lid < min_lid)) { min_lid = lid; }
+      }
+      if (min_lid >= 0) { j_lid = min_lid; return a; }
+   }
+   return -1;
+}
+
+// The entry (i,j) of the matrix is generated by the global dof i, for the
+// first element of i that contains j, and the first local id of j in it. Each
+// row is thus processed independently, without atomics.
+
+int ElementRestriction::FillI(SparseMatrix &mat) const
+{
+   MFEM_VERIFY(vdim == 1, "vector spaces are not supported");
+   const int nd = dof;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_I = mat.WriteI();
+   MFEM_FORALL(i, ndofs,
+   {
+      const int *i_lids = d_indices + d_offsets[i];
+      const int i_n = d_offsets[i+1] - d_offsets[i];
+      int row_size = 0;
+      for (int a = 0; a < i_n; a++)
+      {
+         const int e = ((i_lids[a] >= 0) ? i_lids[a] : -1-i_lids[a]) / nd;
+         for (int d = 0; d < nd; d++)
+         {
+            const int lid = e*nd + d;
+            const int sj = d_gatherMap[lid];
+            const int j = (sj >= 0) ? sj : -1-sj;
+            int j_lid;
+            if (FirstCommonElement(i_lids, i_n, d_indices + d_offsets[j],
+                                   d_offsets[j+1] - d_offsets[j], nd,
+                                   j_lid) == a && j_lid == lid)
+            {
+               row_size++;
+            }
+         }
+      }
+      d_I[i] = row_size;
+   });
+   // Row sizes to row offsets
+   int *h_I = mat.HostReadWriteI();
+   int nnz = 0;
+   for (int i = 0; i < ndofs; i++)
+   {
+      const int row_size = h_I[i];
+      h_I[i] = nnz;
+      nnz += row_size;
+   }
+   h_I[ndofs] = nnz;
+   return nnz;
+}
+
+void ElementRestriction::FillJAndData(const Vector &ea_data,
+                                      SparseMatrix &mat) const
+{
+   const int nd = dof;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_A = Reshape(ea_data.Read(), nd, nd, ne);
+   auto d_I = mat.ReadI();
+   auto d_J = mat.WriteJ();
+   auto d_data = mat.WriteData();
+   MFEM_FORALL(i, ndofs,
+   {
+      const int *i_lids = d_indices + d_offsets[i];
+      const int i_n = d_offsets[i+1] - d_offsets[i];
+      int k = d_I[i];
+      for (int a = 0; a < i_n; a++)
+      {
+         const int e = ((i_lids[a] >= 0) ? i_lids[a] : -1-i_lids[a]) / nd;
+         for (int d = 0; d < nd; d++)
+         {
+            const int lid = e*nd + d;
+            const int sj = d_gatherMap[lid];
+            const int j = (sj >= 0) ? sj : -1-sj;
+            const int *j_lids = d_indices + d_offsets[j];
+            const int j_n = d_offsets[j+1] - d_offsets[j];
+            int j_lid;
+            if (FirstCommonElement(i_lids, i_n, j_lids, j_n, nd, j_lid) != a ||
+                j_lid != lid) { continue; }
+            // Sum the contributions of all the elements containing i and j
+            double value = 0.0;
+            for (int a2 = 0; a2 < i_n; a2++)
+            {
+               const bool i_plus = (i_lids[a2] >= 0);
+               const int il = i_plus ? i_lids[a2] : -1-i_lids[a2];
+               for (int b = 0; b < j_n; b++)
+               {
+                  const bool j_plus = (j_lids[b] >= 0);
+                  const int jl = j_plus ? j_lids[b] : -1-j_lids[b];
+                  if (jl / nd != il / nd) { continue; }
+                  const double v = d_A(jl % nd, il % nd, il / nd);
+                  value += (i_plus == j_plus) ? v : -v;
+               }
+            }
+            d_J[k] = j;
+            d_data[k] = value;
+            k++;
+         }
+      }
+   });
+}
+
 /// Return the face degrees of freedom returned in Lexicographic order.
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap)
@@ -19,6 +19,7 @@ namespace mfem
 {
 
 class FiniteElementSpace;
+class SparseMatrix;
 enum class ElementDofOrdering;
 
 /** An enum type to specify if only e1 value is requested (SingleValued) or both
@@ -52,6 +53,20 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Gather into @a y the entries of the @a nb elements [@a e0,
+       @a e0 + @a nb) of the E-vector of @a x, i.e. the corresponding rows of
+       Mult(). */
+   /** The result has size vdim*dof*nb and is computed on the host. Together
+       with AddMultTransposeBatch(), this allows the element kernels to be
+       applied to small batches that stay in cache, without forming the full
+       E-vectors, see PABilinearFormExtension::Mult(). */
+   void MultBatch(int e0, int nb, const Vector &x, Vector &y) const;
+
+   /** @brief Add to the L-vector @a y the transpose of MultBatch() applied to
+       the batch E-vector @a x, computed sequentially on the host. */
+   void AddMultTransposeBatch(int e0, int nb, const Vector &x,
+                              Vector &y) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -59,6 +74,20 @@ public:
        emulate SetSubVector and its transpose on GPUs. This method is running on
        the host, since the `processed` array requires a large shared memory. */
    void BooleanMask(Vector& y) const;
+
+   /** @brief Fill the row offsets #I of the matrix @a mat, of size
+       ndofs x ndofs, with the sparsity pattern of the element-dof couplings,
+       and return its number of nonzero entries. */
+   /** The rows are computed independently with MFEM_FORALL, so that the
+       pattern is built on the device. Only scalar spaces are supported. */
+   int FillI(SparseMatrix &mat) const;
+
+   /** @brief Fill the column indices and the values of @a mat, after FillI()
+       and the allocation of its J and data arrays, by summing the element
+       matrices @a ea_data, as computed by BilinearFormIntegrator::AssembleEA().
+    */
+   /** The column indices in each row are not sorted. */
+   void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
@@ -77,6 +106,11 @@ public:
    L2ElementRestriction(const FiniteElementSpace&);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Block-diagonal version of ElementRestriction::FillI().
+   int FillI(SparseMatrix &mat) const;
+   /// Block-diagonal version of ElementRestriction::FillJAndData().
+   void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
 };
 
 /// Operator that extracts Face degrees of freedom.
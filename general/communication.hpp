@@ -20,6 +20,7 @@
 #include "table.hpp"
 #include "sets.hpp"
 #include "globals.hpp"
+#include "perf_regions.hpp"
 #include <mpi.h>
 
 
@@ -28,7 +29,9 @@ namespace mfem
 
 /** @brief A simple convenience class that calls MPI_Init() at construction and
     MPI_Finalize() at destruction. It also provides easy access to
-    MPI_COMM_WORLD's rank and size. */
+    MPI_COMM_WORLD's rank and size. Before MPI_Finalize(), the destructor
+    prints the report of PerfRegions, if requested with
+    PerfRegions::ReportAtExit(). */
 class MPI_Session
 {
 protected:
@@ -38,7 +41,11 @@ public:
    MPI_Session() { MPI_Init(NULL, NULL); GetRankAndSize(); }
    MPI_Session(int &argc, char **&argv)
    { MPI_Init(&argc, &argv); GetRankAndSize(); }
-   ~MPI_Session() { MPI_Finalize(); }
+   ~MPI_Session()
+   {
+      PerfRegions::Finalize(MPI_COMM_WORLD);
+      MPI_Finalize();
+   }
    /// Return MPI_COMM_WORLD's rank.
    int WorldRank() const { return world_rank; }
    /// Return MPI_COMM_WORLD's size.
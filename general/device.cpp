@@ -40,7 +40,7 @@ static const Backend::Id backend_list[Backend::NUM_BACKENDS] =
 {
    Backend::CEED_CUDA, Backend::OCCA_CUDA, Backend::RAJA_CUDA, Backend::CUDA,
    Backend::HIP, Backend::DEBUG,
-   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP,
+   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP, Backend::THREADS,
    Backend::CEED_CPU, Backend::OCCA_CPU, Backend::RAJA_CPU, Backend::CPU
 };
 
@@ -49,7 +49,7 @@ static const char *backend_name[Backend::NUM_BACKENDS] =
 {
    "ceed-cuda", "occa-cuda", "raja-cuda", "cuda",
    "hip", "debug",
-   "occa-omp", "raja-omp", "omp",
+   "occa-omp", "raja-omp", "omp", "threads",
    "ceed-cpu", "occa-cpu", "raja-cpu", "cpu"
 };
 
@@ -101,6 +101,15 @@ Device::Device() : mode(Device::SEQUENTIAL),
          // Device::UpdateMemoryTypeAndClass().
          device_mem_type = MemoryType::HOST_UMPIRE;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         // Note: device_mem_type will be set to MemoryType::DEVICE_POOL only
+         // when an actual device is configured -- this is done later in
+         // Device::UpdateMemoryTypeAndClass().
+         device_mem_type = MemoryType::HOST_POOL;
+      }
       else if (mem_backend == "debug")
       {
          mem_host_env = true;
@@ -233,6 +242,20 @@ void Device::Configure(const std::string &device, const int dev)
    destroy_mm = true;
 }
 
+void Device::SetHostMemoryType(MemoryType h_mt)
+{
+   MFEM_VERIFY(!device_env && !IsConfigured(),
+               "the host MemoryType must be set before configuring the Device");
+   MFEM_VERIFY(IsHostMemory(h_mt) && h_mt != MemoryType::MANAGED,
+               "invalid host MemoryType: " << MemoryTypeName[(int)h_mt]);
+   mem_host_env = true;
+   Get().host_mem_type = h_mt;
+   // The device MemoryType is set in Device::UpdateMemoryTypeAndClass(), when
+   // a device backend is configured.
+   Get().device_mem_type = h_mt;
+   mm.Configure(h_mt, h_mt);
+}
+
 void Device::Print(std::ostream &out)
 {
    out << "Device configuration: ";
@@ -290,6 +313,9 @@ void Device::UpdateMemoryTypeAndClass()
                case MemoryType::HOST_DEBUG:
                   device_mem_type = MemoryType::DEVICE_DEBUG;
                   break;
+               case MemoryType::HOST_POOL:
+                  device_mem_type = MemoryType::DEVICE_POOL;
+                  break;
                default:
                   device_mem_type = MemoryType::DEVICE;
             }
@@ -446,6 +472,12 @@ static void CeedDeviceSetup(const char* ceed_spec)
 #endif
 }
 
+static void ThreadsDeviceSetup(const char *option)
+{
+   // The option, if given, is the number of threads, e.g. 'threads:8'.
+   SetNumThreads(option ? atoi(option) : 0);
+}
+
 void Device::Setup(const int device)
 {
    MFEM_VERIFY(ngpu == -1, "the mfem::Device is already configured!");
@@ -504,6 +536,7 @@ void Device::Setup(const int device)
          CeedDeviceSetup(device_option);
       }
    }
+   if (Allows(Backend::THREADS)) { ThreadsDeviceSetup(device_option); }
    if (Allows(Backend::DEBUG)) { ngpu = 1; }
 }
 
@@ -65,7 +65,11 @@ struct Backend
           while a device is in use. It allows to test the "device" code-path
           (using separate host/device memory pools and host <-> device
           transfers) without any GPU hardware. */
-      DEBUG = 1 << 12
+      DEBUG = 1 << 12,
+      /** @brief [host] Native threads backend: the MFEM_FORALL loops are run by
+          a persistent work-stealing thread pool, or by the executor set with
+          SetThreadExecutor(), see general/threads.hpp. */
+      THREADS = 1 << 13
    };
 
    /** @brief Additional useful constants. For example, the *_MASK constants can
@@ -73,7 +77,7 @@ struct Backend
    enum
    {
       /// Number of backends: from (1 << 0) to (1 << (NUM_BACKENDS-1)).
-      NUM_BACKENDS = 13,
+      NUM_BACKENDS = 14,
 
       /// Biwise-OR of all CPU backends
       CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU,
@@ -83,6 +87,8 @@ struct Backend
       HIP_MASK = HIP,
       /// Biwise-OR of all OpenMP backends
       OMP_MASK = OMP | RAJA_OMP | OCCA_OMP,
+      /// Bitwise-OR of all native threads backends
+      THREADS_MASK = THREADS,
       /// Bitwise-OR of all CEED backends
       CEED_MASK = CEED_CPU | CEED_CUDA,
       /// Biwise-OR of all device backends
@@ -197,7 +203,7 @@ public:
        * The 'cpu' backend is always enabled with lowest priority.
        * The current backend priority from highest to lowest is:
          'ceed-cuda', 'occa-cuda', 'raja-cuda', 'cuda', 'hip', 'debug',
-         'occa-omp', 'raja-omp', 'omp',
+         'occa-omp', 'raja-omp', 'omp', 'threads',
          'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu'.
        * Multiple backends can be configured at the same time.
        * Only one 'occa-*' backend can be configured at a time.
@@ -209,9 +215,20 @@ public:
          and evaluation of the operator and enables the 'cuda' backend to avoid
          transfer between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The 'threads' backend accepts the number of threads as an option, e.g.
+         'threads:8'; by default, all hardware threads are used.
    */
    void Configure(const std::string &device, const int dev = 0);
 
+   /** @brief Set the host MemoryType used by most MFEM classes, e.g.
+       MemoryType::HOST_POOL. This method must be called before the Device is
+       configured. */
+   /** The same can be achieved by setting the environment variable
+       MFEM_MEMORY, e.g. to 'pool'. When a device backend is configured, the
+       device MemoryType is chosen accordingly, e.g. MemoryType::DEVICE_POOL
+       for MemoryType::HOST_POOL. */
+   static void SetHostMemoryType(MemoryType h_mt);
+
    /// Print the configuration of the MFEM virtual device object.
    void Print(std::ostream &out = mfem::out);
 
@@ -19,6 +19,7 @@
 #include "occa.hpp"
 #include "device.hpp"
 #include "mem_manager.hpp"
+#include "threads.hpp"
 #include "../linalg/dtensor.hpp"
 
 #ifdef MFEM_USE_RAJA
@@ -35,6 +36,10 @@ namespace mfem
 const int MAX_D1D = 14;
 const int MAX_Q1D = 14;
 
+// Maximum number of dofs per element in the kernels for non-tensor elements,
+// e.g. simplices, which use the DofToQuad::FULL maps.
+const int MAX_ND = 84;
+
 // MFEM pragma macros that can be used inside MFEM_FORALL macros.
 #define MFEM_PRAGMA(X) _Pragma(#X)
 
@@ -46,7 +51,8 @@ const int MAX_Q1D = 14;
 #endif
 
 // Implementation of MFEM's "parallel for" (forall) device/host kernel
-// interfaces supporting RAJA, CUDA, OpenMP, and sequential backends.
+// interfaces supporting RAJA, CUDA, OpenMP, native threads, and sequential
+// backends.
 
 // The MFEM_FORALL wrapper
 #define MFEM_FORALL(i,N,...)                             \
@@ -95,6 +101,23 @@ void OmpWrap(const int N, HBODY &&h_body)
 }
 
 
+/// Native threads backend
+/** The 1D loops are split in chunks of at least 1024 iterations, while the
+    element loops of MFEM_FORALL_2D and MFEM_FORALL_3D, where each iteration
+    processes a whole element, are split in chunks of at least one iteration. */
+template <const int DIM, typename HBODY>
+void ThreadsWrap(const int N, HBODY &&h_body)
+{
+   ThreadExecutor &exec = GetThreadExecutor();
+   const int grain = ThreadsGrainSize(N, exec.NumThreads(),
+                                      (DIM == 1) ? 1024 : 1);
+   exec.ParallelFor(N, grain, [&](int begin, int end)
+   {
+      for (int k = begin; k < end; k++) { h_body(k); }
+   });
+}
+
+
 /// RAJA Cuda backend
 #if defined(MFEM_USE_RAJA) && defined(RAJA_ENABLE_CUDA)
 
@@ -365,6 +388,10 @@ inline void ForallWrap(const bool use_dev, const int N,
    if (Device::Allows(Backend::OMP_MASK)) { return OmpWrap(N, h_body); }
 #endif
 
+   // Handle all allowed native threads backends
+   if (Device::Allows(Backend::THREADS_MASK))
+   { return ThreadsWrap<DIM>(N, h_body); }
+
 #ifdef MFEM_USE_RAJA
    // Handle all allowed CPU backends except Backend::CPU
    if (Device::Allows(Backend::CPU_MASK & ~Backend::CPU))
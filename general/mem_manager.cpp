@@ -16,6 +16,9 @@
 #include <cstring> // std::memcpy, std::memcmp
 #include <unordered_map>
 #include <algorithm> // std::max
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 // Uncomment to try _WIN32 platform
 //#define _WIN32
@@ -72,10 +75,12 @@ MemoryType MemoryManager::GetDualMemoryType_(MemoryType mt)
       case MemoryType::HOST_64:        return MemoryType::DEVICE;
       case MemoryType::HOST_DEBUG:     return MemoryType::DEVICE_DEBUG;
       case MemoryType::HOST_UMPIRE:    return MemoryType::DEVICE_UMPIRE;
+      case MemoryType::HOST_POOL:      return MemoryType::DEVICE_POOL;
       case MemoryType::MANAGED:        return MemoryType::MANAGED;
       case MemoryType::DEVICE:         return MemoryType::HOST;
       case MemoryType::DEVICE_DEBUG:   return MemoryType::HOST_DEBUG;
       case MemoryType::DEVICE_UMPIRE:  return MemoryType::HOST_UMPIRE;
+      case MemoryType::DEVICE_POOL:    return MemoryType::HOST_POOL;
       default: mfem_error("Unknown memory type!");
    }
    MFEM_VERIFY(false,"");
@@ -89,6 +94,7 @@ static void MFEM_VERIFY_TYPES(const MemoryType h_mt, const MemoryType d_mt)
    const bool sync =
       (h_mt == MemoryType::HOST_UMPIRE && d_mt == MemoryType::DEVICE_UMPIRE) ||
       (h_mt == MemoryType::HOST_DEBUG && d_mt == MemoryType::DEVICE_DEBUG) ||
+      (h_mt == MemoryType::HOST_POOL && d_mt == MemoryType::DEVICE_POOL) ||
       (h_mt == MemoryType::MANAGED && d_mt == MemoryType::MANAGED) ||
       (h_mt == MemoryType::HOST_64 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_32 && d_mt == MemoryType::DEVICE) ||
@@ -227,6 +233,247 @@ public:
    void Dealloc(void *ptr) { mfem_aligned_free(ptr); }
 };
 
+class MemoryPool;
+
+/// Blocks of a MemoryPool cached by one thread
+struct MemoryPoolCache
+{
+   static constexpr int max_blocks = 4;
+   MemoryPool *pool = nullptr;
+   std::vector<void*> blocks[64];
+   ~MemoryPoolCache();
+};
+
+/// Size-class memory pool, used by the HOST_POOL and DEVICE_POOL spaces
+/** The requested sizes are rounded up to size classes with four classes per
+    power of two, from 64 bytes to 1 GB; larger requests bypass the pool. The
+    freed blocks are kept in per-class free lists, shared by all threads, and
+    the small blocks also in thread-local caches, which are accessed without
+    locking. The blocks are returned to the system by Release() or when the
+    pool is destroyed. */
+class MemoryPool
+{
+public:
+   typedef void (*SysAlloc)(void **ptr, size_t bytes);
+   typedef void (*SysFree)(void *ptr);
+
+private:
+   static constexpr int min_log2 = 6, max_log2 = 30;
+   static constexpr int num_classes = 1 + 4*(max_log2 - min_log2);
+   // Only the classes of at most 256 KB use the thread-local caches
+   static constexpr int max_cached_class = 4*(18 - min_log2);
+
+   const int id; // index of the thread-local cache
+   const SysAlloc sys_alloc;
+   const SysFree sys_free;
+   std::mutex mtx;
+   std::vector<void*> free_blocks[num_classes];
+   std::vector<MemoryPoolCache*> caches;
+   std::atomic<size_t> hits, misses, in_use, reserved, peak;
+
+   static_assert(max_cached_class < 64, "increase MemoryPoolCache::blocks");
+
+   /// Return the size class of @a bytes and its block size, or -1
+   static int SizeClass(size_t bytes, size_t &block_bytes)
+   {
+      if (bytes <= ((size_t)1 << min_log2))
+      {
+         block_bytes = (size_t)1 << min_log2;
+         return 0;
+      }
+      // The last classes are in the range (2^(max_log2-1), 2^max_log2]
+      int e = min_log2;
+      while (e < max_log2 - 1 && bytes > ((size_t)2 << e)) { e++; }
+      if (bytes > ((size_t)2 << e)) { return -1; }
+      // Now, 2^e < bytes <= 2^(e+1): use four classes in this range
+      const size_t step = (size_t)1 << (e - 2);
+      const int q = (int)((bytes - 1 - ((size_t)1 << e)) / step);
+      block_bytes = ((size_t)1 << e) + (q + 1)*step;
+      return 1 + 4*(e - min_log2) + q;
+   }
+
+   MemoryPoolCache &Cache();
+
+   void NewBlock(void **ptr, size_t bytes)
+   {
+      sys_alloc(ptr, bytes);
+      misses++;
+      const size_t r = (reserved += bytes);
+      size_t p = peak.load();
+      while (r > p && !peak.compare_exchange_weak(p, r)) { }
+   }
+
+   void FreeBlock(void *ptr, size_t bytes)
+   {
+      sys_free(ptr);
+      reserved -= bytes;
+   }
+
+public:
+   MemoryPool(int id, SysAlloc sys_alloc, SysFree sys_free)
+      : id(id), sys_alloc(sys_alloc), sys_free(sys_free),
+        hits(0), misses(0), in_use(0), reserved(0), peak(0) { }
+
+   void *Alloc(size_t bytes)
+   {
+      size_t block_bytes;
+      const int c = SizeClass(bytes, block_bytes);
+      void *ptr = nullptr;
+      if (c < 0)
+      {
+         NewBlock(&ptr, bytes);
+         in_use += bytes;
+         return ptr;
+      }
+      in_use += block_bytes;
+      if (c <= max_cached_class)
+      {
+         std::vector<void*> &cached = Cache().blocks[c];
+         if (!cached.empty())
+         {
+            ptr = cached.back();
+            cached.pop_back();
+            hits++;
+            return ptr;
+         }
+      }
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         if (!free_blocks[c].empty())
+         {
+            ptr = free_blocks[c].back();
+            free_blocks[c].pop_back();
+         }
+      }
+      if (ptr) { hits++; }
+      else { NewBlock(&ptr, block_bytes); }
+      return ptr;
+   }
+
+   void Dealloc(void *ptr, size_t bytes)
+   {
+      size_t block_bytes;
+      const int c = SizeClass(bytes, block_bytes);
+      if (c < 0)
+      {
+         in_use -= bytes;
+         FreeBlock(ptr, bytes);
+         return;
+      }
+      in_use -= block_bytes;
+      if (c <= max_cached_class)
+      {
+         std::vector<void*> &cached = Cache().blocks[c];
+         if (cached.size() < MemoryPoolCache::max_blocks)
+         {
+            cached.push_back(ptr);
+            return;
+         }
+      }
+      std::lock_guard<std::mutex> lock(mtx);
+      free_blocks[c].push_back(ptr);
+   }
+
+   /// Free the cached blocks of the calling thread and of the free lists
+   void Release()
+   {
+      MemoryPoolCache &cache = Cache();
+      std::lock_guard<std::mutex> lock(mtx);
+      for (int c = 0; c < num_classes; c++)
+      {
+         const size_t block_bytes = BlockBytes(c);
+         if (c <= max_cached_class)
+         {
+            for (void *ptr : cache.blocks[c]) { FreeBlock(ptr, block_bytes); }
+            cache.blocks[c].clear();
+         }
+         for (void *ptr : free_blocks[c]) { FreeBlock(ptr, block_bytes); }
+         free_blocks[c].clear();
+      }
+   }
+
+   /// Move the blocks of a thread-local cache to the free lists
+   void Detach(MemoryPoolCache *cache)
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      for (int c = 0; c <= max_cached_class; c++)
+      {
+         free_blocks[c].insert(free_blocks[c].end(),
+                               cache->blocks[c].begin(),
+                               cache->blocks[c].end());
+         cache->blocks[c].clear();
+      }
+      caches.erase(std::find(caches.begin(), caches.end(), cache));
+      cache->pool = nullptr;
+   }
+
+   MemoryPoolStats Stats() const
+   {
+      MemoryPoolStats stats;
+      stats.hits = hits;
+      stats.misses = misses;
+      stats.in_use = in_use;
+      stats.reserved = reserved;
+      stats.peak = peak;
+      return stats;
+   }
+
+   ~MemoryPool()
+   {
+      // The pool is destroyed by the MemoryManager, when no other thread is
+      // expected to use it: take back the blocks of all thread-local caches.
+      while (!caches.empty()) { Detach(caches.back()); }
+      for (int c = 0; c < num_classes; c++)
+      {
+         for (void *ptr : free_blocks[c]) { sys_free(ptr); }
+      }
+   }
+
+private:
+   /// Return the block size of the class @a c
+   static size_t BlockBytes(int c)
+   {
+      if (c == 0) { return (size_t)1 << min_log2; }
+      const int e = min_log2 + (c - 1)/4;
+      const int q = (c - 1) % 4;
+      return ((size_t)1 << e) + (q + 1)*((size_t)1 << (e - 2));
+   }
+};
+
+// One thread-local cache per pool: HOST_POOL and DEVICE_POOL.
+static thread_local MemoryPoolCache pool_caches[2];
+
+inline MemoryPoolCache &MemoryPool::Cache()
+{
+   MemoryPoolCache &cache = pool_caches[id];
+   if (cache.pool != this)
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      cache.pool = this;
+      caches.push_back(&cache);
+   }
+   return cache;
+}
+
+MemoryPoolCache::~MemoryPoolCache() { if (pool) { pool->Detach(this); } }
+
+static void PoolHostSysAlloc(void **ptr, size_t bytes)
+{ if (mfem_memalign(ptr, 64, bytes) != 0) { throw ::std::bad_alloc(); } }
+
+static void PoolHostSysFree(void *ptr) { mfem_aligned_free(ptr); }
+
+/// The pooled host memory space, with 64 bytes aligned blocks
+class PoolHostMemorySpace : public HostMemorySpace
+{
+   MemoryPool pool;
+public:
+   PoolHostMemorySpace()
+      : HostMemorySpace(), pool(0, PoolHostSysAlloc, PoolHostSysFree) { }
+   void Alloc(void **ptr, size_t bytes) { *ptr = pool.Alloc(bytes); }
+   void Dealloc(void *ptr) { pool.Dealloc(ptr, maps->memories.at(ptr).bytes); }
+   MemoryPool &Pool() { return pool; }
+};
+
 #ifndef _WIN32
 static uintptr_t pagesize = 0;
 static uintptr_t pagemask = 0;
@@ -415,6 +662,41 @@ public:
    { return HipMemcpyDtoH(dst, src, bytes); }
 };
 
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+static void PoolDeviceSysAlloc(void **ptr, size_t bytes)
+{
+#ifdef MFEM_USE_CUDA
+   CuMemAlloc(ptr, bytes);
+#else
+   HipMemAlloc(ptr, bytes);
+#endif
+}
+
+static void PoolDeviceSysFree(void *ptr)
+{
+#ifdef MFEM_USE_CUDA
+   CuMemFree(ptr);
+#else
+   HipMemFree(ptr);
+#endif
+}
+
+/// The pooled CUDA or HIP device memory space
+#ifdef MFEM_USE_CUDA
+class PoolDeviceMemorySpace : public CudaDeviceMemorySpace
+#else
+class PoolDeviceMemorySpace : public HipDeviceMemorySpace
+#endif
+{
+   MemoryPool pool;
+public:
+   PoolDeviceMemorySpace() : pool(1, PoolDeviceSysAlloc, PoolDeviceSysFree) { }
+   void Alloc(Memory &base) { base.d_ptr = pool.Alloc(base.bytes); }
+   void Dealloc(Memory &base) { pool.Dealloc(base.d_ptr, base.bytes); }
+   MemoryPool &Pool() { return pool; }
+};
+#endif
+
 /// The UVM device memory space.
 class UvmCudaMemorySpace : public DeviceMemorySpace
 {
@@ -569,6 +851,7 @@ public:
       // HOST_DEBUG is delayed, as it reroutes signals
       host[static_cast<int>(MT::HOST_DEBUG)] = nullptr;
       host[static_cast<int>(MT::HOST_UMPIRE)] = new UmpireHostMemorySpace();
+      host[static_cast<int>(MT::HOST_POOL)] = new PoolHostMemorySpace();
       host[static_cast<int>(MT::MANAGED)] = new UvmHostMemorySpace();
 
       // Filling the device memory backends, shifting with the device size
@@ -578,6 +861,7 @@ public:
       device[static_cast<int>(MemoryType::DEVICE)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_DEBUG)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_UMPIRE)-shift] = nullptr;
+      device[static_cast<int>(MT::DEVICE_POOL)-shift] = nullptr;
    }
 
    HostMemorySpace* Host(const MemoryType mt)
@@ -621,6 +905,15 @@ private:
       {
          case MT::DEVICE_UMPIRE: return new UmpireDeviceMemorySpace();
          case MT::DEVICE_DEBUG: return new MmuDeviceMemorySpace();
+         case MT::DEVICE_POOL:
+         {
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+            return new PoolDeviceMemorySpace();
+#else
+            MFEM_ABORT("No device memory controller!");
+            break;
+#endif
+         }
          case MT::DEVICE:
          {
 #if defined(MFEM_USE_CUDA)
@@ -783,6 +1076,7 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
          MFEM_VERIFY(d_mt == MemoryType::DEVICE ||
                      d_mt == MemoryType::DEVICE_DEBUG ||
                      d_mt == MemoryType::DEVICE_UMPIRE ||
+                     d_mt == MemoryType::DEVICE_POOL ||
                      d_mt == MemoryType::MANAGED,"");
          return true;
       }
@@ -1295,6 +1589,51 @@ void MemoryManager::Destroy()
    exists = false;
 }
 
+static internal::MemoryPool &GetPool(const MemoryType mt)
+{
+   if (mt == MemoryType::HOST_POOL)
+   {
+      return static_cast<internal::PoolHostMemorySpace*>(
+                ctrl->Host(mt))->Pool();
+   }
+   MFEM_VERIFY(mt == MemoryType::DEVICE_POOL,
+               "MemoryType " << MemoryTypeName[(int)mt] << " is not pooled!");
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+   return static_cast<internal::PoolDeviceMemorySpace*>(
+             ctrl->Device(mt))->Pool();
+#else
+   MFEM_ABORT("DEVICE_POOL requires MFEM built with CUDA or HIP!");
+   return GetPool(MemoryType::HOST_POOL);
+#endif
+}
+
+void *MemoryManager::NewHostPool_(size_t bytes)
+{
+   MFEM_ASSERT(exists, "Internal error!");
+   // The block is registered only when it is first used on the device, see
+   // Memory<T>::Read(); until then, Memory<T>::Delete() frees it with its
+   // capacity, so that the allocation does not touch the memory maps.
+   return GetPool(MemoryType::HOST_POOL).Alloc(bytes);
+}
+
+void MemoryManager::DeleteHostPool_(void *h_ptr, size_t bytes)
+{
+   if (!mm.exists) { return; }
+   GetPool(MemoryType::HOST_POOL).Dealloc(h_ptr, bytes);
+}
+
+MemoryPoolStats MemoryManager::GetPoolStats(const MemoryType mt)
+{
+   MFEM_VERIFY(exists, "MemoryManager has been destroyed!");
+   return GetPool(mt).Stats();
+}
+
+void MemoryManager::ReleasePool(const MemoryType mt)
+{
+   MFEM_VERIFY(exists, "MemoryManager has been destroyed!");
+   GetPool(mt).Release();
+}
+
 void MemoryManager::RegisterCheck(void *ptr)
 {
    if (ptr != NULL)
@@ -1390,7 +1729,7 @@ MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
 
 const char *MemoryTypeName[MemoryTypeSize] =
 {
-   "host-std", "host-32", "host-64", "host-debug", "host-umpire",
+   "host-std", "host-32", "host-64", "host-debug", "host-umpire", "host-pool",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
@@ -1403,11 +1742,14 @@ const char *MemoryTypeName[MemoryTypeSize] =
 #endif
    "device-debug",
 #if defined(MFEM_USE_CUDA)
-   "cuda-umpire"
+   "cuda-umpire",
+   "cuda-pool"
 #elif defined(MFEM_USE_HIP)
-   "hip-umpire"
+   "hip-umpire",
+   "hip-pool"
 #else
-   "device-umpire"
+   "device-umpire",
+   "device-pool"
 #endif
 };
 
@@ -32,12 +32,16 @@ enum class MemoryType
    HOST_64,        ///< Host memory; aligned at 64 bytes
    HOST_DEBUG,     ///< Host memory; allocated from a "host-debug" pool
    HOST_UMPIRE,    ///< Host memory; using Umpire
+   HOST_POOL,      /**< Host memory; allocated from a size-class pool, see
+                        MemoryManager::GetPoolStats() */
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
                         and *Free */
    DEVICE,         ///< Device memory; using CUDA or HIP *Malloc and *Free
    DEVICE_DEBUG,   /**< Pseudo-device memory; allocated on host from a
                         "device-debug" pool */
    DEVICE_UMPIRE,  ///< Device memory; using Umpire
+   DEVICE_POOL,    /**< Device memory; allocated from a size-class pool on top
+                        of CUDA or HIP *Malloc and *Free */
    SIZE            ///< Number of host and device memory types
 };
 
@@ -58,10 +62,11 @@ extern const char *MemoryTypeName[MemoryTypeSize];
 enum class MemoryClass
 {
    HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, MANAGED } */
+                                 HOST_UMPIRE, HOST_POOL, MANAGED } */
    HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
    HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
-   DEVICE,  ///< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, MANAGED }
+   DEVICE,  /**< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE,
+                                 DEVICE_POOL, MANAGED } */
    MANAGED  ///< Memory types: { MANAGED }
 };
 
@@ -96,7 +101,7 @@ MemoryClass operator*(MemoryClass mc1, MemoryClass mc2);
 
     A Memory object stores up to two different pointers: one host pointer (with
     MemoryType from MemoryClass::HOST) and one device pointer (currently one of
-    MemoryType: DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE or MANAGED).
+    MemoryType: DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, DEVICE_POOL or MANAGED).
 
     A Memory object can hold (wrap) an externally allocated pointer with any
     given MemoryType.
@@ -293,6 +298,7 @@ public:
           - MANAGED => MANAGED,
           - HOST_DEBUG => DEVICE_DEBUG,
           - HOST_UMPIRE => DEVICE_UMPIRE,
+          - HOST_POOL => DEVICE_POOL,
           - HOST, HOST_32, HOST_64 => DEVICE.
 
        The parameter @a own determines whether both @a h_ptr and @a d_ptr will
@@ -471,6 +477,17 @@ private:
 };
 
 
+/// Statistics of the pools used by MemoryType::HOST_POOL and DEVICE_POOL.
+struct MemoryPoolStats
+{
+   std::size_t hits;     ///< Allocations served with a cached block
+   std::size_t misses;   ///< Allocations that required a new block
+   std::size_t in_use;   ///< Bytes in the blocks currently allocated
+   std::size_t reserved; ///< Bytes obtained from the system and not released
+   std::size_t peak;     ///< Maximum value reached by @a reserved
+};
+
+
 /** The MFEM memory manager class. Host-side pointers are inserted into this
     manager which keeps track of the associated device pointer, and where the
     data currently resides. */
@@ -508,6 +525,12 @@ private: // Static methods used by the Memory<T> class
    /// memory type, e.g. CUDA (mt will not be HOST).
    static void *New_(void *h_tmp, size_t bytes, MemoryType mt, unsigned &flags);
 
+   /// Allocate host memory from the HOST_POOL without registering it.
+   static void *NewHostPool_(size_t bytes);
+
+   /// Return unregistered host memory of @a bytes to the HOST_POOL.
+   static void DeleteHostPool_(void *h_ptr, size_t bytes);
+
    /// Register an external pointer of the given MemoryType.
    /// Return the host pointer.
    static void *Register_(void *ptr, void *h_ptr, size_t bytes, MemoryType mt,
@@ -652,6 +675,16 @@ public:
    /// returning the number of printed pointers
    int PrintAliases(std::ostream &out = mfem::out);
 
+   /** @brief Return the statistics of the pool used by the MemoryType @a mt,
+       which must be HOST_POOL or DEVICE_POOL. */
+   MemoryPoolStats GetPoolStats(const MemoryType mt);
+
+   /** @brief Return to the system the blocks cached by the pool of the
+       MemoryType @a mt, which must be HOST_POOL or DEVICE_POOL. */
+   /** Only the blocks of the global free lists and of the thread-local cache
+       of the calling thread are released. */
+   void ReleasePool(const MemoryType mt);
+
    static MemoryType GetHostMemoryType() { return host_mem_type; }
    static MemoryType GetDeviceMemoryType() { return device_mem_type; }
 };
@@ -684,6 +717,8 @@ inline void Memory<T>::New(int size)
    flags = OWNS_HOST | VALID_HOST;
    h_mt = MemoryManager::host_mem_type;
    h_ptr = (h_mt == MemoryType::HOST) ? Alloc<new_align_bytes>::New(size) :
+           (h_mt == MemoryType::HOST_POOL) ?
+           (T*)MemoryManager::NewHostPool_(size*sizeof(T)) :
            (T*)MemoryManager::New_(nullptr, size*sizeof(T), h_mt, flags);
 }
 
@@ -693,11 +728,14 @@ inline void Memory<T>::New(int size, MemoryType mt)
    capacity = size;
    const size_t bytes = size*sizeof(T);
    const bool mt_host = mt == MemoryType::HOST;
-   if (mt_host) { flags = OWNS_HOST | VALID_HOST; }
+   const bool mt_pool = mt == MemoryType::HOST_POOL;
+   if (mt_host || mt_pool) { flags = OWNS_HOST | VALID_HOST; }
    h_mt = IsHostMemory(mt) ? mt : MemoryManager::GetDualMemoryType_(mt);
    T *h_tmp = (h_mt == MemoryType::HOST) ?
               Alloc<new_align_bytes>::New(size) : nullptr;
-   h_ptr = (mt_host) ? h_tmp : (T*)MemoryManager::New_(h_tmp, bytes, mt, flags);
+   h_ptr = (mt_host) ? h_tmp :
+           (mt_pool) ? (T*)MemoryManager::NewHostPool_(bytes) :
+           (T*)MemoryManager::New_(h_tmp, bytes, mt, flags);
 }
 
 template <typename T>
@@ -777,6 +815,13 @@ inline void Memory<T>::Delete()
    const bool mt_host = h_mt == MemoryType::HOST;
    const bool std_delete = !registered && mt_host;
 
+   if (!registered && h_mt == MemoryType::HOST_POOL)
+   {
+      if (flags & OWNS_HOST)
+      { MemoryManager::DeleteHostPool_((void*)h_ptr, capacity*sizeof(T)); }
+      return;
+   }
+
    if (std_delete ||
        MemoryManager::Delete_((void*)h_ptr, h_mt, flags) == MemoryType::HOST)
    {
@@ -0,0 +1,386 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "perf_regions.hpp"
+#include "error.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+typedef std::chrono::steady_clock PerfClock;
+
+// Node of the tree of regions.
+struct PerfRegion
+{
+   std::string name;
+   const char *key; // pointer passed to Begin(), for fast lookup
+   PerfRegion *parent;
+   std::vector<PerfRegion*> children;
+
+   long long calls;
+   double time, flops, bytes;
+   PerfClock::time_point start;
+
+   PerfRegion(const char *name_, PerfRegion *parent_)
+      : name(name_), key(name_), parent(parent_), calls(0),
+        time(0.0), flops(0.0), bytes(0.0) { }
+
+   PerfRegion *Child(const char *name_)
+   {
+      for (PerfRegion *c : children)
+      {
+         if (c->key == name_) { return c; }
+      }
+      for (PerfRegion *c : children)
+      {
+         if (c->name == name_) { c->key = name_; return c; }
+      }
+      children.push_back(new PerfRegion(name_, this));
+      return children.back();
+   }
+
+   // Lookup by name only, for the trees built from gathered paths.
+   PerfRegion *Child(const std::string &name_)
+   {
+      for (PerfRegion *c : children)
+      {
+         if (c->name == name_) { return c; }
+      }
+      children.push_back(new PerfRegion(name_.c_str(), this));
+      children.back()->key = NULL;
+      return children.back();
+   }
+
+   void Clear()
+   {
+      for (PerfRegion *c : children) { delete c; }
+      children.clear();
+   }
+
+   ~PerfRegion() { Clear(); }
+};
+
+// Recorded values of a region, identified by its path in the tree.
+struct PerfEntry
+{
+   std::string path; // names of the ancestors and of the region
+   int depth;
+   double calls, time, flops, bytes;
+};
+
+static const char path_sep = '\n';
+
+static PerfRegion perf_root("", NULL);
+static PerfRegion *perf_current = &perf_root;
+static std::thread::id perf_thread;
+static bool perf_report = false;
+static bool perf_atexit = false;
+
+static bool PerfOwnerThread()
+{
+   return std::this_thread::get_id() == perf_thread;
+}
+
+// Depth-first list of the regions in the tree rooted at r.
+static void PerfFlatten(const PerfRegion &r, const std::string &prefix,
+                        int depth, std::vector<PerfEntry> &list)
+{
+   for (const PerfRegion *c : r.children)
+   {
+      PerfEntry e;
+      e.path = prefix + c->name;
+      e.depth = depth;
+      e.calls = (double)c->calls;
+      e.time = c->time;
+      e.flops = c->flops;
+      e.bytes = c->bytes;
+      list.push_back(e);
+      PerfFlatten(*c, e.path + path_sep, depth + 1, list);
+   }
+}
+
+static std::string PerfName(const PerfEntry &e)
+{
+   const std::string::size_type pos = e.path.rfind(path_sep);
+   const std::string name = (pos == std::string::npos) ?
+                            e.path : e.path.substr(pos + 1);
+   return std::string(2*e.depth, ' ') + name;
+}
+
+static int PerfNameWidth(const std::vector<PerfEntry> &list)
+{
+   std::string::size_type w = 6;
+   for (const PerfEntry &e : list)
+   {
+      const std::string::size_type l = PerfName(e).length();
+      w = (l > w) ? l : w;
+   }
+   return (int)w + 2;
+}
+
+static void PerfPrintRates(std::ostream &out, const double flops,
+                           const double bytes, const double time)
+{
+   out << std::setw(11);
+   if (flops > 0.0 && time > 0.0) { out << 1e-9*flops/time; }
+   else { out << "-"; }
+   out << std::setw(11);
+   if (bytes > 0.0 && time > 0.0) { out << 1e-9*bytes/time; }
+   else { out << "-"; }
+   out << '\n';
+}
+
+static void PerfAtExit()
+{
+   if (perf_report)
+   {
+      perf_report = false;
+      PerfRegions::Print();
+   }
+}
+
+} // namespace mfem::internal
+
+
+bool PerfRegions::enabled = false;
+
+void PerfRegions::Enable()
+{
+   using namespace internal;
+   MFEM_VERIFY(perf_current == &perf_root || PerfOwnerThread(),
+               "cannot enable the recording from another thread while regions"
+               " are open");
+   perf_thread = std::this_thread::get_id();
+   enabled = true;
+}
+
+void PerfRegions::Disable()
+{
+   enabled = false;
+}
+
+void PerfRegions::Begin(const char *name)
+{
+   using namespace internal;
+   if (!enabled || !PerfOwnerThread()) { return; }
+   if (perf_report && !perf_atexit)
+   {
+      // Registered here, after the construction of mfem::out, so that the
+      // report is printed before its destruction.
+      std::atexit(PerfAtExit);
+      perf_atexit = true;
+   }
+   perf_current = perf_current->Child(name);
+   perf_current->start = PerfClock::now();
+}
+
+void PerfRegions::End()
+{
+   using namespace internal;
+   if (!PerfOwnerThread()) { return; }
+   MFEM_VERIFY(perf_current != &perf_root, "no open region");
+   const PerfClock::time_point stop = PerfClock::now();
+   perf_current->time +=
+      std::chrono::duration<double>(stop - perf_current->start).count();
+   perf_current->calls++;
+   perf_current = perf_current->parent;
+}
+
+void PerfRegions::AddFlops(double flops)
+{
+   using namespace internal;
+   if (PerfOwnerThread()) { perf_current->flops += flops; }
+}
+
+void PerfRegions::AddBytes(double bytes)
+{
+   using namespace internal;
+   if (PerfOwnerThread()) { perf_current->bytes += bytes; }
+}
+
+void PerfRegions::Reset()
+{
+   using namespace internal;
+   MFEM_VERIFY(perf_current == &perf_root, "cannot reset with open regions");
+   perf_root.Clear();
+}
+
+void PerfRegions::Print(std::ostream &out)
+{
+   using namespace internal;
+   std::vector<PerfEntry> list;
+   PerfFlatten(perf_root, "", 0, list);
+   const int w = PerfNameWidth(list);
+
+   std::ostringstream os;
+   os << std::left << std::setw(w) << "Region" << std::right
+      << std::setw(10) << "Calls" << std::setw(13) << "Time (s)"
+      << std::setw(11) << "GFlop/s" << std::setw(11) << "GB/s" << '\n';
+   os << std::setprecision(4);
+   for (const PerfEntry &e : list)
+   {
+      os << std::left << std::setw(w) << PerfName(e) << std::right
+         << std::setw(10) << (long long)e.calls
+         << std::setw(13) << std::scientific << e.time << std::defaultfloat;
+      PerfPrintRates(os, e.flops, e.bytes, e.time);
+   }
+   out << os.str() << std::flush;
+}
+
+#ifdef MFEM_USE_MPI
+void PerfRegions::Print(MPI_Comm comm, std::ostream &out)
+{
+   using namespace internal;
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+
+   // Gather the paths of the local regions on rank 0 and merge them into a
+   // single tree, so that the ranks may have recorded different regions.
+   std::vector<PerfEntry> local;
+   PerfFlatten(perf_root, "", 0, local);
+   std::string paths;
+   for (const PerfEntry &e : local) { paths += e.path + '\0'; }
+
+   int size;
+   MPI_Comm_size(comm, &size);
+   int len = (int)paths.size();
+   std::vector<int> lens(rank == 0 ? size : 0), displs(lens.size() + 1, 0);
+   MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, comm);
+   for (int p = 0; p < (int)lens.size(); p++)
+   {
+      displs[p+1] = displs[p] + lens[p];
+   }
+   std::vector<char> all_paths(rank == 0 ? displs.back() : 0);
+   MPI_Gatherv(&paths[0], len, MPI_CHAR, all_paths.data(), lens.data(),
+               displs.data(), MPI_CHAR, 0, comm);
+
+   std::vector<PerfEntry> merged;
+   if (rank == 0)
+   {
+      PerfRegion root("", NULL);
+      for (std::size_t pos = 0; pos < all_paths.size(); )
+      {
+         const std::string path(&all_paths[pos]);
+         pos += path.size() + 1;
+         PerfRegion *r = &root;
+         std::string::size_type b = 0, e;
+         do
+         {
+            e = path.find(path_sep, b);
+            const std::string name = path.substr(b, e - b);
+            r = r->Child(name);
+            b = e + 1;
+         }
+         while (e != std::string::npos);
+      }
+      PerfFlatten(root, "", 0, merged);
+      paths.clear();
+      for (const PerfEntry &e : merged) { paths += e.path + '\0'; }
+      len = (int)paths.size();
+   }
+   MPI_Bcast(&len, 1, MPI_INT, 0, comm);
+   paths.resize(len);
+   MPI_Bcast(&paths[0], len, MPI_CHAR, 0, comm);
+
+   // Local values of the merged regions, zero for the missing ones.
+   std::map<std::string, const PerfEntry*> lookup;
+   for (const PerfEntry &e : local) { lookup[e.path] = &e; }
+   std::vector<double> calls, time, flops_bytes;
+   for (std::size_t pos = 0; pos < paths.size(); )
+   {
+      const std::string path(&paths[pos]);
+      pos += path.size() + 1;
+      auto it = lookup.find(path);
+      const bool found = (it != lookup.end());
+      calls.push_back(found ? it->second->calls : 0.0);
+      time.push_back(found ? it->second->time : 0.0);
+      flops_bytes.push_back(found ? it->second->flops : 0.0);
+      flops_bytes.push_back(found ? it->second->bytes : 0.0);
+   }
+   const int n = (int)calls.size();
+   std::vector<double> max_calls(n), min_time(n), max_time(n), sum_time(n);
+   std::vector<double> sum_flops_bytes(2*n);
+   MPI_Reduce(calls.data(), max_calls.data(), n, MPI_DOUBLE, MPI_MAX, 0, comm);
+   MPI_Reduce(time.data(), min_time.data(), n, MPI_DOUBLE, MPI_MIN, 0, comm);
+   MPI_Reduce(time.data(), max_time.data(), n, MPI_DOUBLE, MPI_MAX, 0, comm);
+   MPI_Reduce(time.data(), sum_time.data(), n, MPI_DOUBLE, MPI_SUM, 0, comm);
+   MPI_Reduce(flops_bytes.data(), sum_flops_bytes.data(), 2*n, MPI_DOUBLE,
+              MPI_SUM, 0, comm);
+   if (rank != 0) { return; }
+
+   const int w = PerfNameWidth(merged);
+   std::ostringstream os;
+   os << std::left << std::setw(w) << "Region" << std::right
+      << std::setw(10) << "Max calls" << std::setw(13) << "Min time (s)"
+      << std::setw(13) << "Max time (s)" << std::setw(13) << "Avg time (s)"
+      << std::setw(11) << "GFlop/s" << std::setw(11) << "GB/s" << '\n';
+   os << std::setprecision(4);
+   for (int i = 0; i < n; i++)
+   {
+      os << std::left << std::setw(w) << PerfName(merged[i]) << std::right
+         << std::setw(10) << (long long)max_calls[i] << std::scientific
+         << std::setw(13) << min_time[i] << std::setw(13) << max_time[i]
+         << std::setw(13) << sum_time[i]/size << std::defaultfloat;
+      // Aggregate rates: total work over the time of the slowest rank.
+      PerfPrintRates(os, sum_flops_bytes[2*i], sum_flops_bytes[2*i+1],
+                     max_time[i]);
+   }
+   out << os.str() << std::flush;
+}
+
+void PerfRegions::Finalize(MPI_Comm comm)
+{
+   using namespace internal;
+   if (perf_report)
+   {
+      perf_report = false;
+      Print(comm);
+   }
+}
+#endif
+
+void PerfRegions::ReportAtExit(bool report)
+{
+   internal::perf_report = report;
+}
+
+namespace internal
+{
+
+// Read the environment variable MFEM_PERF at startup.
+static struct PerfEnvInit
+{
+   PerfEnvInit()
+   {
+      const char *env = std::getenv("MFEM_PERF");
+      if (env && env[0] != '\0')
+      {
+         PerfRegions::Enable();
+         PerfRegions::ReportAtExit();
+      }
+   }
+} perf_env_init;
+
+} // namespace mfem::internal
+
+} // namespace mfem
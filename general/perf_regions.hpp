@@ -0,0 +1,141 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PERF_REGIONS_HPP
+#define MFEM_PERF_REGIONS_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+
+namespace mfem
+{
+
+/// Hierarchical timing of named regions of code.
+/** Regions are opened and closed with Begin() and End(), or with a PerfScope
+    object, usually through the MFEM_PERF_SCOPE macro. A region opened while
+    another one is open becomes its child, so that the recorded regions form a
+    tree in which each node accumulates the number of calls, the elapsed time
+    and, optionally, the number of floating point operations and bytes moved,
+    see AddFlops() and AddBytes().
+
+    The recording is disabled by default; in that case, the instrumentation
+    costs one test of a global flag. It can be enabled with Enable() or by
+    setting the environment variable MFEM_PERF to a non-empty value, which
+    also requests a report at exit, see ReportAtExit().
+
+    Only the thread that enabled the recording records regions: calls made from
+    other threads, e.g. inside the loops of Backend::THREADS or Backend::OMP,
+    are ignored. */
+class PerfRegions
+{
+private:
+   static bool enabled;
+
+public:
+   /// Start recording regions on the calling thread.
+   static void Enable();
+
+   /// Stop recording regions. The recorded data is kept, see Reset().
+   static void Disable();
+
+   /// Return true if the regions are currently being recorded.
+   static bool IsEnabled() { return enabled; }
+
+   /// Open the region @a name as a child of the currently open region.
+   /** The pointer @a name is used as a fast lookup key, so string literals
+       should be preferred; regions with equal names and parents are merged. */
+   static void Begin(const char *name);
+
+   /// Close the most recently opened region.
+   static void End();
+
+   /// Add @a flops floating point operations to the currently open region.
+   static void AddFlops(double flops);
+
+   /// Add @a bytes bytes of memory traffic to the currently open region.
+   static void AddBytes(double bytes);
+
+   /// Clear all recorded data. Must not be called while regions are open.
+   static void Reset();
+
+   /// Print the tree of recorded regions to @a out.
+   static void Print(std::ostream &out = mfem::out);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print the tree of the regions recorded on the ranks of @a comm,
+       with the minimum, maximum and average time over all ranks. */
+   /** This method is collective on @a comm and the report is printed by rank 0.
+       The trees of the ranks are merged, so they do not need to be the same. */
+   static void Print(MPI_Comm comm, std::ostream &out = mfem::out);
+
+   /** @brief Print the report requested with ReportAtExit(), if any, on the
+       ranks of @a comm. This is called by the destructor of MPI_Session before
+       MPI_Finalize(). */
+   static void Finalize(MPI_Comm comm);
+#endif
+
+   /** @brief Request (or cancel) a report of the recorded regions when the
+       program exits. */
+   /** In parallel, the report is aggregated over MPI_COMM_WORLD by the
+       destructor of MPI_Session; otherwise, each rank prints its own report. */
+   static void ReportAtExit(bool report = true);
+};
+
+/// Scoped region: open the region in the constructor and close it in the
+/// destructor, if the recording is enabled at construction.
+class PerfScope
+{
+private:
+   const bool active;
+
+public:
+   explicit PerfScope(const char *name) : active(PerfRegions::IsEnabled())
+   {
+      if (active) { PerfRegions::Begin(name); }
+   }
+
+   ~PerfScope() { if (active) { PerfRegions::End(); } }
+};
+
+#define MFEM_PERF_CONCAT_(a,b) a##b
+#define MFEM_PERF_CONCAT(a,b) MFEM_PERF_CONCAT_(a,b)
+
+/// Record the enclosing scope as the region @a name.
+#define MFEM_PERF_SCOPE(name) \
+   mfem::PerfScope MFEM_PERF_CONCAT(mfem_perf_scope_,__LINE__)(name)
+
+/// Add the expression @a flops to the floating point operations of the
+/// current region; @a flops is not evaluated when the recording is disabled.
+/// The macro is a single statement, so it can be used in an if-else without
+/// braces.
+#define MFEM_PERF_FLOPS(flops) \
+   do \
+   { \
+      if (mfem::PerfRegions::IsEnabled()) \
+      { \
+         mfem::PerfRegions::AddFlops(flops); \
+      } \
+   } while (0)
+
+/// Add the expression @a bytes to the memory traffic of the current region;
+/// @a bytes is not evaluated when the recording is disabled.
+#define MFEM_PERF_BYTES(bytes) \
+   do \
+   { \
+      if (mfem::PerfRegions::IsEnabled()) \
+      { \
+         mfem::PerfRegions::AddBytes(bytes); \
+      } \
+   } while (0)
+
+} // namespace mfem
+
+#endif // MFEM_PERF_REGIONS_HPP
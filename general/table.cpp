@@ -551,6 +551,44 @@ Table * Mult (const Table &A, const Table &B)
    return C;
 }
 
+void ColorRows(const Table &A, Table &colors, int _ncols_A)
+{
+   const int nrows = A.Size();
+   const int *i_A = A.GetI();
+   const int *j_A = A.GetJ();
+   Table At;
+   Transpose(A, At, _ncols_A);
+   const int *i_At = At.GetI();
+   const int *j_At = At.GetJ();
+
+   // Each row takes the smallest color not used by the previously colored
+   // rows that share one of its columns.
+   Array<int> row_color(nrows), color_marker;
+   int num_colors = 0;
+   for (int i = 0; i < nrows; i++)
+   {
+      for (int j = i_A[i]; j < i_A[i+1]; j++)
+      {
+         const int k = j_A[j];
+         for (int l = i_At[k]; l < i_At[k+1]; l++)
+         {
+            const int r = j_At[l];
+            if (r < i) { color_marker[row_color[r]] = i; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && color_marker[c] == i) { c++; }
+      if (c == num_colors)
+      {
+         color_marker.Append(-1);
+         num_colors++;
+      }
+      row_color[i] = c;
+   }
+
+   Transpose(row_color, colors, num_colors);
+}
+
 STable::STable (int dim, int connections_per_row) :
    Table(dim, connections_per_row)
 {}
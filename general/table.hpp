@@ -188,6 +188,13 @@ void Transpose(const Array<int> &A, Table &At, int _ncols_A = -1);
 void Mult (const Table &A, const Table &B, Table &C);
 Table * Mult (const Table &A, const Table &B);
 
+/** @brief Greedy coloring of the rows of @a A such that rows sharing a column
+    have different colors. On return, row c of @a colors lists, in increasing
+    order, the rows of @a A with color c. */
+/** For example, with A an element-to-dof table, the elements of one color can
+    be assembled concurrently without write conflicts. */
+void ColorRows(const Table &A, Table &colors, int _ncols_A = -1);
+
 
 /** Data type STable. STable is similar to Table, but it's for symmetric
     connectivity, i.e. TYPE I is equivalent to TYPE II. In the first
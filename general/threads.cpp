@@ -0,0 +1,274 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "threads.hpp"
+#include "error.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// True on the threads that are currently executing a chunk of a loop.
+static thread_local bool in_parallel_region = false;
+
+class ThreadPool
+{
+private:
+   typedef std::pair<int,int> Chunk;
+
+   // Queue of chunks owned by one thread.
+   struct Queue
+   {
+      std::mutex mtx;
+      std::deque<Chunk> chunks;
+   };
+
+   const int nthreads;
+   std::vector<std::thread> workers;
+   std::unique_ptr<Queue[]> queues;
+
+   // Current loop.
+   const ThreadExecutor::RangeBody *body;
+   std::atomic<int> remaining;
+   std::exception_ptr error;
+   std::mutex error_mtx;
+
+   // Wake-up of the workers: 'epoch' is incremented for every loop.
+   std::mutex wake_mtx;
+   std::condition_variable wake_cv;
+   unsigned long epoch;
+   bool stop;
+
+   // Completion of the current loop.
+   std::mutex done_mtx;
+   std::condition_variable done_cv;
+
+   // Serializes the loops submitted by different threads.
+   std::mutex submit_mtx;
+
+   bool PopChunk(int tid, Chunk &c)
+   {
+      {
+         Queue &q = queues[tid];
+         std::lock_guard<std::mutex> lock(q.mtx);
+         if (!q.chunks.empty())
+         {
+            c = q.chunks.back();
+            q.chunks.pop_back();
+            return true;
+         }
+      }
+      for (int i = 1; i < nthreads; i++)
+      {
+         Queue &q = queues[(tid + i) % nthreads];
+         std::lock_guard<std::mutex> lock(q.mtx);
+         if (!q.chunks.empty())
+         {
+            c = q.chunks.front();
+            q.chunks.pop_front();
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void RunChunks(int tid)
+   {
+      Chunk c;
+      in_parallel_region = true;
+      while (PopChunk(tid, c))
+      {
+         try
+         {
+            (*body)(c.first, c.second);
+         }
+         catch (...)
+         {
+            std::lock_guard<std::mutex> lock(error_mtx);
+            if (!error) { error = std::current_exception(); }
+         }
+         if (remaining.fetch_sub(1) == 1)
+         {
+            std::lock_guard<std::mutex> lock(done_mtx);
+            done_cv.notify_all();
+         }
+      }
+      in_parallel_region = false;
+   }
+
+   void WorkerLoop(int tid)
+   {
+      unsigned long seen = 0;
+      while (true)
+      {
+         {
+            std::unique_lock<std::mutex> lock(wake_mtx);
+            wake_cv.wait(lock, [&] { return stop || epoch != seen; });
+            if (stop) { return; }
+            seen = epoch;
+         }
+         RunChunks(tid);
+      }
+   }
+
+public:
+   ThreadPool(int num_threads)
+      : nthreads(num_threads), queues(new Queue[num_threads]), body(NULL),
+        remaining(0), epoch(0), stop(false)
+   {
+      for (int tid = 1; tid < nthreads; tid++)
+      {
+         workers.emplace_back(&ThreadPool::WorkerLoop, this, tid);
+      }
+   }
+
+   int NumThreads() const { return nthreads; }
+
+   void ParallelFor(int N, int grain, const ThreadExecutor::RangeBody &f)
+   {
+      if (N <= 0) { return; }
+      grain = (grain < 1) ? 1 : grain;
+      if (nthreads == 1 || N <= grain || in_parallel_region)
+      {
+         f(0, N);
+         return;
+      }
+
+      std::lock_guard<std::mutex> submit_lock(submit_mtx);
+      const int nchunks = (N + grain - 1) / grain;
+      // Workers still looking for chunks of the previous loop may start
+      // executing chunks as soon as they are queued.
+      body = &f;
+      remaining = nchunks;
+      error = nullptr;
+      for (int tid = 0; tid < nthreads; tid++)
+      {
+         // Contiguous blocks of chunks per thread, for data locality.
+         const int c_begin = (int)((long long)nchunks * tid / nthreads);
+         const int c_end = (int)((long long)nchunks * (tid + 1) / nthreads);
+         std::lock_guard<std::mutex> lock(queues[tid].mtx);
+         for (int c = c_begin; c < c_end; c++)
+         {
+            const int end = (c + 1 < nchunks) ? (c + 1) * grain : N;
+            queues[tid].chunks.push_back(Chunk(c * grain, end));
+         }
+      }
+      {
+         std::lock_guard<std::mutex> lock(wake_mtx);
+         epoch++;
+      }
+      wake_cv.notify_all();
+
+      RunChunks(0);
+      {
+         std::unique_lock<std::mutex> lock(done_mtx);
+         done_cv.wait(lock, [&] { return remaining.load() == 0; });
+      }
+      body = NULL;
+      if (error) { std::rethrow_exception(error); }
+   }
+
+   ~ThreadPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(wake_mtx);
+         stop = true;
+      }
+      wake_cv.notify_all();
+      for (std::thread &w : workers) { w.join(); }
+   }
+};
+
+} // namespace mfem::internal
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads)
+{
+   if (num_threads <= 0)
+   {
+      num_threads = std::thread::hardware_concurrency();
+      num_threads = (num_threads > 0) ? num_threads : 1;
+   }
+   pool = new internal::ThreadPool(num_threads);
+}
+
+int WorkStealingThreadPool::NumThreads() const
+{
+   return pool->NumThreads();
+}
+
+void WorkStealingThreadPool::ParallelFor(int N, int grain,
+                                         const RangeBody &body)
+{
+   pool->ParallelFor(N, grain, body);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+   delete pool;
+}
+
+
+static ThreadExecutor *thread_executor = NULL;
+static std::atomic<WorkStealingThreadPool*> default_thread_pool(NULL);
+static int default_num_threads = 0;
+// Guards the lazy creation and the reset of default_thread_pool, which may be
+// requested concurrently by several host threads.
+static std::mutex default_thread_pool_mutex;
+// Destroys the default thread pool at exit, joining its threads.
+static struct DefaultThreadPoolCleanup
+{
+   ~DefaultThreadPoolCleanup() { delete default_thread_pool.exchange(NULL); }
+} default_thread_pool_cleanup;
+
+ThreadExecutor &GetThreadExecutor()
+{
+   if (thread_executor) { return *thread_executor; }
+   WorkStealingThreadPool *pool =
+      default_thread_pool.load(std::memory_order_acquire);
+   if (pool) { return *pool; }
+   std::lock_guard<std::mutex> lock(default_thread_pool_mutex);
+   pool = default_thread_pool.load(std::memory_order_relaxed);
+   if (!pool)
+   {
+      pool = new WorkStealingThreadPool(default_num_threads);
+      default_thread_pool.store(pool, std::memory_order_release);
+   }
+   return *pool;
+}
+
+void SetThreadExecutor(ThreadExecutor *executor)
+{
+   thread_executor = executor;
+}
+
+void SetNumThreads(int num_threads)
+{
+   MFEM_VERIFY(!internal::in_parallel_region,
+               "cannot change the number of threads inside a parallel loop");
+   std::lock_guard<std::mutex> lock(default_thread_pool_mutex);
+   default_num_threads = num_threads;
+   delete default_thread_pool.exchange(NULL);
+}
+
+} // namespace mfem
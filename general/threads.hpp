@@ -0,0 +1,135 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_THREADS_HPP
+#define MFEM_THREADS_HPP
+
+#include "../config/config.hpp"
+#include <functional>
+#include <vector>
+
+namespace mfem
+{
+
+/// Abstract interface for the executors used by Backend::THREADS.
+/** An executor runs a loop over the iteration space [0,N) that has been split
+    into the chunks [c*grain, min((c+1)*grain, N)). Applications that manage
+    their own pool of threads can implement this interface and install it with
+    SetThreadExecutor(), so that the MFEM kernels run on their workers instead
+    of on the default WorkStealingThreadPool. */
+class ThreadExecutor
+{
+public:
+   /// Loop body: execute the iterations [begin, end).
+   typedef std::function<void(int begin, int end)> RangeBody;
+
+   /// Return the number of threads, including the calling one, used to run
+   /// the chunks of a ParallelFor().
+   virtual int NumThreads() const = 0;
+
+   /** @brief Call @a body on the chunks of @a grain iterations of [0,N),
+       returning when all chunks have been executed. */
+   /** The chunks may be executed concurrently and in any order; a call to
+       @a body may also cover several consecutive chunks. This method may be
+       called from inside a @a body, in which case it should not wait for
+       other chunks of the enclosing loop, e.g. by running sequentially. */
+   virtual void ParallelFor(int N, int grain, const RangeBody &body) = 0;
+
+   virtual ~ThreadExecutor() { }
+};
+
+namespace internal
+{
+class ThreadPool;
+}
+
+/// Persistent pool of threads with work-stealing scheduling.
+/** The worker threads are created once and sleep between loops. In each
+    ParallelFor(), the chunks are distributed evenly to per-thread queues; a
+    thread takes chunks from the back of its own queue and, once it is empty,
+    steals chunks from the front of the queues of the other threads. The
+    calling thread participates as the first worker. Nested calls, made from
+    inside a loop body, are executed sequentially by the calling thread. */
+class WorkStealingThreadPool : public ThreadExecutor
+{
+private:
+   internal::ThreadPool *pool;
+
+public:
+   /** @brief Create a pool using @a num_threads threads, including the calling
+       thread. If @a num_threads <= 0, use the number of hardware threads. */
+   explicit WorkStealingThreadPool(int num_threads = 0);
+
+   virtual int NumThreads() const;
+
+   virtual void ParallelFor(int N, int grain, const RangeBody &body);
+
+   virtual ~WorkStealingThreadPool();
+};
+
+/// Return the executor used by Backend::THREADS.
+/** This is the executor set with SetThreadExecutor() or, by default, a global
+    WorkStealingThreadPool that is created on first use with the number of
+    threads given by SetNumThreads(). */
+ThreadExecutor &GetThreadExecutor();
+
+/** @brief Set the executor used by Backend::THREADS. The executor is not
+    owned. Passing NULL restores the default WorkStealingThreadPool. */
+void SetThreadExecutor(ThreadExecutor *executor);
+
+/** @brief Set the number of threads of the default WorkStealingThreadPool; if
+    @a num_threads <= 0, use the number of hardware threads. */
+/** This can also be set with the device configuration string 'threads:<n>',
+    see Device::Configure(). */
+void SetNumThreads(int num_threads);
+
+/** @brief Return the chunk size used by the Backend::THREADS version of the
+    MFEM_FORALL loops. */
+/** The iteration space is split in a few chunks per thread to allow for load
+    balancing through work-stealing, but no smaller than @a min_grain
+    iterations to amortize the scheduling cost of light loop bodies. */
+inline int ThreadsGrainSize(int N, int num_threads, int min_grain)
+{
+   const int num_chunks = 4*num_threads;
+   const int grain = (N + num_chunks - 1) / num_chunks;
+   return (grain < min_grain) ? min_grain : grain;
+}
+
+/** @brief Reduction with the executor of Backend::THREADS: return the
+    combination with @a op of all @a body(i), i in [0,N), where @a init is the
+    identity element of @a op. */
+/** The chunks are reduced independently and their results are combined in
+    order, so that the result does not depend on the scheduling. */
+template <typename T, typename BODY, typename OP>
+T ThreadsReduce(const int N, const T init, BODY &&body, OP &&op)
+{
+   ThreadExecutor &exec = GetThreadExecutor();
+   const int grain = ThreadsGrainSize(N, exec.NumThreads(), 1024);
+   const int nchunks = (N + grain - 1) / grain;
+   std::vector<T> partial(nchunks, init);
+   exec.ParallelFor(N, grain, [&](int begin, int end)
+   {
+      for (int c = begin / grain; c * grain < end; c++)
+      {
+         const int c_end = ((c + 1) * grain < end) ? (c + 1) * grain : end;
+         T r = init;
+         for (int i = c * grain; i < c_end; i++) { r = op(r, body(i)); }
+         partial[c] = r;
+      }
+   });
+   T r = init;
+   for (int c = 0; c < nchunks; c++) { r = op(r, partial[c]); }
+   return r;
+}
+
+} // namespace mfem
+
+#endif // MFEM_THREADS_HPP
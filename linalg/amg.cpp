@@ -0,0 +1,434 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "amg.hpp"
+#include "../general/forall.hpp"
+#include "../general/threads.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mfem
+{
+
+// Call body(begin, end) on chunks of the rows [0,N), in parallel when
+// Backend::THREADS is enabled.
+template <typename BODY>
+static void ParallelRows(int N, BODY &&body)
+{
+   if (Device::Allows(Backend::THREADS_MASK))
+   {
+      ThreadExecutor &exec = GetThreadExecutor();
+      exec.ParallelFor(N, ThreadsGrainSize(N, exec.NumThreads(), 256), body);
+   }
+   else
+   {
+      body(0, N);
+   }
+}
+
+SparseMatrix *ThreadedMult(const SparseMatrix &A, const SparseMatrix &B)
+{
+   MFEM_VERIFY(A.Finalized() && B.Finalized(), "the matrices must be finalized");
+   MFEM_VERIFY(A.Width() == B.Height(),
+               "number of columns of A (" << A.Width()
+               << ") must equal number of rows of B (" << B.Height() << ")");
+   const int nrows = A.Height(), ncols = B.Width();
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const int *B_i = B.GetI(), *B_j = B.GetJ();
+   const double *A_data = A.GetData(), *B_data = B.GetData();
+
+   // Symbolic pass: count the nonzeros of every row of C
+   int *C_i = Memory<int>(nrows+1);
+   C_i[0] = 0;
+   ParallelRows(nrows, [&](int begin, int end)
+   {
+      std::vector<int> marker(ncols, -1);
+      for (int i = begin; i < end; i++)
+      {
+         int count = 0;
+         for (int ia = A_i[i]; ia < A_i[i+1]; ia++)
+         {
+            const int ja = A_j[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            {
+               const int jb = B_j[ib];
+               if (marker[jb] != i) { marker[jb] = i; count++; }
+            }
+         }
+         C_i[i+1] = count;
+      }
+   });
+   for (int i = 0; i < nrows; i++) { C_i[i+1] += C_i[i]; }
+
+   // Numeric pass
+   const int nnz = C_i[nrows];
+   int *C_j = Memory<int>(nnz);
+   double *C_data = Memory<double>(nnz);
+   ParallelRows(nrows, [&](int begin, int end)
+   {
+      std::vector<int> marker(ncols, -1);
+      for (int i = begin; i < end; i++)
+      {
+         const int row_start = C_i[i];
+         int counter = row_start;
+         for (int ia = A_i[i]; ia < A_i[i+1]; ia++)
+         {
+            const int ja = A_j[ia];
+            const double a = A_data[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            {
+               const int jb = B_j[ib];
+               if (marker[jb] < row_start)
+               {
+                  marker[jb] = counter;
+                  C_j[counter] = jb;
+                  C_data[counter] = a*B_data[ib];
+                  counter++;
+               }
+               else
+               {
+                  C_data[marker[jb]] += a*B_data[ib];
+               }
+            }
+         }
+      }
+   });
+
+   SparseMatrix *C = new SparseMatrix(C_i, C_j, C_data, nrows, ncols);
+   C->SortColumnIndices();
+   return C;
+}
+
+SparseMatrix *ThreadedRAP(const SparseMatrix &Pt, const SparseMatrix &A,
+                          const SparseMatrix &P)
+{
+   SparseMatrix *AP = ThreadedMult(A, P);
+   SparseMatrix *PtAP = ThreadedMult(Pt, *AP);
+   delete AP;
+   return PtAP;
+}
+
+
+SmoothedAggregationAMG::SmoothedAggregationAMG()
+   : Solver(0, false), theta(0.0), max_levels(10), coarse_size(200),
+     max_dense_size(2000), smoother_order(2), single_precision(false) { }
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A0)
+   : Solver(A0.Height(), false), theta(0.0), max_levels(10),
+     coarse_size(200), max_dense_size(2000), smoother_order(2),
+     single_precision(false)
+{
+   Setup(A0);
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *mat = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(mat != NULL, "the operator must be a SparseMatrix");
+   height = width = mat->Height();
+   Setup(*mat);
+}
+
+void SmoothedAggregationAMG::SetSinglePrecision(bool sp)
+{
+   if (sp == single_precision) { return; }
+   single_precision = sp;
+   // The single precision copies are made during the setup
+   if (A.Size() > 0) { Setup(*A[0]); }
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &Al,
+                                      Array<int> &agg) const
+{
+   const int n = Al.Height();
+   const int *I = Al.GetI(), *J = Al.GetJ();
+   const double *a = Al.GetData();
+   Vector d;
+   Al.GetDiag(d);
+
+   // Strength of connection, computed in parallel over the rows
+   Array<bool> strong(I[n]);
+   Array<bool> has_strong(n);
+   ParallelRows(n, [&](int begin, int end)
+   {
+      for (int i = begin; i < end; i++)
+      {
+         has_strong[i] = false;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int j = J[k];
+            strong[k] = (j != i) &&
+                        (std::abs(a[k]) > theta*sqrt(std::abs(d(i)*d(j))));
+            if (strong[k]) { has_strong[i] = true; }
+         }
+      }
+   });
+
+   agg.SetSize(n);
+   agg = -1;
+   int nc = 0;
+
+   // Phase 1: unknowns whose strong neighbors are all free form aggregates
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] >= 0 || !has_strong[i]) { continue; }
+      bool free = true;
+      for (int k = I[i]; k < I[i+1] && free; k++)
+      {
+         if (strong[k] && agg[J[k]] >= 0) { free = false; }
+      }
+      if (!free) { continue; }
+      agg[i] = nc;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (strong[k]) { agg[J[k]] = nc; }
+      }
+      nc++;
+   }
+
+   // Phase 2: join the aggregate of the most strongly connected neighbor
+   Array<int> agg1(agg);
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] >= 0 || !has_strong[i]) { continue; }
+      double max_s = 0.0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         const double s = std::abs(a[k])/sqrt(std::abs(d(i)*d(j)));
+         if (strong[k] && agg1[j] >= 0 && s > max_s)
+         {
+            max_s = s;
+            agg[i] = agg1[j];
+         }
+      }
+   }
+
+   // Phase 3: the remaining unknowns form new aggregates with their free
+   // strong neighbors
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] >= 0 || !has_strong[i]) { continue; }
+      agg[i] = nc;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (strong[k] && agg[J[k]] < 0) { agg[J[k]] = nc; }
+      }
+      nc++;
+   }
+   return nc;
+}
+
+void SmoothedAggregationAMG::Setup(const SparseMatrix &A0)
+{
+   MFEM_VERIFY(A0.Finalized(), "the matrix must be finalized");
+   Clear();
+   A.Append(&A0);
+   while (A.Size() < max_levels && A.Last()->Height() > coarse_size)
+   {
+      const SparseMatrix &Al = *A.Last();
+      const int n = Al.Height();
+      Array<int> agg;
+      const int nc = Aggregate(Al, agg);
+      if (nc == 0 || nc == n) { break; }
+
+      // Jacobi smoothing of the tentative prolongator needs rho(D^{-1} A),
+      // which is also the eigenvalue estimate of the Chebyshev smoother
+      Vector *d = new Vector;
+      Al.GetDiag(*d);
+      diag.Append(d);
+      OperatorJacobiSmoother invD(*d, no_ess_tdofs, 1.0);
+      ProductOperator DinvA(&invD, &Al, false, false);
+      PowerMethod power_method;
+      Vector ev(n);
+      const double rho =
+         power_method.EstimateLargestEigenvalue(DinvA, ev, 20, 1e-4);
+      Operator *Al_op = const_cast<SparseMatrix*>(&Al);
+      if (single_precision)
+      {
+         A32.Append(new FloatSparseMatrix(Al));
+         Al_op = A32.Last();
+      }
+      smoothers.Append(new OperatorChebyshevSmoother(
+                          Al_op, *d, no_ess_tdofs, smoother_order, rho));
+
+      // Tentative prolongator: normalized constants on the aggregates
+      Array<int> agg_size(nc);
+      agg_size = 0;
+      for (int i = 0; i < n; i++) { if (agg[i] >= 0) { agg_size[agg[i]]++; } }
+      int *T_i = Memory<int>(n+1);
+      T_i[0] = 0;
+      for (int i = 0; i < n; i++) { T_i[i+1] = T_i[i] + (agg[i] >= 0); }
+      int *T_j = Memory<int>(T_i[n]);
+      double *T_data = Memory<double>(T_i[n]);
+      for (int i = 0; i < n; i++)
+      {
+         if (agg[i] < 0) { continue; }
+         T_j[T_i[i]] = agg[i];
+         T_data[T_i[i]] = 1.0/sqrt(double(agg_size[agg[i]]));
+      }
+      SparseMatrix T(T_i, T_j, T_data, n, nc);
+
+      // Smoothed prolongator P = T - omega D^{-1} A T
+      SparseMatrix *Pl = ThreadedMult(Al, T);
+      const double omega = 4.0/(3.0*rho);
+      const int *P_i = Pl->GetI(), *P_j = Pl->GetJ();
+      double *P_data = Pl->GetData();
+      for (int i = 0; i < n; i++)
+      {
+         const double s = omega/(*d)(i);
+         for (int k = P_i[i]; k < P_i[i+1]; k++)
+         {
+            P_data[k] *= -s;
+            if (P_j[k] == agg[i]) { P_data[k] += T_data[T_i[i]]; }
+         }
+      }
+      P.Append(Pl);
+      Pt.Append(Transpose(*Pl));
+      A.Append(ThreadedRAP(*Pt.Last(), Al, *Pl));
+      if (single_precision)
+      {
+         P32.Append(new FloatSparseMatrix(*Pl));
+         Pt32.Append(new FloatSparseMatrix(*Pt.Last()));
+      }
+   }
+
+   // Coarsest level: dense LU if small enough, otherwise smoothing only
+   const SparseMatrix &Ac = *A.Last();
+   if (Ac.Height() <= std::max(coarse_size, max_dense_size))
+   {
+      Ac.ToDenseMatrix(coarse_matrix);
+      coarse_solver.SetOperator(coarse_matrix);
+   }
+   else
+   {
+      Vector *d = new Vector;
+      Ac.GetDiag(*d);
+      diag.Append(d);
+      Operator *Ac_op = const_cast<SparseMatrix*>(&Ac);
+      if (single_precision)
+      {
+         A32.Append(new FloatSparseMatrix(Ac));
+         Ac_op = A32.Last();
+      }
+      smoothers.Append(new OperatorChebyshevSmoother(
+                          Ac_op, *d, no_ess_tdofs, smoother_order));
+   }
+
+   const int num_levels = A.Size();
+   X.SetSize(num_levels);
+   Y.SetSize(num_levels);
+   R.SetSize(num_levels);
+   Z.SetSize(num_levels);
+   for (int l = 0; l < num_levels; l++)
+   {
+      X[l] = new Vector(A[l]->Height());
+      Y[l] = new Vector(A[l]->Height());
+      R[l] = new Vector(A[l]->Height());
+      Z[l] = new Vector(A[l]->Height());
+   }
+}
+
+void SmoothedAggregationAMG::Clear()
+{
+   for (int l = 1; l < A.Size(); l++) { delete A[l]; }
+   for (int l = 0; l < P.Size(); l++) { delete P[l]; delete Pt[l]; }
+   for (int l = 0; l < A32.Size(); l++) { delete A32[l]; }
+   for (int l = 0; l < P32.Size(); l++) { delete P32[l]; delete Pt32[l]; }
+   for (int l = 0; l < smoothers.Size(); l++) { delete smoothers[l]; }
+   for (int l = 0; l < diag.Size(); l++) { delete diag[l]; }
+   for (int l = 0; l < X.Size(); l++)
+   {
+      delete X[l];
+      delete Y[l];
+      delete R[l];
+      delete Z[l];
+   }
+   A.SetSize(0);
+   P.SetSize(0);
+   Pt.SetSize(0);
+   A32.SetSize(0);
+   P32.SetSize(0);
+   Pt32.SetSize(0);
+   smoothers.SetSize(0);
+   diag.SetSize(0);
+   X.SetSize(0);
+   Y.SetSize(0);
+   R.SetSize(0);
+   Z.SetSize(0);
+}
+
+void SmoothedAggregationAMG::Cycle(int level) const
+{
+   if (level == A.Size() - 1)
+   {
+      if (smoothers.Size() < A.Size())
+      {
+         coarse_solver.Mult(*X[level], *Y[level]);
+      }
+      else
+      {
+         smoothers[level]->Mult(*X[level], *Y[level]);
+      }
+      return;
+   }
+
+   // Use the single precision copies if the hierarchy was set up with them
+   const bool sp = P32.Size() > 0;
+   const Operator &Al = sp ? (const Operator&)*A32[level] : *A[level];
+   const Operator &Pl = sp ? (const Operator&)*P32[level] : *P[level];
+   const Operator &Ptl = sp ? (const Operator&)*Pt32[level] : *Pt[level];
+
+   // Pre-smoothing, starting from zero
+   smoothers[level]->Mult(*X[level], *Y[level]);
+
+   // Restrict the residual and solve the coarse correction
+   Al.Mult(*Y[level], *R[level]);
+   subtract(*X[level], *R[level], *R[level]);
+   Ptl.Mult(*R[level], *X[level+1]);
+   Cycle(level + 1);
+   Pl.Mult(*Y[level+1], *R[level]);
+   *Y[level] += *R[level];
+
+   // Post-smoothing
+   Al.Mult(*Y[level], *R[level]);
+   subtract(*X[level], *R[level], *R[level]);
+   smoothers[level]->Mult(*R[level], *Z[level]);
+   *Y[level] += *Z[level];
+}
+
+void SmoothedAggregationAMG::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(A.Size() > 0, "the operator is not set");
+   if (iterative_mode)
+   {
+      A[0]->Mult(x, *X[0]);
+      subtract(b, *X[0], *X[0]);
+      Cycle(0);
+      x += *Y[0];
+   }
+   else
+   {
+      *X[0] = b;
+      Cycle(0);
+      x = *Y[0];
+   }
+}
+
+double SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   double nnz = 0.0;
+   for (int l = 0; l < A.Size(); l++) { nnz += A[l]->NumNonZeroElems(); }
+   return nnz/A[0]->NumNonZeroElems();
+}
+
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "../config/config.hpp"
+#include "sparsemat.hpp"
+#include "floatmat.hpp"
+#include "solvers.hpp"
+
+namespace mfem
+{
+
+/** @brief Sparse matrix-matrix product C = A B, computed row-wise with two
+    passes over the rows of A, which are processed in parallel chunks when
+    Backend::THREADS is enabled. */
+/** The column indices of every row of the result are sorted. */
+SparseMatrix *ThreadedMult(const SparseMatrix &A, const SparseMatrix &B);
+
+/** @brief Galerkin product RAP = P^t A P, computed with ThreadedMult() and the
+    explicit transpose @a Pt of @a P. */
+SparseMatrix *ThreadedRAP(const SparseMatrix &Pt, const SparseMatrix &A,
+                          const SparseMatrix &P);
+
+/// Smoothed aggregation algebraic multigrid for a finalized SparseMatrix.
+/** The setup builds a hierarchy of coarse matrices: the strongly connected
+    unknowns of each level, with |a_ij| > theta sqrt(|a_ii a_jj|), are grouped
+    into aggregates, the piecewise constant tentative prolongator of the
+    aggregates is smoothed with one damped Jacobi step, P = (I - 4/(3 rho)
+    D^{-1} A) T, where rho estimates the spectral radius of D^{-1} A, and the
+    coarse matrix is the Galerkin product P^t A P. Unknowns without strong
+    connections, such as eliminated essential dofs, are left out of the
+    aggregates and are treated by the smoother only. The coarsest matrix is
+    factored with dense LU, see SetMaxDenseSize().
+
+    Mult() applies one V-cycle with Chebyshev smoothing (see
+    OperatorChebyshevSmoother), so the solver can be used as a preconditioner
+    for symmetric positive definite matrices, e.g. in CGSolver, or as the
+    coarse level solver of Multigrid. The near null space used by the
+    aggregation is the constant vector, which targets scalar diffusion-like
+    problems.
+
+    With SetSinglePrecision(), the matrices used by the V-cycle are stored in
+    single precision, see FloatSparseMatrix. */
+class SmoothedAggregationAMG : public Solver
+{
+protected:
+   double theta;
+   int max_levels, coarse_size, max_dense_size, smoother_order;
+   bool single_precision;
+
+   Array<const SparseMatrix*> A;      // A[0] is not owned
+   Array<SparseMatrix*> P, Pt;        // P[l] maps level l+1 to level l
+   // Single precision copies of A, P and Pt, used by the V-cycle if set
+   Array<FloatSparseMatrix*> A32, P32, Pt32;
+   Array<Vector*> diag;
+   Array<OperatorChebyshevSmoother*> smoothers;
+   Array<int> no_ess_tdofs;           // empty list for the smoothers
+   DenseMatrixInverse coarse_solver;
+   DenseMatrix coarse_matrix;
+
+   mutable Array<Vector*> X, Y, R, Z;
+
+   /** Aggregate the strongly connected unknowns of @a Al, returning the
+       number of aggregates; agg[i] = -1 for unknowns without an aggregate. */
+   int Aggregate(const SparseMatrix &Al, Array<int> &agg) const;
+
+   void Setup(const SparseMatrix &A0);
+   void Clear();
+   void Cycle(int level) const;
+
+public:
+   SmoothedAggregationAMG();
+
+   /// Construct and set up the hierarchy for the matrix @a A0.
+   SmoothedAggregationAMG(const SparseMatrix &A0);
+
+   /** @brief Set the strength of connection threshold (default 0, i.e. all
+       nonzero off-diagonal entries are strong connections). */
+   void SetStrengthThreshold(double theta_) { theta = theta_; }
+
+   /// Set the maximum number of levels (default 10).
+   void SetMaxLevels(int levels) { max_levels = levels; }
+
+   /// Set the size below which a level is not coarsened further (default 200).
+   /** The coarsest level is solved directly with dense LU if its size is at
+       most @a size or the size set with SetMaxDenseSize(). */
+   void SetCoarseSize(int size) { coarse_size = size; }
+
+   /** @brief Set the largest size of a coarsest level that is factored with
+       dense LU when the coarsening stops above the coarse size (default
+       2000). */
+   /** The coarsening stops early when the maximum number of levels is reached
+       or when the aggregation makes no progress. Larger coarsest levels are
+       only smoothed; with @a size = 0, only SetCoarseSize() decides. */
+   void SetMaxDenseSize(int size) { max_dense_size = size; }
+
+   /// Set the order of the Chebyshev smoother (default 2).
+   void SetSmootherOrder(int order) { smoother_order = order; }
+
+   /** @brief Store the matrices used by the V-cycle in single precision
+       (default false). */
+   /** The setup is computed in double precision. The copies halve the memory
+       traffic of the smoothers and the transfers, at the price of a rounding
+       of the preconditioner, which is usually harmless in a Krylov solver. If
+       the hierarchy is already set up, it is rebuilt. */
+   void SetSinglePrecision(bool sp = true);
+
+   /** @brief Set up the hierarchy for @a op, which must be a finalized
+       SparseMatrix. The parameters have to be set before this call. */
+   virtual void SetOperator(const Operator &op);
+
+   /// Apply one V-cycle.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Return the number of levels of the hierarchy.
+   int GetNumLevels() const { return A.Size(); }
+
+   /// Return the matrix at the given level; level 0 is the finest one.
+   const SparseMatrix &GetMatrixAtLevel(int level) const
+   { return *A[level]; }
+
+   /** @brief Return the operator complexity, the total number of nonzeros of
+       all levels divided by the number of nonzeros of the finest matrix. */
+   double GetOperatorComplexity() const;
+
+   virtual ~SmoothedAggregationAMG() { Clear(); }
+};
+
+}
+
+#endif // MFEM_AMG
@@ -0,0 +1,522 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of classes BSRMatrix and BSRSmoother
+
+#include "bsrmat.hpp"
+#include "../general/forall.hpp"
+#include "../general/sort_pairs.hpp"
+#include <algorithm>
+
+namespace mfem
+{
+
+BSRMatrix::BSRMatrix(const SparseMatrix &mat, int block_size)
+   : Operator(mat.Height(), mat.Width()), bs(block_size), Levels(NULL)
+{
+   MFEM_VERIFY(mat.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(bs > 0 && height % bs == 0 && width % bs == 0,
+               "the matrix size is not a multiple of the block size " << bs);
+   nbrows = height/bs;
+   nbcols = width/bs;
+   const int *mI = mat.HostReadI(), *mJ = mat.HostReadJ();
+   const double *mA = mat.HostReadData();
+
+   // Block pattern: the union of the column blocks of the rows of a block row
+   I.New(nbrows+1);
+   I[0] = 0;
+   Array<int> marker(nbcols);
+   marker = -1;
+   for (int i = 0; i < nbrows; i++)
+   {
+      int count = 0;
+      for (int r = i*bs; r < (i+1)*bs; r++)
+      {
+         for (int k = mI[r]; k < mI[r+1]; k++)
+         {
+            const int j = mJ[k]/bs;
+            if (marker[j] != i) { marker[j] = i; count++; }
+         }
+      }
+      I[i+1] = I[i] + count;
+   }
+   J.New(I[nbrows]);
+   marker = -1;
+   for (int i = 0; i < nbrows; i++)
+   {
+      int pos = I[i];
+      for (int r = i*bs; r < (i+1)*bs; r++)
+      {
+         for (int k = mI[r]; k < mI[r+1]; k++)
+         {
+            const int j = mJ[k]/bs;
+            if (marker[j] != i) { marker[j] = i; J[pos++] = j; }
+         }
+      }
+      std::sort(J + I[i], J + I[i+1]);
+   }
+
+   A.New(I[nbrows]*bs*bs);
+   *this = 0.0;
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int r = 0; r < bs; r++)
+      {
+         const int row = i*bs + r;
+         for (int k = mI[row]; k < mI[row+1]; k++)
+         {
+            const int b = FindBlock(i, mJ[k]/bs);
+            A[b*bs*bs + r + (mJ[k]%bs)*bs] += mA[k];
+         }
+      }
+   }
+}
+
+BSRMatrix::BSRMatrix(int *i, int *j, int num_block_rows, int num_block_cols,
+                     int block_size)
+   : Operator(num_block_rows*block_size, num_block_cols*block_size),
+     bs(block_size), nbrows(num_block_rows), nbcols(num_block_cols),
+     Levels(NULL)
+{
+   I.Wrap(i, nbrows+1, true);
+   J.Wrap(j, I[nbrows], true);
+   A.New(I[nbrows]*bs*bs);
+   *this = 0.0;
+}
+
+void BSRMatrix::Destroy()
+{
+   I.Delete();
+   J.Delete();
+   A.Delete();
+   delete Levels;
+}
+
+int BSRMatrix::FindBlock(int i, int j) const
+{
+   const int *Jp = J;
+   const int *end = Jp + I[i+1];
+   const int *pos = std::lower_bound(Jp + I[i], end, j);
+   return (pos != end && *pos == j) ? int(pos - Jp) : -1;
+}
+
+BSRMatrix &BSRMatrix::operator=(double a)
+{
+   const int n = I[nbrows]*bs*bs;
+   double *d_A = mfem::Write(A, n);
+   MFEM_FORALL(k, n, d_A[k] = a;);
+   return *this;
+}
+
+void BSRMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                             const DenseMatrix &mat)
+{
+   double *Ap = HostReadWrite(A, I[nbrows]*bs*bs);
+   for (int ii = 0; ii < rows.Size(); ii++)
+   {
+      int gi = rows[ii], s = 1;
+      if (gi < 0) { gi = -1-gi; s = -1; }
+      const int bi = gi/bs, ri = gi%bs;
+      for (int jj = 0; jj < cols.Size(); jj++)
+      {
+         int gj = cols[jj], t = s;
+         if (gj < 0) { gj = -1-gj; t = -s; }
+         const int b = FindBlock(bi, gj/bs);
+         MFEM_ASSERT(b >= 0, "entry (" << gi << "," << gj << ") is not in the "
+                     "block pattern");
+         const double a = mat(ii, jj);
+         Ap[b*bs*bs + ri + (gj%bs)*bs] += (t < 0) ? -a : a;
+      }
+   }
+}
+
+// y = a A x (add = false) or y += a A x (add = true) with fixed block size B,
+// so that the block products are fully unrolled by the compiler.
+template <int B>
+static void BSRMultKernel(const int nbrows, const int *d_I, const int *d_J,
+                          const double *d_A, const double *d_x, double *d_y,
+                          const double a, const bool add)
+{
+   MFEM_FORALL(i, nbrows,
+   {
+      double sum[B];
+      for (int r = 0; r < B; r++) { sum[r] = 0.0; }
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         const double *Ak = d_A + k*B*B;
+         const double *xj = d_x + d_J[k]*B;
+         for (int c = 0; c < B; c++)
+         {
+            for (int r = 0; r < B; r++)
+            {
+               sum[r] += Ak[r + c*B] * xj[c];
+            }
+         }
+      }
+      for (int r = 0; r < B; r++)
+      {
+         d_y[i*B+r] = add ? d_y[i*B+r] + a*sum[r] : a*sum[r];
+      }
+   });
+}
+
+// Same as BSRMultKernel() with a runtime block size.
+static void BSRMultKernel(const int bs, const int nbrows, const int *d_I,
+                          const int *d_J, const double *d_A,
+                          const double *d_x, double *d_y, const double a,
+                          const bool add)
+{
+   MFEM_FORALL(t, nbrows*bs,
+   {
+      const int i = t / bs, r = t % bs;
+      double sum = 0.0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         const double *Ak = d_A + k*bs*bs;
+         const double *xj = d_x + d_J[k]*bs;
+         for (int c = 0; c < bs; c++)
+         {
+            sum += Ak[r + c*bs] * xj[c];
+         }
+      }
+      d_y[t] = add ? d_y[t] + a*sum : a*sum;
+   });
+}
+
+static void BSRMult(const int bs, const int nbrows, const int *d_I,
+                    const int *d_J, const double *d_A, const double *d_x,
+                    double *d_y, const double a, const bool add)
+{
+   switch (bs)
+   {
+      case 1: return BSRMultKernel<1>(nbrows, d_I, d_J, d_A, d_x, d_y, a, add);
+      case 2: return BSRMultKernel<2>(nbrows, d_I, d_J, d_A, d_x, d_y, a, add);
+      case 3: return BSRMultKernel<3>(nbrows, d_I, d_J, d_A, d_x, d_y, a, add);
+      case 4: return BSRMultKernel<4>(nbrows, d_I, d_J, d_A, d_x, d_y, a, add);
+      default: return BSRMultKernel(bs, nbrows, d_I, d_J, d_A, d_x, d_y, a,
+                                       add);
+   }
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   const int nnzb = I[nbrows];
+   BSRMult(bs, nbrows, Read(I, nbrows+1), Read(J, nnzb), Read(A, nnzb*bs*bs),
+           x.Read(), y.Write(), 1.0, false);
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   const int nnzb = I[nbrows];
+   BSRMult(bs, nbrows, Read(I, nbrows+1), Read(J, nnzb), Read(A, nnzb*bs*bs),
+           x.Read(), y.ReadWrite(), a, true);
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void BSRMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a) const
+{
+   MFEM_ASSERT(height == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix height (" << height << ")");
+   MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix width (" << width << ")");
+   const double *Ap = HostRead(A, I[nbrows]*bs*bs);
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      const double *xi = xp + i*bs;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const double *Ak = Ap + k*bs*bs;
+         double *yj = yp + J[k]*bs;
+         for (int c = 0; c < bs; c++)
+         {
+            double s = 0.0;
+            for (int r = 0; r < bs; r++) { s += Ak[r + c*bs] * xi[r]; }
+            yj[c] += a*s;
+         }
+      }
+   }
+}
+
+void BSRMatrix::GetDiag(Vector &d) const
+{
+   MFEM_VERIFY(nbrows == nbcols, "the matrix must be square");
+   d.SetSize(height);
+   const double *Ap = HostRead(A, I[nbrows]*bs*bs);
+   double *dp = d.HostWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      const int b = FindBlock(i, i);
+      for (int r = 0; r < bs; r++)
+      {
+         dp[i*bs+r] = (b >= 0) ? Ap[b*bs*bs + r*(bs+1)] : 0.0;
+      }
+   }
+}
+
+void BSRMatrix::EliminateRowsCols(const Array<int> &vdofs, const Vector &sol,
+                                  Vector &rhs)
+{
+   Array<bool> ess(height);
+   ess = false;
+   for (int k = 0; k < vdofs.Size(); k++)
+   {
+      const int vdof = (vdofs[k] >= 0) ? vdofs[k] : -1-vdofs[k];
+      ess[vdof] = true;
+   }
+   double *Ap = HostReadWrite(A, I[nbrows]*bs*bs);
+   const double *sp = sol.HostRead();
+   double *rp = rhs.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         double *Ak = Ap + k*bs*bs;
+         for (int c = 0; c < bs; c++)
+         {
+            const int col = J[k]*bs + c;
+            for (int r = 0; r < bs; r++)
+            {
+               const int row = i*bs + r;
+               double &a = Ak[r + c*bs];
+               if (ess[row])
+               {
+                  a = (row == col) ? 1.0 : 0.0;
+               }
+               else if (ess[col])
+               {
+                  rp[row] -= a * sp[col];
+                  a = 0.0;
+               }
+            }
+         }
+      }
+   }
+   for (int row = 0; row < height; row++)
+   {
+      if (ess[row]) { rp[row] = sp[row]; }
+   }
+   ResetDiagInverse();
+}
+
+void BSRMatrix::EliminateRowsCols(const Array<int> &vdofs)
+{
+   Vector sol(height), rhs(height);
+   sol = 0.0;
+   rhs = 0.0;
+   EliminateRowsCols(vdofs, sol, rhs);
+}
+
+void BSRMatrix::ComputeDiagInverse() const
+{
+   if (Dinv.SizeK() == nbrows && nbrows > 0) { return; }
+   MFEM_VERIFY(nbrows == nbcols, "the matrix must be square");
+   Dinv.SetSize(bs, bs, nbrows);
+   const double *Ap = HostRead(A, I[nbrows]*bs*bs);
+   double *Dp = Dinv.HostWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      const int b = FindBlock(i, i);
+      MFEM_VERIFY(b >= 0, "missing diagonal block in block row " << i);
+      std::copy(Ap + b*bs*bs, Ap + (b+1)*bs*bs, Dp + i*bs*bs);
+   }
+   BatchInverse(Dinv, Dinv);
+}
+
+void BSRMatrix::BlockJacobi(const Vector &b, const Vector &x0, Vector &x1,
+                            double sc) const
+{
+   MFEM_VERIFY(bs <= 16, "block size " << bs << " is not supported");
+   ComputeDiagInverse();
+   // x1 = b - A x0, then x1 = x0 + sc D^{-1} x1 block by block
+   x1 = b;
+   AddMult(x0, x1, -1.0);
+   const int bs = this->bs;
+   auto d_Dinv = Dinv.Read();
+   auto d_x0 = x0.Read();
+   auto d_x1 = x1.ReadWrite();
+   MFEM_FORALL(i, nbrows,
+   {
+      double t[16];
+      const double *Di = d_Dinv + i*bs*bs;
+      for (int r = 0; r < bs; r++) { t[r] = d_x1[i*bs+r]; }
+      for (int r = 0; r < bs; r++)
+      {
+         double s = 0.0;
+         for (int c = 0; c < bs; c++) { s += Di[r + c*bs] * t[c]; }
+         d_x1[i*bs+r] = d_x0[i*bs+r] + sc*s;
+      }
+   });
+}
+
+// Block Gauss-Seidel update of block row i: x_i = D_ii^{-1} (b_i - sum_{j!=i}
+// A_ij x_j).
+static inline void BlockGSRow(const int i, const int bs, const int *Ip,
+                              const int *Jp, const double *Ap,
+                              const double *Dinv, const double *bp, double *xp)
+{
+   double t[16];
+   for (int r = 0; r < bs; r++) { t[r] = bp[i*bs+r]; }
+   for (int k = Ip[i]; k < Ip[i+1]; k++)
+   {
+      const int j = Jp[k];
+      if (j == i) { continue; }
+      const double *Ak = Ap + k*bs*bs;
+      const double *xj = xp + j*bs;
+      for (int c = 0; c < bs; c++)
+      {
+         for (int r = 0; r < bs; r++) { t[r] -= Ak[r + c*bs] * xj[c]; }
+      }
+   }
+   const double *Di = Dinv + i*bs*bs;
+   for (int r = 0; r < bs; r++)
+   {
+      double s = 0.0;
+      for (int c = 0; c < bs; c++) { s += Di[r + c*bs] * t[c]; }
+      xp[i*bs+r] = s;
+   }
+}
+
+const SparseLevelSchedule &BSRMatrix::GetLevels() const
+{
+   if (Levels == NULL)
+   {
+      Levels = new SparseLevelSchedule;
+      Levels->Build(nbrows, HostRead(I, nbrows+1), HostRead(J, I[nbrows]),
+                    SparseLevelSchedule::GAUSS_SEIDEL);
+   }
+   return *Levels;
+}
+
+void BSRMatrix::BlockGaussSeidelForw(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(bs <= 16, "block size " << bs << " is not supported");
+   ComputeDiagInverse();
+   const int bs = this->bs;
+   const int nnzb = I[nbrows];
+   const int *Ip = HostRead(I, nbrows+1), *Jp = HostRead(J, nnzb);
+   const double *Ap = HostRead(A, nnzb*bs*bs);
+   const double *Dp = Dinv.HostRead();
+   const double *bp = b.HostRead();
+   double *xp = x.HostReadWrite();
+   GetLevels().Forall([=](int i)
+   { BlockGSRow(i, bs, Ip, Jp, Ap, Dp, bp, xp); });
+}
+
+void BSRMatrix::BlockGaussSeidelBack(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(bs <= 16, "block size " << bs << " is not supported");
+   ComputeDiagInverse();
+   const int bs = this->bs;
+   const int nnzb = I[nbrows];
+   const int *Ip = HostRead(I, nbrows+1), *Jp = HostRead(J, nnzb);
+   const double *Ap = HostRead(A, nnzb*bs*bs);
+   const double *Dp = Dinv.HostRead();
+   const double *bp = b.HostRead();
+   double *xp = x.HostReadWrite();
+   GetLevels().Forall([=](int i)
+   { BlockGSRow(i, bs, Ip, Jp, Ap, Dp, bp, xp); }, true);
+}
+
+SparseMatrix *BSRMatrix::ToSparseMatrix() const
+{
+   const double *Ap = HostRead(A, I[nbrows]*bs*bs);
+   int *mI = Memory<int>(height+1);
+   mI[0] = 0;
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int r = 0; r < bs; r++)
+      {
+         const int row = i*bs + r;
+         mI[row+1] = mI[row] + (I[i+1] - I[i])*bs;
+      }
+   }
+   int *mJ = Memory<int>(mI[height]);
+   double *mA = Memory<double>(mI[height]);
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int r = 0; r < bs; r++)
+      {
+         int pos = mI[i*bs + r];
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            for (int c = 0; c < bs; c++, pos++)
+            {
+               mJ[pos] = J[k]*bs + c;
+               mA[pos] = Ap[k*bs*bs + r + c*bs];
+            }
+         }
+      }
+   }
+   return new SparseMatrix(mI, mJ, mA, height, width, true, true, true);
+}
+
+
+BSRSmoother::BSRSmoother(const BSRMatrix &a, Type t, double s, int it)
+   : Solver(a.Height()), oper(&a), type(t), scale(s), iterations(it)
+{
+   oper->ComputeDiagInverse();
+}
+
+void BSRSmoother::SetOperator(const Operator &a)
+{
+   oper = dynamic_cast<const BSRMatrix*>(&a);
+   MFEM_VERIFY(oper != NULL, "the operator must be a BSRMatrix");
+   height = oper->Height();
+   width = oper->Width();
+   oper->ComputeDiagInverse();
+}
+
+void BSRSmoother::Mult(const Vector &x, Vector &y) const
+{
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   if (type == JACOBI)
+   {
+      z.SetSize(width);
+      for (int i = 0; i < iterations; i++)
+      {
+         oper->BlockJacobi(x, y, z, scale);
+         y = z;
+      }
+      return;
+   }
+   for (int i = 0; i < iterations; i++)
+   {
+      if (type != GS_BACKWARD)
+      {
+         oper->BlockGaussSeidelForw(x, y);
+      }
+      if (type != GS_FORWARD)
+      {
+         oper->BlockGaussSeidelBack(x, y);
+      }
+   }
+}
+
+}
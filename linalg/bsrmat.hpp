@@ -0,0 +1,190 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BSRMAT
+#define MFEM_BSRMAT
+
+#include "../config/config.hpp"
+#include "../general/mem_manager.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/// Block compressed sparse row (BSR) matrix with square blocks of fixed size.
+/** Block row i contains the rows i*bs, ..., i*bs+bs-1 of the matrix, which is
+    the layout of the vector dofs of a FiniteElementSpace with vdim = bs and
+    Ordering::byVDIM. The column index of a block is stored once for its bs x
+    bs entries, which are stored contiguously in column-major order.
+
+    The matrix can be converted from a finalized SparseMatrix or assembled
+    directly with BilinearForm::AssembleBSR(). */
+class BSRMatrix : public Operator
+{
+protected:
+   int bs;            ///< Block size
+   int nbrows, nbcols;
+
+   /// Block row offsets, size nbrows+1.
+   Memory<int> I;
+   /// Block column indices, sorted in every block row.
+   Memory<int> J;
+   /// Block entries; block k is at offset k*bs*bs, in column-major order.
+   Memory<double> A;
+
+   /// Inverses of the diagonal blocks, used by the block smoothers.
+   mutable DenseTensor Dinv;
+   /// Level schedule of the block Gauss-Seidel sweeps. Owned.
+   mutable SparseLevelSchedule *Levels;
+
+   /// Return #Levels, building it on first use.
+   const SparseLevelSchedule &GetLevels() const;
+
+   /// Return the index of block (i,j) in #J and #A, or -1 if it is not stored.
+   int FindBlock(int i, int j) const;
+
+   void Destroy();
+
+public:
+   /** @brief Convert the finalized SparseMatrix @a mat whose height and width
+       are multiples of @a block_size. */
+   BSRMatrix(const SparseMatrix &mat, int block_size);
+
+   /** @brief Create a matrix with the given block CSR pattern and zero
+       entries. Ownership of @a i and @a j is transferred to the BSRMatrix. */
+   /** The column indices of every block row must be sorted. */
+   BSRMatrix(int *i, int *j, int num_block_rows, int num_block_cols,
+             int block_size);
+
+   /// Not copyable: the arrays and the level schedule are owned.
+   BSRMatrix(const BSRMatrix &) = delete;
+   BSRMatrix &operator=(const BSRMatrix &) = delete;
+
+   /// Return the block size.
+   int GetBlockSize() const { return bs; }
+
+   /// Return the number of block rows.
+   int NumBlockRows() const { return nbrows; }
+
+   /// Return the number of block columns.
+   int NumBlockCols() const { return nbcols; }
+
+   /// Return the number of stored blocks.
+   int NumNonZeroBlocks() const { return I[nbrows]; }
+
+   int *GetI() { return I; }
+   const int *GetI() const { return I; }
+   int *GetJ() { return J; }
+   const int *GetJ() const { return J; }
+   double *GetData() { return A; }
+   const double *GetData() const { return A; }
+
+   /// Set all the entries to @a a.
+   BSRMatrix &operator=(double a);
+
+   /** @brief Add the dense matrix @a mat to the rows @a rows and the columns
+       @a cols, which must belong to stored blocks. */
+   /** As in SparseMatrix::AddSubMatrix(), negative indices -1-k refer to the
+       index k with a change of sign. */
+   void AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                     const DenseMatrix &mat);
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   /// Matrix vector multiplication y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = A^t x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// y += a A^t x, computed sequentially on the host.
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+
+   /// Return the diagonal of the matrix in @a d.
+   void GetDiag(Vector &d) const;
+
+   /** @brief Eliminate the rows and columns @a vdofs, setting the diagonal
+       entries to one and modifying @a rhs so that the solution is @a sol at
+       the eliminated entries. */
+   void EliminateRowsCols(const Array<int> &vdofs, const Vector &sol,
+                          Vector &rhs);
+
+   /// Eliminate the rows and columns @a vdofs, setting the diagonal to one.
+   void EliminateRowsCols(const Array<int> &vdofs);
+
+   /** One block Jacobi iteration for the system A x = b,
+       x1 = x0 + sc D^{-1} (b - A x0), where D is the block diagonal of A. */
+   void BlockJacobi(const Vector &b, const Vector &x0, Vector &x1,
+                    double sc) const;
+
+   /// Block Gauss-Seidel forward and backward iterations for A x = b.
+   /** When Backend::THREADS is enabled, independent block rows are processed
+       in parallel following a level schedule of the block pattern, with the
+       same result as the sequential sweeps. */
+   void BlockGaussSeidelForw(const Vector &b, Vector &x) const;
+   void BlockGaussSeidelBack(const Vector &b, Vector &x) const;
+
+   /** @brief Compute and store internally the inverses of the diagonal blocks,
+       used by BlockJacobi() and the block Gauss-Seidel sweeps. */
+   /** This is done on the first use and has to be repeated, after a call to
+       ResetDiagInverse(), when the entries change. */
+   void ComputeDiagInverse() const;
+
+   /// Reset (destroy) the stored inverses of the diagonal blocks.
+   void ResetDiagInverse() const { Dinv.SetSize(0, 0, 0); }
+
+   /// Convert to a finalized SparseMatrix.
+   SparseMatrix *ToSparseMatrix() const;
+
+   virtual ~BSRMatrix() { Destroy(); }
+};
+
+
+/// Block Jacobi and block Gauss-Seidel smoothers for a BSRMatrix.
+class BSRSmoother : public Solver
+{
+public:
+   enum Type
+   {
+      JACOBI,            ///< Scaled block Jacobi
+      GS_FORWARD,        ///< Forward block Gauss-Seidel
+      GS_BACKWARD,       ///< Backward block Gauss-Seidel
+      GS_SYMMETRIC       ///< Forward followed by backward block Gauss-Seidel
+   };
+
+protected:
+   const BSRMatrix *oper;
+   Type type;
+   double scale;
+   int iterations;
+
+   mutable Vector z;
+
+public:
+   BSRSmoother(Type t = JACOBI, double s = 1.0, int it = 1)
+      : oper(NULL), type(t), scale(s), iterations(it) { }
+
+   BSRSmoother(const BSRMatrix &a, Type t = JACOBI, double s = 1.0,
+               int it = 1);
+
+   virtual void SetOperator(const Operator &a);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+}
+
+#endif // MFEM_BSRMAT
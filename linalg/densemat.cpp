@@ -3595,4 +3595,285 @@ void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 
 }
 
+// Batched inverse with the size M fixed at compile time: every matrix is
+// copied to local memory, inverted and copied back.
+template <int M>
+static void BatchInverseKernel(const int NE, const double *d_A,
+                               double *d_Ainv, bool *d_flag, const double TOL)
+{
+   MFEM_FORALL(e, NE,
+   {
+      double a[M*M];
+      int ipiv[M];
+      for (int i = 0; i < M*M; i++) { a[i] = d_A[i + e*M*M]; }
+      if (!kernels::GaussJordanInvert(a, M, ipiv, TOL)) { d_flag[0] = false; }
+      for (int i = 0; i < M*M; i++) { d_Ainv[i + e*M*M] = a[i]; }
+   });
+}
+
+// Batched inverse with a runtime size, computed in place in d_Ainv.
+static void BatchInverseKernel(const int m, const int NE, const double *d_A,
+                               double *d_Ainv, int *d_ipiv, bool *d_flag,
+                               const double TOL)
+{
+   MFEM_FORALL(e, NE,
+   {
+      double *a = d_Ainv + e*m*m;
+      if (d_A != d_Ainv)
+      {
+         for (int i = 0; i < m*m; i++) { a[i] = d_A[i + e*m*m]; }
+      }
+      if (!kernels::GaussJordanInvert(a, m, d_ipiv + e*m, TOL))
+      {
+         d_flag[0] = false;
+      }
+   });
+}
+
+void BatchInverse(const DenseTensor &A, DenseTensor &Ainv, const double TOL)
+{
+   const int m = A.SizeI();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(A.SizeJ() == m, "the matrices must be square");
+   if (&Ainv != &A &&
+       (Ainv.SizeI() != m || Ainv.SizeJ() != m || Ainv.SizeK() != NE))
+   {
+      Ainv.SetSize(m, m, NE);
+   }
+   Array<bool> pivot_flag(1);
+   pivot_flag[0] = true;
+   bool *d_flag = pivot_flag.ReadWrite();
+   const double *d_A = (&Ainv == &A) ? Ainv.ReadWrite() : A.Read();
+   double *d_Ainv = (&Ainv == &A) ? Ainv.ReadWrite() : Ainv.Write();
+
+   switch (m)
+   {
+      case 2: BatchInverseKernel<2>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 3: BatchInverseKernel<3>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 4: BatchInverseKernel<4>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 6: BatchInverseKernel<6>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 8: BatchInverseKernel<8>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 9: BatchInverseKernel<9>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 10: BatchInverseKernel<10>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 16: BatchInverseKernel<16>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      case 27: BatchInverseKernel<27>(NE, d_A, d_Ainv, d_flag, TOL); break;
+      default:
+      {
+         Array<int> ipiv(m*NE);
+         BatchInverseKernel(m, NE, d_A, d_Ainv, ipiv.Write(), d_flag, TOL);
+      }
+   }
+
+   MFEM_VERIFY(pivot_flag.HostRead()[0],
+               "batch inverse failed: singular matrix");
+}
+
+// Batched Cholesky factorization with the size M fixed at compile time.
+template <int M>
+static void BatchCholeskyKernel(const int NE, double *d_M, bool *d_flag,
+                                const double TOL)
+{
+   MFEM_FORALL(e, NE,
+   {
+      double a[M*M];
+      for (int i = 0; i < M*M; i++) { a[i] = d_M[i + e*M*M]; }
+      if (!kernels::CholeskyFactor(a, M, TOL)) { d_flag[0] = false; }
+      for (int i = 0; i < M*M; i++) { d_M[i + e*M*M] = a[i]; }
+   });
+}
+
+void BatchCholeskyFactor(DenseTensor &M, const double TOL)
+{
+   const int m = M.SizeI();
+   const int NE = M.SizeK();
+   MFEM_VERIFY(M.SizeJ() == m, "the matrices must be square");
+   Array<bool> pivot_flag(1);
+   pivot_flag[0] = true;
+   bool *d_flag = pivot_flag.ReadWrite();
+   double *d_M = M.ReadWrite();
+
+   switch (m)
+   {
+      case 2: BatchCholeskyKernel<2>(NE, d_M, d_flag, TOL); break;
+      case 3: BatchCholeskyKernel<3>(NE, d_M, d_flag, TOL); break;
+      case 4: BatchCholeskyKernel<4>(NE, d_M, d_flag, TOL); break;
+      case 6: BatchCholeskyKernel<6>(NE, d_M, d_flag, TOL); break;
+      case 8: BatchCholeskyKernel<8>(NE, d_M, d_flag, TOL); break;
+      case 9: BatchCholeskyKernel<9>(NE, d_M, d_flag, TOL); break;
+      case 10: BatchCholeskyKernel<10>(NE, d_M, d_flag, TOL); break;
+      case 16: BatchCholeskyKernel<16>(NE, d_M, d_flag, TOL); break;
+      case 27: BatchCholeskyKernel<27>(NE, d_M, d_flag, TOL); break;
+      default:
+         MFEM_FORALL(e, NE,
+         {
+            if (!kernels::CholeskyFactor(d_M + e*m*m, m, TOL))
+            {
+               d_flag[0] = false;
+            }
+         });
+   }
+
+   MFEM_VERIFY(pivot_flag.HostRead()[0],
+               "batch Cholesky factorization failed: matrix is not positive"
+               " definite");
+}
+
+void BatchCholeskySolve(const DenseTensor &L, Vector &X)
+{
+   const int m = L.SizeI();
+   const int NE = L.SizeK();
+   MFEM_VERIFY(X.Size() == m*NE, "incompatible sizes");
+
+   auto d_L = L.Read();
+   auto d_X = X.ReadWrite();
+   MFEM_FORALL(e, NE, kernels::CholeskySolve(d_L + e*m*m, m, d_X + e*m););
+}
+
+// Batched products C(e) = a A(e) B(e) + b C(e) with square matrices of size M
+// fixed at compile time.
+template <int M>
+static void BatchGemmKernel(const int NE, const double a, const double *d_A,
+                            const double *d_B, const double b, double *d_C)
+{
+   MFEM_FORALL(e, NE,
+   {
+      const double *A = d_A + e*M*M, *B = d_B + e*M*M;
+      double *C = d_C + e*M*M;
+      for (int j = 0; j < M; j++)
+      {
+         double c[M];
+         for (int i = 0; i < M; i++) { c[i] = 0.0; }
+         for (int k = 0; k < M; k++)
+         {
+            const double b_kj = B[k + j*M];
+            for (int i = 0; i < M; i++) { c[i] += A[i + k*M] * b_kj; }
+         }
+         for (int i = 0; i < M; i++)
+         {
+            C[i + j*M] = (b == 0.0) ? a*c[i] : a*c[i] + b*C[i + j*M];
+         }
+      }
+   });
+}
+
+// Batched products C(e) = a A(e) B(e) + b C(e) with runtime sizes.
+static void BatchGemmKernel(const int m, const int l, const int n,
+                            const int NE, const double a, const double *d_A,
+                            const double *d_B, const double b, double *d_C)
+{
+   MFEM_FORALL(e, NE,
+   {
+      const double *A = d_A + e*m*l, *B = d_B + e*l*n;
+      double *C = d_C + e*m*n;
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < m; i++)
+         {
+            double c = 0.0;
+            for (int k = 0; k < l; k++) { c += A[i + k*m] * B[k + j*l]; }
+            C[i + j*m] = (b == 0.0) ? a*c : a*c + b*C[i + j*m];
+         }
+      }
+   });
+}
+
+static void BatchGemm(const double a, const DenseTensor &A,
+                      const DenseTensor &B, const double b, DenseTensor &C)
+{
+   const int m = A.SizeI(), l = A.SizeJ(), n = B.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(B.SizeI() == l && B.SizeK() == NE, "incompatible sizes");
+   MFEM_VERIFY(C.SizeI() == m && C.SizeJ() == n && C.SizeK() == NE,
+               "incompatible sizes");
+   auto d_A = A.Read();
+   auto d_B = B.Read();
+   auto d_C = (b == 0.0) ? C.Write() : C.ReadWrite();
+
+   const int id = (m == l && l == n) ? m : 0;
+   switch (id)
+   {
+      case 2: BatchGemmKernel<2>(NE, a, d_A, d_B, b, d_C); break;
+      case 3: BatchGemmKernel<3>(NE, a, d_A, d_B, b, d_C); break;
+      case 4: BatchGemmKernel<4>(NE, a, d_A, d_B, b, d_C); break;
+      case 6: BatchGemmKernel<6>(NE, a, d_A, d_B, b, d_C); break;
+      case 8: BatchGemmKernel<8>(NE, a, d_A, d_B, b, d_C); break;
+      case 9: BatchGemmKernel<9>(NE, a, d_A, d_B, b, d_C); break;
+      case 10: BatchGemmKernel<10>(NE, a, d_A, d_B, b, d_C); break;
+      case 16: BatchGemmKernel<16>(NE, a, d_A, d_B, b, d_C); break;
+      case 27: BatchGemmKernel<27>(NE, a, d_A, d_B, b, d_C); break;
+      default: BatchGemmKernel(m, l, n, NE, a, d_A, d_B, b, d_C);
+   }
+}
+
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C)
+{
+   const int m = A.SizeI(), n = B.SizeJ(), NE = A.SizeK();
+   if (C.SizeI() != m || C.SizeJ() != n || C.SizeK() != NE)
+   {
+      C.SetSize(m, n, NE);
+   }
+   BatchGemm(1.0, A, B, 0.0, C);
+}
+
+void BatchAddMult_a(double a, const DenseTensor &A, const DenseTensor &B,
+                    DenseTensor &C)
+{
+   BatchGemm(a, A, B, 1.0, C);
+}
+
+// Batched products y_e = A(e) x_e with square matrices of size M fixed at
+// compile time.
+template <int M>
+static void BatchGemvKernel(const int NE, const double *d_A,
+                            const double *d_x, double *d_y)
+{
+   MFEM_FORALL(e, NE,
+   {
+      const double *A = d_A + e*M*M, *x = d_x + e*M;
+      double y[M];
+      for (int i = 0; i < M; i++) { y[i] = 0.0; }
+      for (int j = 0; j < M; j++)
+      {
+         const double x_j = x[j];
+         for (int i = 0; i < M; i++) { y[i] += A[i + j*M] * x_j; }
+      }
+      for (int i = 0; i < M; i++) { d_y[i + e*M] = y[i]; }
+   });
+}
+
+void BatchMult(const DenseTensor &A, const Vector &X, Vector &Y)
+{
+   const int m = A.SizeI(), n = A.SizeJ(), NE = A.SizeK();
+   MFEM_VERIFY(X.Size() == n*NE, "incompatible sizes");
+   Y.SetSize(m*NE);
+   auto d_A = A.Read();
+   auto d_x = X.Read();
+   auto d_y = Y.Write();
+
+   const int id = (m == n) ? m : 0;
+   switch (id)
+   {
+      case 2: BatchGemvKernel<2>(NE, d_A, d_x, d_y); break;
+      case 3: BatchGemvKernel<3>(NE, d_A, d_x, d_y); break;
+      case 4: BatchGemvKernel<4>(NE, d_A, d_x, d_y); break;
+      case 6: BatchGemvKernel<6>(NE, d_A, d_x, d_y); break;
+      case 8: BatchGemvKernel<8>(NE, d_A, d_x, d_y); break;
+      case 9: BatchGemvKernel<9>(NE, d_A, d_x, d_y); break;
+      case 10: BatchGemvKernel<10>(NE, d_A, d_x, d_y); break;
+      case 16: BatchGemvKernel<16>(NE, d_A, d_x, d_y); break;
+      case 27: BatchGemvKernel<27>(NE, d_A, d_x, d_y); break;
+      default:
+         MFEM_FORALL(e, NE,
+         {
+            const double *Ae = d_A + e*m*n, *x = d_x + e*n;
+            for (int i = 0; i < m; i++)
+            {
+               double y_i = 0.0;
+               for (int j = 0; j < n; j++) { y_i += Ae[i + j*m] * x[j]; }
+               d_y[i + e*m] = y_i;
+            }
+         });
+   }
+}
+
 } // namespace mfem
@@ -884,6 +884,59 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the inverses of a batch of matrices
+
+    Compute Ainv(k) = A(k)^{-1} for n matrices of size (m x m) with Gauss-Jordan
+    elimination and partial pivoting. The sizes of the common finite elements
+    use kernels with compile-time sizes, which keep every matrix in local
+    memory.
+
+    @param [in] A batch of square matrices - dimension m x m x n.
+    @param [out] Ainv batch of inverses - dimension m x m x n. It can be the
+    same object as @a A.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0.
+
+    Aborts if a pivot of some matrix is not larger than @a TOL in absolute
+    value, i.e. if the matrix is singular. */
+void BatchInverse(const DenseTensor &A, DenseTensor &Ainv,
+                  const double TOL = 0.0);
+
+/** @brief Compute the Cholesky factorization of a batch of matrices
+
+    Factorize n symmetric positive definite matrices of size (m x m), stored in
+    a dense tensor, overwriting them with the lower triangular factors L such
+    that L.L^t = M. The strictly upper triangular parts are set to zero.
+
+    @param [in, out] M batch of square matrices - dimension m x m x n.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0.
+
+    Aborts if a pivot of some matrix is not larger than @a TOL, i.e. if the
+    matrix is not positive definite. */
+void BatchCholeskyFactor(DenseTensor &M, const double TOL = 0.0);
+
+/** @brief Solve batch linear systems
+
+    Assuming L.L^t = M for n factored matrices (m x m), compute x <- M^{-1} x,
+    for n companion vectors.
+
+    @param [in] L batch of Cholesky factors - dimension m x m x n.
+    @param [in, out] X vector storing right-hand side and then solution -
+    dimension m x n. */
+void BatchCholeskySolve(const DenseTensor &L, Vector &X);
+
+/** @brief Batched matrix-matrix products C(k) = A(k) B(k), for matrices A(k)
+    of size (m x l) and B(k) of size (l x n). C is resized to m x n. */
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C);
+
+/// Batched matrix-matrix products C(k) += a A(k) B(k).
+void BatchAddMult_a(double a, const DenseTensor &A, const DenseTensor &B,
+                    DenseTensor &C);
+
+/** @brief Batched matrix-vector products y_k = A(k) x_k, for matrices A(k) of
+    size (m x n), where x_k and y_k are the consecutive blocks of @a X and
+    @a Y of sizes n and m. Y is resized to m times the number of matrices. */
+void BatchMult(const DenseTensor &A, const Vector &X, Vector &Y);
+
 
 // Inline methods
 
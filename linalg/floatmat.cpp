@@ -0,0 +1,262 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of classes FloatSparseMatrix and FloatGSSmoother
+
+#include "floatmat.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+FloatSparseMatrix::FloatSparseMatrix(const SparseMatrix &mat)
+   : Operator(mat.Height(), mat.Width()), Levels(NULL)
+{
+   MFEM_VERIFY(mat.Finalized(), "the matrix must be finalized");
+   const int *mI = mat.HostReadI(), *mJ = mat.HostReadJ();
+   const double *mA = mat.HostReadData();
+   const int nnz = mI[height];
+   I.New(height+1);
+   J.New(nnz);
+   A.New(nnz);
+   for (int i = 0; i <= height; i++) { I[i] = mI[i]; }
+   for (int k = 0; k < nnz; k++)
+   {
+      J[k] = mJ[k];
+      A[k] = static_cast<float>(mA[k]);
+   }
+}
+
+void FloatSparseMatrix::Destroy()
+{
+   I.Delete();
+   J.Delete();
+   A.Delete();
+   delete Levels;
+}
+
+void FloatSparseMatrix::GetDiag(Vector &d) const
+{
+   MFEM_VERIFY(height == width, "the matrix must be square");
+   d.SetSize(height);
+   const int nnz = I[height];
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   auto d_d = d.Write();
+   MFEM_FORALL(i, height,
+   {
+      double dii = 0.0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         if (d_J[k] == i) { dii = d_A[k]; break; }
+      }
+      d_d[i] = dii;
+   });
+}
+
+SparseMatrix *FloatSparseMatrix::ToSparseMatrix() const
+{
+   const int nnz = I[height];
+   const float *Ap = HostRead(A, nnz);
+   int *mI = Memory<int>(height+1);
+   int *mJ = Memory<int>(nnz);
+   double *mA = Memory<double>(nnz);
+   for (int i = 0; i <= height; i++) { mI[i] = I[i]; }
+   for (int k = 0; k < nnz; k++)
+   {
+      mJ[k] = J[k];
+      mA[k] = Ap[k];
+   }
+   return new SparseMatrix(mI, mJ, mA, height, width, true, true, true);
+}
+
+// y = a A x (add = false) or y += a A x (add = true), summing in double
+static void FloatSpMV(const int n, const int *d_I, const int *d_J,
+                      const float *d_A, const double *d_x, double *d_y,
+                      const double a, const bool add)
+{
+   MFEM_FORALL(i, n,
+   {
+      double sum = 0.0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         sum += static_cast<double>(d_A[k]) * d_x[d_J[k]];
+      }
+      d_y[i] = add ? d_y[i] + a*sum : a*sum;
+   });
+}
+
+void FloatSparseMatrix::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   const int nnz = I[height];
+   FloatSpMV(height, Read(I, height+1), Read(J, nnz), Read(A, nnz), x.Read(),
+             y.Write(), 1.0, false);
+}
+
+void FloatSparseMatrix::AddMult(const Vector &x, Vector &y,
+                                const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   const int nnz = I[height];
+   FloatSpMV(height, Read(I, height+1), Read(J, nnz), Read(A, nnz), x.Read(),
+             y.ReadWrite(), a, true);
+}
+
+void FloatSparseMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void FloatSparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                         const double a) const
+{
+   MFEM_ASSERT(height == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix height (" << height << ")");
+   MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix width (" << width << ")");
+   const float *Ap = HostRead(A, I[height]);
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int i = 0; i < height; i++)
+   {
+      const double xi = a*xp[i];
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         yp[J[k]] += Ap[k] * xi;
+      }
+   }
+}
+
+// Gauss-Seidel update of row i: y_i = (x_i - sum_{j!=i} a_ij y_j) / a_ii.
+static inline void FloatGSRow(const int i, const int *Ip, const int *Jp,
+                              const float *Ap, const double *xp, double *yp)
+{
+   double sum = 0.0;
+   int d = -1;
+   for (int j = Ip[i]; j < Ip[i+1]; j++)
+   {
+      const int c = Jp[j];
+      if (c == i)
+      {
+         d = j;
+      }
+      else
+      {
+         sum += Ap[j] * yp[c];
+      }
+   }
+
+   if (d >= 0 && Ap[d] != 0.0f)
+   {
+      yp[i] = (xp[i] - sum) / Ap[d];
+   }
+   else if (xp[i] == sum)
+   {
+      yp[i] = sum;
+   }
+   else
+   {
+      mfem_error("FloatSparseMatrix::Gauss_Seidel_forw/back(...)");
+   }
+}
+
+const SparseLevelSchedule &FloatSparseMatrix::GetLevels() const
+{
+   if (Levels == NULL)
+   {
+      Levels = new SparseLevelSchedule;
+      Levels->Build(height, HostRead(I, height+1), HostRead(J, I[height]),
+                    SparseLevelSchedule::GAUSS_SEIDEL);
+   }
+   return *Levels;
+}
+
+void FloatSparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
+{
+   const int nnz = I[height];
+   const int *Ip = HostRead(I, height+1);
+   const int *Jp = HostRead(J, nnz);
+   const float *Ap = HostRead(A, nnz);
+   double *yp = y.HostReadWrite();
+   const double *xp = x.HostRead();
+
+   if (Device::Allows(Backend::THREADS_MASK))
+   {
+      GetLevels().Forall([=](int i) { FloatGSRow(i, Ip, Jp, Ap, xp, yp); });
+      return;
+   }
+
+   for (int i = 0; i < height; i++)
+   {
+      FloatGSRow(i, Ip, Jp, Ap, xp, yp);
+   }
+}
+
+void FloatSparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
+{
+   const int nnz = I[height];
+   const int *Ip = HostRead(I, height+1);
+   const int *Jp = HostRead(J, nnz);
+   const float *Ap = HostRead(A, nnz);
+   double *yp = y.HostReadWrite();
+   const double *xp = x.HostRead();
+
+   if (Device::Allows(Backend::THREADS_MASK))
+   {
+      GetLevels().Forall([=](int i)
+      { FloatGSRow(i, Ip, Jp, Ap, xp, yp); }, true);
+      return;
+   }
+
+   for (int i = height-1; i >= 0; i--)
+   {
+      FloatGSRow(i, Ip, Jp, Ap, xp, yp);
+   }
+}
+
+
+void FloatGSSmoother::SetOperator(const Operator &a)
+{
+   oper = dynamic_cast<const FloatSparseMatrix*>(&a);
+   MFEM_VERIFY(oper != NULL, "the operator must be a FloatSparseMatrix");
+   height = oper->Height();
+   width = oper->Width();
+}
+
+void FloatGSSmoother::Mult(const Vector &x, Vector &y) const
+{
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   for (int i = 0; i < iterations; i++)
+   {
+      if (type != 2)
+      {
+         oper->Gauss_Seidel_forw(x, y);
+      }
+      if (type != 1)
+      {
+         oper->Gauss_Seidel_back(x, y);
+      }
+   }
+}
+
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_FLOATMAT
+#define MFEM_FLOATMAT
+
+#include "../config/config.hpp"
+#include "../general/mem_manager.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/// Single precision copy of a finalized SparseMatrix.
+/** The entries are stored as float, which halves the memory traffic of the
+    entries in the matrix-vector products and the Gauss-Seidel sweeps. The
+    input and output vectors, and the sums of the products, remain in double
+    precision.
+
+    The matrix is intended for the preconditioner side of a solver, see
+    FloatGSSmoother and SmoothedAggregationAMG::SetSinglePrecision(), while the
+    residual of the outer iteration is computed in double precision, e.g. with
+    a Krylov solver, SLISolver (iterative refinement) or FGMRESSolver when the
+    preconditioner is itself an inner iterative solver. */
+class FloatSparseMatrix : public Operator
+{
+protected:
+   /// Row offsets and column indices, as in the SparseMatrix.
+   Memory<int> I, J;
+   /// Entries, rounded to single precision.
+   Memory<float> A;
+
+   /// Level schedule of the threaded Gauss-Seidel sweeps. Owned.
+   mutable SparseLevelSchedule *Levels;
+
+   /// Return #Levels, building it on first use.
+   const SparseLevelSchedule &GetLevels() const;
+
+   void Destroy();
+
+public:
+   /// Copy the finalized SparseMatrix @a mat, rounding its entries to float.
+   explicit FloatSparseMatrix(const SparseMatrix &mat);
+
+   /// The arrays and the level schedule are owned, so copies are not allowed.
+   FloatSparseMatrix(const FloatSparseMatrix &) = delete;
+   FloatSparseMatrix &operator=(const FloatSparseMatrix &) = delete;
+
+   /// Return the number of stored entries.
+   int NumNonZeroElems() const { return I[height]; }
+
+   const int *GetI() const { return I; }
+   const int *GetJ() const { return J; }
+   const float *GetData() const { return A; }
+
+   /// Return the diagonal of the matrix in @a d.
+   void GetDiag(Vector &d) const;
+
+   /// Convert to a finalized SparseMatrix in double precision.
+   SparseMatrix *ToSparseMatrix() const;
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   /// Matrix vector multiplication y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = A^t x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// y += a A^t x, computed sequentially on the host.
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+
+   /// Gauss-Seidel forward and backward iterations over a vector x.
+   /** As in SparseMatrix::Gauss_Seidel_forw(), independent rows are processed
+       in parallel when Backend::THREADS is enabled. */
+   void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
+   void Gauss_Seidel_back(const Vector &x, Vector &y) const;
+
+   virtual ~FloatSparseMatrix() { Destroy(); }
+};
+
+
+/// Gauss-Seidel smoother of a FloatSparseMatrix, see GSSmoother.
+class FloatGSSmoother : public Solver
+{
+protected:
+   const FloatSparseMatrix *oper;
+   int type; // 0, 1, 2 - symmetric, forward, backward
+   int iterations;
+
+public:
+   /// Create FloatGSSmoother.
+   FloatGSSmoother(int t = 0, int it = 1)
+      : oper(NULL), type(t), iterations(it) { }
+
+   /// Create FloatGSSmoother.
+   FloatGSSmoother(const FloatSparseMatrix &a, int t = 0, int it = 1)
+      : Solver(a.Height()), oper(&a), type(t), iterations(it) { }
+
+   virtual void SetOperator(const Operator &a);
+
+   /// Matrix vector multiplication with GS Smoother.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+}
+
+#endif // MFEM_FLOATMAT
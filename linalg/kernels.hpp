@@ -1415,6 +1415,149 @@ inline void LUSolve(const double *data, const int m, const int *ipiv,
    }
 }
 
+/// Compute the inverse of a matrix (m x m) in place
+//
+// Gauss-Jordan elimination with partial pivoting; the row interchanges are
+// undone as column interchanges at the end.
+//
+// @param [in, out] data matrix A, overwritten by A^{-1}
+// @param [in] m square matrix height
+// @param [out] ipiv workspace of size m storing pivot information
+// @param [in] TOL fuzzy comparison tolerance of the pivots
+//
+// @return false if a pivot is not larger than TOL in absolute value
+MFEM_HOST_DEVICE
+inline bool GaussJordanInvert(double *data, const int m, int *ipiv,
+                              const double TOL = 0.0)
+{
+   bool ok = true;
+   for (int k = 0; k < m; k++)
+   {
+      int piv = k;
+      double a = fabs(data[k + k * m]);
+      for (int i = k + 1; i < m; i++)
+      {
+         const double b = fabs(data[i + k * m]);
+         if (b > a)
+         {
+            a = b;
+            piv = i;
+         }
+      }
+      ipiv[k] = piv;
+      if (piv != k)
+      {
+         for (int j = 0; j < m; j++)
+         {
+            internal::Swap<double>(data[k + j * m], data[piv + j * m]);
+         }
+      }
+      if (a <= TOL) { ok = false; }
+
+      // Scale row k, then eliminate column k from the other rows, column by
+      // column; the multipliers are kept in column k until it is updated
+      const double a_kk_inv = 1.0 / data[k + k * m];
+      data[k + k * m] = 1.0;
+      for (int j = 0; j < m; j++)
+      {
+         data[k + j * m] *= a_kk_inv;
+      }
+      for (int j = 0; j < m; j++)
+      {
+         if (j == k) { continue; }
+         const double a_kj = data[k + j * m];
+         for (int i = 0; i < k; i++)
+         {
+            data[i + j * m] -= data[i + k * m] * a_kj;
+         }
+         for (int i = k + 1; i < m; i++)
+         {
+            data[i + j * m] -= data[i + k * m] * a_kj;
+         }
+      }
+      for (int i = 0; i < m; i++)
+      {
+         if (i != k) { data[i + k * m] *= -a_kk_inv; }
+      }
+   }
+   for (int k = m - 1; k >= 0; k--)
+   {
+      const int piv = ipiv[k];
+      if (piv == k) { continue; }
+      for (int i = 0; i < m; i++)
+      {
+         internal::Swap<double>(data[i + k * m], data[i + piv * m]);
+      }
+   }
+   return ok;
+}
+
+/// Compute the Cholesky factorization A = L.L^t of a symmetric positive
+//  definite matrix (m x m) in place
+//
+// @param [in, out] data matrix A, overwritten by L with zero upper part
+// @param [in] m square matrix height
+// @param [in] TOL fuzzy comparison tolerance of the pivots
+//
+// @return false if a pivot is not larger than TOL
+MFEM_HOST_DEVICE
+inline bool CholeskyFactor(double *data, const int m, const double TOL = 0.0)
+{
+   bool ok = true;
+   for (int j = 0; j < m; j++)
+   {
+      double d = data[j + j * m];
+      for (int k = 0; k < j; k++)
+      {
+         d -= data[j + k * m] * data[j + k * m];
+      }
+      if (d <= TOL) { ok = false; }
+      const double l_jj = sqrt(d);
+      data[j + j * m] = l_jj;
+      for (int i = j + 1; i < m; i++)
+      {
+         double s = data[i + j * m];
+         for (int k = 0; k < j; k++)
+         {
+            s -= data[i + k * m] * data[j + k * m];
+         }
+         data[i + j * m] = s / l_jj;
+         data[j + i * m] = 0.0;
+      }
+   }
+   return ok;
+}
+
+/// Assuming L.L^t = A for a factored matrix (m x m), compute x <- A^{-1} x
+//
+// @param [in] data Cholesky factor L of A
+// @param [in] m square matrix height
+// @param [in, out] x vector storing right-hand side and then solution
+MFEM_HOST_DEVICE
+inline void CholeskySolve(const double *data, const int m, double *x)
+{
+   // X <- L^{-1} X
+   for (int j = 0; j < m; j++)
+   {
+      const double x_j = (x[j] /= data[j + j * m]);
+      for (int i = j + 1; i < m; i++)
+      {
+         x[i] -= data[i + j * m] * x_j;
+      }
+   }
+
+   // X <- L^{-t} X
+   for (int i = m - 1; i >= 0; i--)
+   {
+      double x_i = x[i];
+      for (int j = i + 1; j < m; j++)
+      {
+         x_i -= data[j + i * m] * x[j];
+      }
+      x[i] = x_i / data[i + i * m];
+   }
+}
+
 } // namespace kernels
 
 } // namespace mfem
@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "multivector.hpp"
+#include "densemat.hpp"
+#include "../general/forall.hpp"
+#include <algorithm>
+
+namespace mfem
+{
+
+MultiVector &MultiVector::operator=(const MultiVector &mv)
+{
+   Vector::operator=(mv);
+   vsize = mv.vsize;
+   nvec = mv.nvec;
+   return *this;
+}
+
+void MultiVector::CopyVector(int i, MultiVector &y, int j) const
+{
+   MFEM_ASSERT(y.vsize == vsize, "incompatible vector sizes");
+   Vector xi, yj;
+   GetVectorView(i, xi);
+   y.GetVectorView(j, yj);
+   yj = xi;
+}
+
+void MultiVector::InnerProducts(const MultiVector &Y, DenseMatrix &G) const
+{
+   MFEM_ASSERT(Y.vsize == vsize, "incompatible vector sizes");
+   const int N = vsize, nx = nvec, ny = Y.nvec;
+   G.SetSize(nx, ny);
+   if (Device::IsEnabled() && (UseDevice() || Y.UseDevice()))
+   {
+      Vector xi, yj;
+      for (int j = 0; j < ny; j++)
+      {
+         Y.GetVectorView(j, yj);
+         for (int i = 0; i < nx; i++)
+         {
+            GetVectorView(i, xi);
+            G(i,j) = xi * yj;
+         }
+      }
+      return;
+   }
+   const int block = 512;
+   const double *x_data = HostRead();
+   const double *y_data = Y.HostRead();
+   G = 0.0;
+   for (int k0 = 0; k0 < N; k0 += block)
+   {
+      const int k1 = std::min(k0 + block, N);
+      for (int j = 0; j < ny; j++)
+      {
+         const double *yj = y_data + j*N;
+         for (int i = 0; i < nx; i++)
+         {
+            const double *xi = x_data + i*N;
+            double dot = 0.0;
+            for (int k = k0; k < k1; k++) { dot += xi[k] * yj[k]; }
+            G(i,j) += dot;
+         }
+      }
+   }
+}
+
+void MultiVector::ColumnInnerProducts(const MultiVector &Y, Vector &d) const
+{
+   MFEM_ASSERT(Y.vsize == vsize && Y.nvec == nvec,
+               "incompatible MultiVector sizes");
+   d.SetSize(nvec);
+   Vector xj, yj;
+   for (int j = 0; j < nvec; j++)
+   {
+      GetVectorView(j, xj);
+      Y.GetVectorView(j, yj);
+      d(j) = xj * yj;
+   }
+}
+
+void MultiVector::AddMult(const DenseMatrix &C, MultiVector &Y,
+                          double a) const
+{
+   MFEM_ASSERT(Y.vsize == vsize, "incompatible vector sizes");
+   MFEM_ASSERT(C.Height() == nvec && C.Width() == Y.nvec,
+               "incompatible matrix size");
+   const int N = vsize, nx = nvec, ny = Y.nvec;
+   const bool use_dev = UseDevice() || Y.UseDevice();
+   const auto d_C = C.Read(use_dev);
+   const auto d_x = Read(use_dev);
+   auto d_y = Y.ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, k, N,
+   {
+      for (int j = 0; j < ny; j++)
+      {
+         double s = 0.0;
+         for (int i = 0; i < nx; i++)
+         {
+            s += d_x[k + i*N] * d_C[i + j*nx];
+         }
+         d_y[k + j*N] += a * s;
+      }
+   });
+}
+
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_MULTIVECTOR
+#define MFEM_MULTIVECTOR
+
+#include "../config/config.hpp"
+#include "vector.hpp"
+
+namespace mfem
+{
+
+class DenseMatrix;
+
+/** @brief A set of vectors of the same size, stored contiguously one after the
+    other (i.e. as the columns of a column-major matrix). */
+/** All data is contained in Vector::data, so the Vector methods (assignment,
+    norms, device access, etc.) act on all vectors at once. Operators can apply
+    to all vectors together with Operator::MultiMult(), which allows them to
+    read their data (e.g. the entries of a SparseMatrix) only once. */
+class MultiVector : public Vector
+{
+protected:
+   int vsize; ///< Size of each vector.
+   int nvec;  ///< Number of vectors.
+
+public:
+   /// Create an empty MultiVector.
+   MultiVector() : vsize(0), nvec(0) { }
+
+   /// Create a MultiVector of @a nvec vectors of size @a vsize.
+   MultiVector(int vsize_, int nvec_)
+      : Vector(vsize_*nvec_), vsize(vsize_), nvec(nvec_) { }
+
+   /// Create a MultiVector with the given MemoryType @a mt.
+   MultiVector(int vsize_, int nvec_, MemoryType mt)
+      : Vector(vsize_*nvec_, mt), vsize(vsize_), nvec(nvec_) { }
+
+   /// Copy assignment; the sizes of @a *this are set to the sizes of @a mv.
+   MultiVector &operator=(const MultiVector &mv);
+
+   /// Set all entries to @a value.
+   MultiVector &operator=(double value)
+   { Vector::operator=(value); return *this; }
+
+   /// Resize to @a nvec_ vectors of size @a vsize_.
+   /** As with Vector::SetSize(), the data is preserved when the total size
+       does not grow, so vectors 0,...,nvec_-1 keep their values if @a vsize_
+       does not change. */
+   void SetSize(int vsize_, int nvec_)
+   { Vector::SetSize(vsize_*nvec_); vsize = vsize_; nvec = nvec_; }
+
+   /// Resize using the MemoryType @a mt, see Vector::SetSize(int, MemoryType).
+   void SetSize(int vsize_, int nvec_, MemoryType mt)
+   { Vector::SetSize(vsize_*nvec_, mt); vsize = vsize_; nvec = nvec_; }
+
+   /** @brief Make this MultiVector a reference to the first
+       @a vsize_ * @a nvec_ entries of @a base. */
+   void MakeRef(Vector &base, int vsize_, int nvec_)
+   { Vector::MakeRef(base, 0, vsize_*nvec_); vsize = vsize_; nvec = nvec_; }
+
+   /// Swap the contents and the sizes of two MultiVectors.
+   void Swap(MultiVector &other)
+   {
+      Vector::Swap(other);
+      mfem::Swap(vsize, other.vsize);
+      mfem::Swap(nvec, other.nvec);
+   }
+
+   /// Return the size of each vector.
+   int VectorSize() const { return vsize; }
+
+   /// Return the number of vectors.
+   int NumVectors() const { return nvec; }
+
+   /// Set @a v to be a reference to the vector @a j.
+   void GetVectorView(int j, Vector &v)
+   { v.MakeRef(*this, j*vsize, vsize); }
+
+   /// Set @a v to be a reference to the vector @a j (const version).
+   void GetVectorView(int j, Vector &v) const
+   { v.MakeRef(const_cast<MultiVector&>(*this), j*vsize, vsize); }
+
+   /// Copy the vector @a i of @a *this into the vector @a j of @a y.
+   void CopyVector(int i, MultiVector &y, int j) const;
+
+   /** @brief Compute the local inner products G(i,j) = (X_i, Y_j) of all
+       vectors X_i of @a *this with all vectors Y_j of @a Y. */
+   /** In parallel, the result has to be summed over all processors. On the
+       host, the vectors are traversed in blocks of entries, so that every
+       block of @a Y is loaded once. */
+   void InnerProducts(const MultiVector &Y, DenseMatrix &G) const;
+
+   /** @brief Compute the local inner products d(j) = (X_j, Y_j) of the
+       corresponding vectors of @a *this and @a Y. */
+   void ColumnInnerProducts(const MultiVector &Y, Vector &d) const;
+
+   /** @brief Compute Y += a X C, where the vectors of @a *this are the columns
+       of X and C is a small dense matrix of size NumVectors() x
+       Y.NumVectors(). */
+   void AddMult(const DenseMatrix &C, MultiVector &Y, double a = 1.0) const;
+};
+
+}
+
+#endif // MFEM_MULTIVECTOR
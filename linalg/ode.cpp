@@ -11,6 +11,8 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include "../general/forall.hpp"
+#include <cmath>
 
 namespace mfem
 {
@@ -142,6 +144,7 @@ ExplicitRKSolver::ExplicitRKSolver(int _s, const double *_a, const double *_b,
    a = _a;
    b = _b;
    c = _c;
+   adt = new double[s];
    k = new Vector[s];
 }
 
@@ -170,25 +173,27 @@ void ExplicitRKSolver::Step(Vector &x, double &t, double &dt)
    f->Mult(x, k[0]);
    for (int l = 0, i = 1; i < s; i++)
    {
-      add(x, a[l++]*dt, k[0], y);
-      for (int j = 1; j < i; j++)
+      for (int j = 0; j < i; j++)
       {
-         y.Add(a[l++]*dt, k[j]);
+         adt[j] = a[l++]*dt;
       }
+      add(x, i, adt, k, y);
 
       f->SetTime(t + c[i-1]*dt);
       f->Mult(y, k[i]);
    }
    for (int i = 0; i < s; i++)
    {
-      x.Add(b[i]*dt, k[i]);
+      adt[i] = b[i]*dt;
    }
+   add(x, s, adt, k, x);
    t += dt;
 }
 
 ExplicitRKSolver::~ExplicitRKSolver()
 {
    delete [] k;
+   delete [] adt;
 }
 
 const double RK6Solver::a[] =
@@ -344,6 +349,150 @@ const double RK8Solver::c[] =
 };
 
 
+void LowStorageRK2NSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   dq.SetSize(n, mem_type);
+   k.SetSize(n, mem_type);
+}
+
+void LowStorageRK2NSolver::Step(Vector &x, double &t, double &dt)
+{
+   const int n = x.Size();
+   const bool use_dev = x.UseDevice() || k.UseDevice();
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + c[i]*dt);
+      f->Mult(x, k);
+
+      const double Ai = A[i], Bi = B[i], dti = dt;
+      const bool first = (i == 0);
+      auto d_k = k.Read(use_dev);
+      auto d_dq = first ? dq.Write(use_dev) : dq.ReadWrite(use_dev);
+      auto d_x = x.ReadWrite(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, j, n,
+      {
+         const double dqj = (first ? 0.0 : Ai*d_dq[j]) + dti*d_k[j];
+         d_dq[j] = dqj;
+         d_x[j] += Bi*dqj;
+      });
+   }
+   t += dt;
+}
+
+const double LowStorageRK3Solver::A[] = { 0., -5./9, -153./128 };
+const double LowStorageRK3Solver::B[] = { 1./3, 15./16, 8./15 };
+const double LowStorageRK3Solver::c[] = { 0., 1./3, 3./4 };
+
+const double LowStorageRK4Solver::A[] =
+{
+   0.,
+   -567301805773./1357537059087,
+   -2404267990393./2016746695238,
+   -3550918686646./2091501179385,
+   -1275806237668./842570457699
+};
+const double LowStorageRK4Solver::B[] =
+{
+   1432997174477./9575080441755,
+   5161836677717./13612068292357,
+   1720146321549./2090206949498,
+   3134564353537./4481467310338,
+   2277821191437./14882151754819
+};
+const double LowStorageRK4Solver::c[] =
+{
+   0.,
+   1432997174477./9575080441755,
+   2526269341429./6820363962896,
+   2006345519317./3224310063776,
+   2802321613138./2924317926251
+};
+
+
+LowStorageRK3SSolver::LowStorageRK3SSolver(
+   int _s, const double *_delta, const double *_gamma1, const double *_gamma2,
+   const double *_gamma3, const double *_beta, const double *_c)
+   : s(_s), delta(_delta), gamma1(_gamma1), gamma2(_gamma2),
+     gamma3(_gamma3), beta(_beta), c(_c)
+{
+   use_S2 = use_S3 = false;
+   for (int i = 0; i < s; i++)
+   {
+      use_S2 = use_S2 || (delta[i] != 0.0);
+      use_S3 = use_S3 || (gamma3[i] != 0.0);
+   }
+}
+
+void LowStorageRK3SSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   if (use_S2) { S2.SetSize(n, mem_type); }
+   if (use_S3) { S3.SetSize(n, mem_type); }
+   k.SetSize(n, mem_type);
+}
+
+void LowStorageRK3SSolver::Step(Vector &x, double &t, double &dt)
+{
+   if (use_S2) { S2 = 0.0; }
+   if (use_S3) { S3 = x; }
+
+   const int n = x.Size();
+   const bool use_dev = x.UseDevice() || k.UseDevice();
+   const bool s2 = use_S2, s3 = use_S3;
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + c[i]*dt);
+      f->Mult(x, k);
+
+      const double d = delta[i], g1 = gamma1[i], g2 = gamma2[i];
+      const double g3 = gamma3[i], bdt = beta[i]*dt;
+      auto d_k = k.Read(use_dev);
+      auto d_S2 = s2 ? S2.ReadWrite(use_dev) : NULL;
+      auto d_S3 = s3 ? S3.Read(use_dev) : NULL;
+      auto d_x = x.ReadWrite(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, j, n,
+      {
+         double xj = g1*d_x[j] + bdt*d_k[j];
+         if (s2)
+         {
+            const double S2j = d_S2[j] + d*d_x[j];
+            d_S2[j] = S2j;
+            xj += g2*S2j;
+         }
+         if (s3) { xj += g3*d_S3[j]; }
+         d_x[j] = xj;
+      });
+   }
+   t += dt;
+}
+
+// The method of Kraaijevanger, with the low-storage form of Ketcheson
+const double SSPRK43Solver::delta[] = { 0., 0., 0., 0. };
+const double SSPRK43Solver::gamma1[] = { 1., 1., 1./3, 1. };
+const double SSPRK43Solver::gamma2[] = { 0., 0., 0., 0. };
+const double SSPRK43Solver::gamma3[] = { 0., 0., 2./3, 0. };
+const double SSPRK43Solver::beta[] = { 1./2, 1./2, 1./6, 1./2 };
+const double SSPRK43Solver::c[] = { 0., 1./2, 1., 1./2 };
+
+// Ketcheson's two-register implementation of SSPRK(10,4), rewritten with the
+// intermediate combinations folded into the 3S* stages
+const double SSPRK104Solver::delta[] =
+{ 0., 0., 0., 0., 0., 9./10, 0., 0., 0., 0. };
+const double SSPRK104Solver::gamma1[] =
+{ 1., 1., 1., 1., 2./5, 1., 1., 1., 1., 3./5 };
+const double SSPRK104Solver::gamma2[] =
+{ 0., 0., 0., 0., 0., 0., 0., 0., 0., 1. };
+const double SSPRK104Solver::gamma3[] =
+{ 0., 0., 0., 0., 3./5, 0., 0., 0., 0., -1./2 };
+const double SSPRK104Solver::beta[] =
+{ 1./6, 1./6, 1./6, 1./6, 1./15, 1./6, 1./6, 1./6, 1./6, 1./10 };
+const double SSPRK104Solver::c[] =
+{ 0., 1./6, 1./3, 1./2, 2./3, 1./3, 1./2, 2./3, 5./6, 1. };
+
+
 AdamsBashforthSolver::AdamsBashforthSolver(int _s, const double *_a)
 {
    s = 0;
@@ -634,6 +783,581 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 }
 
 
+ODEWRMSNorm::ODEWRMSNorm(double rtol_, double atol_)
+   : rtol(rtol_), atol(atol_)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+ODEWRMSNorm::ODEWRMSNorm(MPI_Comm comm_, double rtol_, double atol_)
+   : rtol(rtol_), atol(atol_), comm(comm_) { }
+#endif
+
+double ODEWRMSNorm::Eval(const Vector &err, const Vector &x0,
+                         const Vector &x1) const
+{
+   const int n = err.Size();
+   const double *ep = err.HostRead();
+   const double *x0p = x0.HostRead(), *x1p = x1.HostRead();
+   double sum[2] = { 0.0, double(n) };
+   for (int i = 0; i < n; i++)
+   {
+      const double w = atol + rtol*std::max(fabs(x0p[i]), fabs(x1p[i]));
+      const double ei = ep[i]/w;
+      sum[0] += ei*ei;
+   }
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (sum[1] > 0.0) ? sqrt(sum[0]/sum[1]) : 0.0;
+}
+
+
+AdaptiveODESolver::AdaptiveODESolver(int k)
+   : norm(&default_norm), k_est(k), safety(0.9), kI(0.3), kP(0.4),
+     min_factor(0.2), max_factor(5.0), max_rejections(50),
+     err_prev(1.0), last_dt(0.0), num_accepted(0), num_rejected(0) { }
+
+void AdaptiveODESolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   x1.SetSize(f->Width(), mem_type);
+   err.SetSize(f->Width(), mem_type);
+   err_prev = 1.0;
+   last_dt = 0.0;
+   num_accepted = num_rejected = 0;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   // Error norms below this value do not increase the step further
+   const double min_err = 1e-10;
+   for (int r = 0; true; r++)
+   {
+      MFEM_VERIFY(dt > 0.0 && t + dt > t, "invalid time step: " << dt);
+      TryStep(x, t, dt);
+      double e = norm->Eval(err, x, x1);
+
+      if (e <= 1.0)
+      {
+         e = std::max(e, min_err);
+         double factor = safety*pow(e, -kI/k_est)*pow(err_prev/e, kP/k_est);
+         factor = std::min(std::max(factor, min_factor),
+                           (r == 0) ? max_factor : 1.0);
+         err_prev = e;
+         x = x1;
+         AcceptStep();
+         t += dt;
+         last_dt = dt;
+         dt *= factor;
+         num_accepted++;
+         return;
+      }
+
+      num_rejected++;
+      MFEM_VERIFY(r < max_rejections, "the time step was rejected "
+                  << r+1 << " times, the last step size was " << dt);
+      // Classical controller after a rejection; a NaN error gives min_factor
+      const double factor = safety*pow(e, -1.0/k_est);
+      dt *= (factor > min_factor) ? std::min(factor, 1.0) : min_factor;
+   }
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                                   const double *_e, const double *_c, int _k,
+                                   bool _fsal)
+   : AdaptiveODESolver(_k), s(_s), a(_a), b(_b), e(_e), c(_c), fsal(_fsal),
+     k0_valid(false), k0_t(0.0), t1(0.0)
+{
+   adt = new double[s];
+   k = new Vector[s];
+}
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void EmbeddedRKSolver::TryStep(const Vector &x, double t, double dt)
+{
+   // The caller may have changed the time since the step that computed k[0];
+   // a change of the solution requires Reset()
+   if (fsal && t != k0_t) { k0_valid = false; }
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_t = t;
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      for (int j = 0; j < i; j++)
+      {
+         adt[j] = a[l++]*dt;
+      }
+      add(x, i, adt, k, y);
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(y, k[i]);
+   }
+   for (int i = 0; i < s; i++)
+   {
+      adt[i] = b[i]*dt;
+   }
+   add(x, s, adt, k, x1);
+   for (int i = 0; i < s; i++)
+   {
+      adt[i] = e[i]*dt;
+   }
+   err = 0.0;
+   add(err, s, adt, k, err);
+   t1 = t + dt;
+}
+
+void EmbeddedRKSolver::AcceptStep()
+{
+   if (fsal)
+   {
+      // The last stage was evaluated at the new solution
+      k[0].Swap(k[s-1]);
+      k0_t = t1;
+   }
+   else
+   {
+      k0_valid = false;
+   }
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+   delete [] adt;
+}
+
+//   0   |
+//  1/2  | 1/2
+//  3/4  |  0   3/4
+//   1   | 2/9  1/3  4/9
+// ------+---------------------
+//       | 2/9  1/3  4/9   0
+//       | 7/24 1/4  1/3  1/8   (embedded)
+const double BogackiShampineSolver::a[] =
+{
+   1./2,
+   0., 3./4,
+   2./9, 1./3, 4./9
+};
+const double BogackiShampineSolver::b[] = { 2./9, 1./3, 4./9, 0. };
+const double BogackiShampineSolver::e[] =
+{ 2./9 - 7./24, 1./3 - 1./4, 4./9 - 1./3, -1./8 };
+const double BogackiShampineSolver::c[] = { 1./2, 3./4, 1. };
+
+const double DormandPrinceSolver::a[] =
+{
+   1./5,
+   3./40, 9./40,
+   44./45, -56./15, 32./9,
+   19372./6561, -25360./2187, 64448./6561, -212./729,
+   9017./3168, -355./33, 46732./5247, 49./176, -5103./18656,
+   35./384, 0., 500./1113, 125./192, -2187./6784, 11./84
+};
+const double DormandPrinceSolver::b[] =
+{ 35./384, 0., 500./1113, 125./192, -2187./6784, 11./84, 0. };
+const double DormandPrinceSolver::e[] =
+{
+   35./384 - 5179./57600,
+   0.,
+   500./1113 - 7571./16695,
+   125./192 - 393./640,
+   -2187./6784 + 92097./339200,
+   11./84 - 187./2100,
+   -1./40
+};
+const double DormandPrinceSolver::c[] =
+{ 1./5, 3./10, 4./5, 8./9, 1., 1. };
+
+
+EmbeddedSDIRKSolver::EmbeddedSDIRKSolver(int _s, double _gamma,
+                                         const double *_a, const double *_b,
+                                         const double *_e, const double *_c,
+                                         int _k)
+   : AdaptiveODESolver(_k), s(_s), gamma(_gamma), a(_a), b(_b), e(_e), c(_c)
+{
+   adt = new double[s];
+   k = new Vector[s];
+}
+
+void EmbeddedSDIRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+}
+
+void EmbeddedSDIRKSolver::TryStep(const Vector &x, double t, double dt)
+{
+   for (int l = 0, i = 0; i < s; i++)
+   {
+      for (int j = 0; j < i; j++)
+      {
+         adt[j] = a[l++]*dt;
+      }
+      add(x, i, adt, k, y);
+
+      // k[i] = f(y + gamma dt k[i], t + c[i] dt)
+      f->SetTime(t + c[i]*dt);
+      f->ImplicitSolve(gamma*dt, y, k[i]);
+   }
+   for (int i = 0; i < s; i++)
+   {
+      adt[i] = b[i]*dt;
+   }
+   add(x, s, adt, k, x1);
+   for (int i = 0; i < s; i++)
+   {
+      adt[i] = e[i]*dt;
+   }
+   err = 0.0;
+   add(err, s, adt, k, err);
+}
+
+EmbeddedSDIRKSolver::~EmbeddedSDIRKSolver()
+{
+   delete [] k;
+   delete [] adt;
+}
+
+//  1/4   | 1/4
+//  3/4   | 1/2         1/4
+// 11/20  | 17/50      -1/25       1/4
+//  1/2   | 371/1360  -137/2720  15/544   1/4
+//   1    | 25/24     -49/48     125/16  -85/12  1/4
+// -------+--------------------------------------------
+//        | 25/24     -49/48     125/16  -85/12  1/4
+//        | 59/48     -17/96     225/32  -85/12   0    (embedded)
+const double HairerWannerSDIRKSolver::a[] =
+{
+   1./2,
+   17./50, -1./25,
+   371./1360, -137./2720, 15./544,
+   25./24, -49./48, 125./16, -85./12
+};
+const double HairerWannerSDIRKSolver::b[] =
+{ 25./24, -49./48, 125./16, -85./12, 1./4 };
+const double HairerWannerSDIRKSolver::e[] =
+{ 25./24 - 59./48, -49./48 + 17./96, 125./16 - 225./32, 0., 1./4 };
+const double HairerWannerSDIRKSolver::c[] =
+{ 1./4, 3./4, 11./20, 1./2, 1. };
+
+
+IMEXRKSolver::IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                           const double *_be, const double *_bi,
+                           const double *_c)
+   : s(_s), ae(_ae), ai(_ai), be(_be), bi(_bi), c(_c)
+{
+   // Skip the evaluations of the stages that are not used
+   use_ke.SetSize(s);
+   use_ki.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      use_ke[j] = (be[j] != 0.0);
+      use_ki[j] = (bi[j] != 0.0);
+      for (int i = j+1; i < s; i++)
+      {
+         use_ke[j] = use_ke[j] || (ae[i*(i-1)/2+j] != 0.0);
+         use_ki[j] = use_ki[j] || (ai[i*(i+1)/2+j] != 0.0);
+      }
+   }
+   adt = new double[2*s];
+   k = new Vector[2*s];
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < 2*s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   Vector *ke = k, *ki = k + s;
+   for (int i = 0; i < s; i++)
+   {
+      for (int j = 0; j < s; j++)
+      {
+         adt[j] = (j < i) ? ae[i*(i-1)/2+j]*dt : 0.0;
+         adt[s+j] = (j < i) ? ai[i*(i+1)/2+j]*dt : 0.0;
+      }
+      add(x, 2*s, adt, k, y);
+
+      const double gdt = ai[i*(i+1)/2+i]*dt;
+      f->SetTime(t + c[i]*dt);
+      if (gdt != 0.0)
+      {
+         // ki[i] = f2(y + gdt ki[i]), the stage value is y + gdt ki[i]
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->ImplicitSolve(gdt, y, ki[i]);
+         if (use_ke[i]) { y.Add(gdt, ki[i]); }
+      }
+      else if (use_ki[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->Mult(y, ki[i]);
+      }
+      if (use_ke[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+         f->Mult(y, ke[i]);
+      }
+   }
+   for (int j = 0; j < s; j++)
+   {
+      adt[j] = be[j]*dt;
+      adt[s+j] = bi[j]*dt;
+   }
+   add(x, 2*s, adt, k, x);
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] k;
+   delete [] adt;
+}
+
+const double IMEXEulerSolver::ae[] = { 1. };
+const double IMEXEulerSolver::ai[] = { 0., 0., 1. };
+const double IMEXEulerSolver::be[] = { 1., 0. };
+const double IMEXEulerSolver::bi[] = { 0., 1. };
+const double IMEXEulerSolver::c[] = { 0., 1. };
+
+// gamma = 1 - 1/sqrt(2), delta = 1 - 1/(2 gamma) = -1/sqrt(2)
+const double ARS222Solver::ae[] =
+{
+   .2928932188134524755991556378951509607152,
+   -.7071067811865475244008443621048490392848,
+   1.707106781186547524400844362104849039285
+};
+const double ARS222Solver::ai[] =
+{
+   0.,
+   0., .2928932188134524755991556378951509607152,
+   0., .7071067811865475244008443621048490392848,
+   .2928932188134524755991556378951509607152
+};
+const double ARS222Solver::be[] =
+{
+   -.7071067811865475244008443621048490392848,
+   1.707106781186547524400844362104849039285,
+   0.
+};
+const double ARS222Solver::bi[] =
+{
+   0.,
+   .7071067811865475244008443621048490392848,
+   .2928932188134524755991556378951509607152
+};
+const double ARS222Solver::c[] =
+{ 0., .2928932188134524755991556378951509607152, 1. };
+
+const double ARS443Solver::ae[] =
+{
+   1./2,
+   11./18, 1./18,
+   5./6, -5./6, 1./2,
+   1./4, 7./4, 3./4, -7./4
+};
+const double ARS443Solver::ai[] =
+{
+   0.,
+   0., 1./2,
+   0., 1./6, 1./2,
+   0., -1./2, 1./2, 1./2,
+   0., 3./2, -3./2, 1./2, 1./2
+};
+const double ARS443Solver::be[] = { 1./4, 7./4, 3./4, -7./4, 0. };
+const double ARS443Solver::bi[] = { 0., 3./2, -3./2, 1./2, 1./2 };
+const double ARS443Solver::c[] = { 0., 1./2, 2./3, 1./2, 1. };
+
+const double ARK324L2SASolver::ae[] =
+{
+   1767732205903./2027836641118,
+   5535828885825./10492691773637, 788022342437./10882634858940,
+   6485989280629./16251701735622, -4246266847089./9704473918619,
+   10755448449292./10357097424841
+};
+const double ARK324L2SASolver::ai[] =
+{
+   0.,
+   1767732205903./4055673282236, 1767732205903./4055673282236,
+   2746238789719./10658868560708, -640167445237./6845629431997,
+   1767732205903./4055673282236,
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK324L2SASolver::b[] =
+{
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK324L2SASolver::c[] =
+{ 0., 1767732205903./2027836641118, 3./5, 1. };
+
+const double ARK436L2SASolver::ae[] =
+{
+   1./2,
+   13861./62500, 6889./62500,
+   -116923316275./2393684061468, -2731218467317./15368042101831,
+   9408046702089./11113171139209,
+   -451086348788./2902428689909, -2682348792572./7519795681897,
+   12662868775082./11960479115383, 3355817975965./11060851509271,
+   647845179188./3216320057751, 73281519250./8382639484533,
+   552539513391./3454668386233, 3354512671639./8306763924573, 4040./17871
+};
+const double ARK436L2SASolver::ai[] =
+{
+   0.,
+   1./4, 1./4,
+   8611./62500, -1743./31250, 1./4,
+   5012029./34652500, -654441./2922500, 174375./388108, 1./4,
+   15267082809./155376265600, -71443401./120774400, 730878875./902184768,
+   2285395./8070912, 1./4,
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK436L2SASolver::b[] =
+{ 82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4 };
+const double ARK436L2SASolver::c[] =
+{ 0., 1./2, 83./250, 31./50, 17./20, 1. };
+
+
+BDFEXTSolver::BDFEXTSolver(int _order)
+   : order(_order), num_steps(0), dt_prev(0.0), startup(NULL)
+{
+   MFEM_VERIFY(1 <= order && order <= 3, "invalid order: " << order);
+   adt = new double[2*order];
+   v = new Vector[2*order];
+}
+
+void BDFEXTSolver::GetCoefficients(int q, double *bd, double *ab)
+{
+   switch (q)
+   {
+      case 1:
+         bd[0] = 1.; bd[1] = -1.; bd[2] = 0.; bd[3] = 0.;
+         ab[0] = 1.; ab[1] = 0.; ab[2] = 0.;
+         break;
+      case 2:
+         bd[0] = 3./2; bd[1] = -2.; bd[2] = 1./2; bd[3] = 0.;
+         ab[0] = 2.; ab[1] = -1.; ab[2] = 0.;
+         break;
+      case 3:
+         bd[0] = 11./6; bd[1] = -3.; bd[2] = 3./2; bd[3] = -1./3;
+         ab[0] = 3.; ab[1] = -3.; ab[2] = 1.;
+         break;
+      default:
+         MFEM_ABORT("invalid order: " << q);
+   }
+}
+
+void BDFEXTSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   k.SetSize(n, mem_type);
+   for (int i = 0; i < 2*order; i++)
+   {
+      v[i].SetSize(n, mem_type);
+   }
+   if (startup) { startup->Init(_f); }
+   num_steps = 0;
+}
+
+void BDFEXTSolver::Step(Vector &x, double &t, double &dt)
+{
+   MFEM_VERIFY(num_steps == 0 || fabs(dt - dt_prev) <= 1e-12*dt_prev,
+               "the time step must be constant, call Init() to change it");
+   const int q = std::min(num_steps + 1, order);
+
+   // Shift the history by one step; with order 1, x_n is not needed
+   Vector *X = v, *F = v + order;
+   for (int j = order-1; j > 0; j--)
+   {
+      X[j].Swap(X[j-1]);
+      F[j].Swap(F[j-1]);
+   }
+   if (order > 1) { X[0] = x; }
+   f->SetTime(t);
+   f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+   f->Mult(x, F[0]);
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+
+   if (startup && q < order)
+   {
+      startup->Step(x, t, dt);
+      num_steps++;
+      dt_prev = dt;
+      return;
+   }
+
+   // y = -(bd[1] x_n + ... + bd[q] x_{n+1-q})/bd[0]
+   //     + dt/bd[0] (ab[0] f1(x_n) + ... + ab[q-1] f1(x_{n+1-q}))
+   // with x_n as the base of the sum
+   double bd[4], ab[3];
+   GetCoefficients(q, bd, ab);
+   for (int j = 0; j < order; j++)
+   {
+      adt[j] = (j < q) ? -bd[j+1]/bd[0] : 0.0;
+      adt[order+j] = (j < q) ? ab[j]*dt/bd[0] : 0.0;
+   }
+   adt[0] -= 1.0;
+   add(x, 2*order, adt, v, y);
+
+   // x_{n+1} = y + dt/bd[0] k, k = f2(x_{n+1})
+   const double gdt = dt/bd[0];
+   f->SetTime(t + dt);
+   f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+   f->ImplicitSolve(gdt, y, k);
+   add(y, gdt, k, x);
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+
+   num_steps++;
+   dt_prev = dt;
+   t += dt;
+}
+
+BDFEXTSolver::~BDFEXTSolver()
+{
+   delete [] v;
+   delete [] adt;
+}
+
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -15,6 +15,10 @@
 #include "../config/config.hpp"
 #include "operator.hpp"
 
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace mfem
 {
 
@@ -168,9 +172,12 @@ class ExplicitRKSolver : public ODESolver
 private:
    int s;
    const double *a, *b, *c;
+   double *adt;
    Vector y, *k;
 
 public:
+   /** The stage inputs and the final update are each computed in a single
+       pass over memory, with the fused add(x, n, a, v, y). */
    ExplicitRKSolver(int _s, const double *_a, const double *_b,
                     const double *_c);
 
@@ -206,6 +213,114 @@ public:
 };
 
 
+/** A low-storage explicit Runge-Kutta method in the 2N form of Williamson:
+    @verbatim
+    for i = 0, ..., s-1
+       dq = A[i] dq + dt f(t + c[i] dt, x)
+       x  = x + B[i] dq
+    @endverbatim
+    with A[0] = 0. Besides the solution, only dq and one vector for the action
+    of f are stored, independently of the number of stages, and the two
+    updates of every stage are done in a single pass over memory. */
+class LowStorageRK2NSolver : public ODESolver
+{
+private:
+   int s;
+   const double *A, *B, *c;
+   Vector dq, k;
+
+public:
+   LowStorageRK2NSolver(int _s, const double *_A, const double *_B,
+                        const double *_c)
+      : s(_s), A(_A), B(_B), c(_c) { }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/// Williamson's 3-stage, 3rd order 2N method.
+class LowStorageRK3Solver : public LowStorageRK2NSolver
+{
+private:
+   static const double A[3], B[3], c[3];
+
+public:
+   LowStorageRK3Solver() : LowStorageRK2NSolver(3, A, B, c) { }
+};
+
+
+/** The 5-stage, 4th order 2N method of Carpenter and Kennedy, which has a
+    larger stability region per stage than RK4Solver. */
+class LowStorageRK4Solver : public LowStorageRK2NSolver
+{
+private:
+   static const double A[5], B[5], c[5];
+
+public:
+   LowStorageRK4Solver() : LowStorageRK2NSolver(5, A, B, c) { }
+};
+
+
+/** A low-storage explicit Runge-Kutta method in the 3S* form of Ketcheson,
+    with x = S1 and the registers S2 = 0 and S3 = x at the start of the step:
+    @verbatim
+    for i = 0, ..., s-1
+       S2 = S2 + delta[i] S1
+       S1 = gamma1[i] S1 + gamma2[i] S2 + gamma3[i] S3
+            + beta[i] dt f(t + c[i] dt, S1)
+    @endverbatim
+    The register S2 is only stored when some delta[i] is nonzero and S3 only
+    when some gamma3[i] is nonzero. The updates of every stage are done in a
+    single pass over memory. */
+class LowStorageRK3SSolver : public ODESolver
+{
+private:
+   int s;
+   const double *delta, *gamma1, *gamma2, *gamma3, *beta, *c;
+   bool use_S2, use_S3;
+   Vector S2, S3, k;
+
+public:
+   LowStorageRK3SSolver(int _s, const double *_delta, const double *_gamma1,
+                        const double *_gamma2, const double *_gamma3,
+                        const double *_beta, const double *_c);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/** The 4-stage, 3rd order strong stability preserving method with SSP
+    coefficient 2, which needs only the register S3. */
+class SSPRK43Solver : public LowStorageRK3SSolver
+{
+private:
+   static const double delta[4], gamma1[4], gamma2[4], gamma3[4], beta[4],
+          c[4];
+
+public:
+   SSPRK43Solver()
+      : LowStorageRK3SSolver(4, delta, gamma1, gamma2, gamma3, beta, c) { }
+};
+
+
+/** Ketcheson's 10-stage, 4th order strong stability preserving method with
+    SSP coefficient 6. */
+class SSPRK104Solver : public LowStorageRK3SSolver
+{
+private:
+   static const double delta[10], gamma1[10], gamma2[10], gamma3[10],
+          beta[10], c[10];
+
+public:
+   SSPRK104Solver()
+      : LowStorageRK3SSolver(10, delta, gamma1, gamma2, gamma3, beta, c) { }
+};
+
+
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
 {
@@ -431,6 +546,380 @@ public:
 };
 
 
+/// Abstract norm of the local error estimate of an AdaptiveODESolver.
+class ODEErrorNorm
+{
+public:
+   /** @brief Return the norm of the error estimate @a err of a step from @a x0
+       to @a x1, scaled so that the step is accepted when it is at most 1. */
+   virtual double Eval(const Vector &err, const Vector &x0,
+                       const Vector &x1) const = 0;
+
+   virtual ~ODEErrorNorm() { }
+};
+
+
+/** @brief The weighted root mean square norm
+    sqrt( 1/N sum_i ( err_i / (atol + rtol max(|x0_i|, |x1_i|)) )^2 ). */
+/** With an MPI communicator, the sum and the global size N are reduced over
+    all processors, so that every processor takes the same time steps. */
+class ODEWRMSNorm : public ODEErrorNorm
+{
+protected:
+   double rtol, atol;
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+public:
+   ODEWRMSNorm(double rtol_ = 1e-4, double atol_ = 1e-8);
+
+#ifdef MFEM_USE_MPI
+   ODEWRMSNorm(MPI_Comm comm_, double rtol_ = 1e-4, double atol_ = 1e-8);
+#endif
+
+   void SetTolerances(double rtol_, double atol_)
+   { rtol = rtol_; atol = atol_; }
+
+   virtual double Eval(const Vector &err, const Vector &x0,
+                       const Vector &x1) const;
+};
+
+
+/** @brief Abstract ODE solver with local error control, based on an embedded
+    error estimate, and a PI step size controller. */
+/** Every call to Step() performs one accepted time step. The input @a dt is
+    the first step size attempted, which is reduced until the error estimate
+    is accepted by the ODEErrorNorm. On output, @a t is advanced by the
+    accepted step size, returned by GetLastTimeStep(), and @a dt is the step
+    size proposed for the next step by the controller
+    @verbatim
+    dt_new = dt safety (1/e_n)^(kI/k) (e_{n-1}/e_n)^(kP/k)
+    @endverbatim
+    where e_n is the norm of the current error estimate, e_{n-1} the one of
+    the previous accepted step, and k - 1 is the order of the embedded
+    (lower order) method. The ratio dt_new/dt is limited to [min_factor,
+    max_factor], and to at most 1 right after a rejected step.
+
+    The step size may be capped between calls, e.g. with dt = min(dt, tf - t)
+    to stop at a given time, as with the other ODE solvers. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   ODEWRMSNorm default_norm;
+   const ODEErrorNorm *norm;
+
+   int k_est;
+   double safety, kI, kP, min_factor, max_factor;
+   int max_rejections;
+
+   double err_prev, last_dt;
+   int num_accepted, num_rejected;
+
+   /// The solution at the end of a step attempt, and its error estimate.
+   Vector x1, err;
+
+   /** @brief Attempt a step of size @a dt from @a x at time @a t, setting
+       #x1 and #err. */
+   virtual void TryStep(const Vector &x, double t, double dt) = 0;
+
+   /// Called after the step from @a x to #x1 is accepted.
+   virtual void AcceptStep() { }
+
+public:
+   /// @a k - 1 is the order of the embedded method of the error estimate.
+   AdaptiveODESolver(int k);
+
+   /// Set the tolerances of the default error norm, an ODEWRMSNorm.
+   void SetTolerances(double rtol, double atol)
+   { default_norm.SetTolerances(rtol, atol); }
+
+   /** @brief Use the norm @a n, e.g. an ODEWRMSNorm with an MPI communicator,
+       instead of the default one. The norm is not owned. */
+   void SetErrorNorm(const ODEErrorNorm &n) { norm = &n; }
+
+   /// Set the safety factor of the controller, the default is 0.9.
+   void SetSafetyFactor(double s) { safety = s; }
+
+   /** @brief Set the integral and proportional gains of the controller, the
+       defaults are 0.3 and 0.4. With kI = 1 and kP = 0, this is the classical
+       (integral) controller. */
+   void SetPIGains(double kI_, double kP_) { kI = kI_; kP = kP_; }
+
+   /// Limit the ratio of consecutive step sizes, the defaults are 0.2 and 5.
+   void SetStepRatioLimits(double min_f, double max_f)
+   { min_factor = min_f; max_factor = max_f; }
+
+   /// Set the maximum number of rejected attempts in one Step() call.
+   void SetMaxRejections(int m) { max_rejections = m; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   /// Return the size of the last accepted step.
+   double GetLastTimeStep() const { return last_dt; }
+
+   /// Return the number of accepted steps since the last Init().
+   int GetNumAcceptedSteps() const { return num_accepted; }
+
+   /// Return the number of rejected step attempts since the last Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+};
+
+
+/** An explicit embedded Runge-Kutta pair, with the Butcher tableau of
+    ExplicitRKSolver and the coefficients e = b - bhat of the error estimate
+    err = dt sum_i e[i] k[i], where bhat are the weights of the embedded
+    method of order @a _k - 1. When @a _fsal is true, the last stage of the
+    method is the function at the new solution (first same as last) and is
+    reused as the first stage of the next step, unless the time passed to the
+    next Step() differs from the one it returned. Callers that modify the
+    solution between steps, e.g. with a limiter, or the operator itself, must
+    call Reset() before the next step. */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *e, *c;
+   bool fsal, k0_valid;
+   double *adt;
+   Vector y, *k;
+   double k0_t, t1; // time of k[0] with FSAL, and end of the attempted step
+
+protected:
+   virtual void TryStep(const Vector &x, double t, double dt);
+   virtual void AcceptStep();
+
+public:
+   EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                    const double *_e, const double *_c, int _k, bool _fsal);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   /** @brief Discard the first stage kept from the last accepted step, so that
+       the next step evaluates the operator again. */
+   void Reset() { k0_valid = false; }
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/// The 3rd order method of Bogacki and Shampine with an embedded 2nd order.
+class BogackiShampineSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], e[4], c[3];
+
+public:
+   BogackiShampineSolver() : EmbeddedRKSolver(4, a, b, e, c, 3, true) { }
+};
+
+
+/// The 5th order method of Dormand and Prince with an embedded 4th order.
+class DormandPrinceSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], e[7], c[6];
+
+public:
+   DormandPrinceSolver() : EmbeddedRKSolver(7, a, b, e, c, 5, true) { }
+};
+
+
+/** An embedded singly diagonal implicit Runge-Kutta pair:
+    @verbatim
+      c[0]   | gamma
+      c[1]   | a[0]  gamma
+      ...    |    ...
+      c[s-1] | ...   a[s(s-1)/2-1]  gamma
+    ---------+-----------------------------
+             | b[0]  b[1]  ...  b[s-1]
+    @endverbatim
+    with the error estimate err = dt sum_i e[i] k[i], e = b - bhat, where bhat
+    are the weights of the embedded method of order @a _k - 1. The stages are
+    computed with TimeDependentOperator::ImplicitSolve(). */
+class EmbeddedSDIRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   double gamma;
+   const double *a, *b, *e, *c;
+   double *adt;
+   Vector y, *k;
+
+protected:
+   virtual void TryStep(const Vector &x, double t, double dt);
+
+public:
+   EmbeddedSDIRKSolver(int _s, double _gamma, const double *_a,
+                       const double *_b, const double *_e, const double *_c,
+                       int _k);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual ~EmbeddedSDIRKSolver();
+};
+
+
+/** The L-stable, 5-stage, 4th order SDIRK method of Hairer and Wanner with an
+    embedded 3rd order method, suited to stiff problems. */
+class HairerWannerSDIRKSolver : public EmbeddedSDIRKSolver
+{
+private:
+   static const double a[10], b[5], e[5], c[5];
+
+public:
+   HairerWannerSDIRKSolver()
+      : EmbeddedSDIRKSolver(5, 0.25, a, b, e, c, 4) { }
+};
+
+
+/** An implicit-explicit (IMEX) additive Runge-Kutta method for the split
+    dx/dt = f1(x,t) + f2(x,t), where f1 is treated explicitly and f2
+    implicitly, with the tableaux
+    @verbatim
+      c[0]   |                       c[0]   | ai[0]
+      c[1]   | ae[0]                 c[1]   | ai[1]  ai[2]
+      ...    |    ...                ...    |     ...
+      c[s-1] | ...  ae[s(s-1)/2-1]   c[s-1] | ...         ai[s(s+1)/2-1]
+    ---------+---------------------  -------+----------------------------
+             | be[0] ... be[s-1]            | bi[0]  ...  bi[s-1]
+    @endverbatim
+    The terms are evaluated with the evaluation modes of the
+    TimeDependentOperator, see TimeDependentOperator::SetEvalMode():
+    - f1 with Mult() in the mode TimeDependentOperator::ADDITIVE_TERM_1,
+    - f2 with ImplicitSolve(), or with Mult() when the diagonal coefficient is
+      zero, in the mode TimeDependentOperator::ADDITIVE_TERM_2.
+
+    The evaluation mode is reset to TimeDependentOperator::NORMAL at the end of
+    every step. */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *ae, *ai, *be, *bi, *c;
+   Array<bool> use_ke, use_ki;
+   double *adt;
+   // The explicit stages k[0..s-1], followed by the implicit ones
+   Vector y, *k;
+
+public:
+   IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                const double *_be, const double *_bi, const double *_c);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/// The 1st order forward-backward Euler method, ARS(1,1,1).
+class IMEXEulerSolver : public IMEXRKSolver
+{
+private:
+   static const double ae[1], ai[3], be[2], bi[2], c[2];
+
+public:
+   IMEXEulerSolver() : IMEXRKSolver(2, ae, ai, be, bi, c) { }
+};
+
+
+/** The 2nd order ARS(2,2,2) method of Ascher, Ruuth and Spiteri, with an
+    L-stable implicit part. */
+class ARS222Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[3], ai[6], be[3], bi[3], c[3];
+
+public:
+   ARS222Solver() : IMEXRKSolver(3, ae, ai, be, bi, c) { }
+};
+
+
+/** The 3rd order ARS(4,4,3) method of Ascher, Ruuth and Spiteri, with an
+    L-stable implicit part. */
+class ARS443Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[10], ai[15], be[5], bi[5], c[5];
+
+public:
+   ARS443Solver() : IMEXRKSolver(5, ae, ai, be, bi, c) { }
+};
+
+
+/** The 3rd order, 4-stage ARK3(2)4L[2]SA method of Kennedy and Carpenter,
+    with an L-stable, stiffly accurate ESDIRK implicit part. */
+class ARK324L2SASolver : public IMEXRKSolver
+{
+private:
+   static const double ae[6], ai[10], b[4], c[4];
+
+public:
+   ARK324L2SASolver() : IMEXRKSolver(4, ae, ai, b, b, c) { }
+};
+
+
+/** The 4th order, 6-stage ARK4(3)6L[2]SA method of Kennedy and Carpenter,
+    with an L-stable, stiffly accurate ESDIRK implicit part. */
+class ARK436L2SASolver : public IMEXRKSolver
+{
+private:
+   static const double ae[15], ai[21], b[6], c[6];
+
+public:
+   ARK436L2SASolver() : IMEXRKSolver(6, ae, ai, b, b, c) { }
+};
+
+
+/** The implicit-explicit BDF/EXT multistep method of order 1, 2 or 3 for the
+    split dx/dt = f1(x,t) + f2(x,t):
+    @verbatim
+    (bd[0] x_{n+1} + ... + bd[q] x_{n+1-q})/dt
+       = ab[0] f1(x_n) + ... + ab[q-1] f1(x_{n+1-q}) + f2(x_{n+1})
+    @endverbatim
+    i.e. BDFq for f2 and the extrapolation EXTq of f1, with the evaluation
+    modes of IMEXRKSolver. The step size must be constant; call Init() to
+    change it.
+
+    By default, the order is raised by one in each of the first steps after
+    Init(), as in the Navier miniapp, which limits the global error of the
+    order 3 method to 2nd order. With SetStartupSolver(), the first steps are
+    taken with a one-step method instead, e.g. with an IMEXRKSolver of the
+    same order. */
+class BDFEXTSolver : public ODESolver
+{
+private:
+   int order, num_steps;
+   double dt_prev;
+   ODESolver *startup;
+   double *adt;
+   // The previous solutions x_n, ..., x_{n+1-order}, followed by the values
+   // of f1 at x_n, ..., x_{n+1-order}
+   Vector y, k, *v;
+
+public:
+   BDFEXTSolver(int _order = 3);
+
+   /** @brief Return the coefficients bd[0..3] and ab[0..2] of the method of
+       order @a q, with zero for the unused ones. */
+   static void GetCoefficients(int q, double *bd, double *ab);
+
+   /** @brief Take the first order-1 steps after Init() with the solver @a s,
+       which is not owned. */
+   void SetStartupSolver(ODESolver &s) { startup = &s; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~BDFEXTSolver();
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier–Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
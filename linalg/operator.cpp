@@ -48,6 +48,22 @@ void Operator::InitTVectors(const Operator *Po, const Operator *Ri,
    }
 }
 
+void Operator::MultiMult(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_ASSERT(X.VectorSize() == width, "Input vector size ("
+               << X.VectorSize() << ") must match operator width ("
+               << width << ")");
+   MFEM_ASSERT(Y.VectorSize() == height && Y.NumVectors() == X.NumVectors(),
+               "incompatible output MultiVector");
+   Vector x, y;
+   for (int j = 0; j < X.NumVectors(); j++)
+   {
+      X.GetVectorView(j, x);
+      Y.GetVectorView(j, y);
+      Mult(x, y);
+   }
+}
+
 void Operator::FormLinearSystem(const Array<int> &ess_tdof_list,
                                 Vector &x, Vector &b,
                                 Operator* &Aout, Vector &X, Vector &B,
@@ -298,10 +314,45 @@ void SecondOrderTimeDependentOperator::ImplicitSolve(const double dt0,
 }
 
 
+// Apply the factors ops[0], ..., ops[n-1] in this order, with MultTranspose()
+// when transp is true, skipping the identity factors marked in id. The output
+// of the factor k, unless it is the last one applied, is stored in *t[k].
+static void MultChain(const int n, const Operator *const ops[],
+                      const bool id[], const bool transp, const Vector &x,
+                      Vector &y, Vector *const t[])
+{
+   int last = -1;
+   for (int k = 0; k < n; k++)
+   {
+      if (!id[k]) { last = k; }
+   }
+   if (last < 0)
+   {
+      y = x;
+      return;
+   }
+   const Vector *in = &x;
+   for (int k = 0; k <= last; k++)
+   {
+      if (id[k]) { continue; }
+      Vector &out = (k == last) ? y : *t[k];
+      if (transp)
+      {
+         ops[k]->MultTranspose(*in, out);
+      }
+      else
+      {
+         ops[k]->Mult(*in, out);
+      }
+      in = &out;
+   }
+}
+
 ProductOperator::ProductOperator(const Operator *A, const Operator *B,
                                  bool ownA, bool ownB)
    : Operator(A->Height(), B->Width()),
-     A(A), B(B), ownA(ownA), ownB(ownB), z(A->Width())
+     A(A), B(B), ownA(ownA), ownB(ownB),
+     idA(IsIdentityProlongation(A)), idB(IsIdentityProlongation(B))
 {
    MFEM_VERIFY(A->Width() == B->Height(),
                "incompatible Operators: A->Width() = " << A->Width()
@@ -315,6 +366,24 @@ ProductOperator::ProductOperator(const Operator *A, const Operator *B,
                      "Operator B of a ProductOperator should not be in iterative mode");
       }
    }
+
+   if (!idA && !idB) { z.SetSize(A->Width()); }
+}
+
+void ProductOperator::Mult(const Vector &x, Vector &y) const
+{
+   const Operator *ops[2] = { B, A };
+   const bool id[2] = { idB, idA };
+   Vector *t[2] = { &z, NULL };
+   MultChain(2, ops, id, false, x, y, t);
+}
+
+void ProductOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   const Operator *ops[2] = { A, B };
+   const bool id[2] = { idA, idB };
+   Vector *t[2] = { &z, NULL };
+   MultChain(2, ops, id, true, x, y, t);
 }
 
 ProductOperator::~ProductOperator()
@@ -326,7 +395,8 @@ ProductOperator::~ProductOperator()
 
 RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
                          const Operator &P_)
-   : Operator(Rt_.Width(), P_.Width()), Rt(Rt_), A(A_), P(P_)
+   : Operator(Rt_.Width(), P_.Width()), Rt(Rt_), A(A_), P(P_),
+     idRt(IsIdentityProlongation(&Rt_)), idP(IsIdentityProlongation(&P_))
 {
    MFEM_VERIFY(Rt.Height() == A.Height(),
                "incompatible Operators: Rt.Height() = " << Rt.Height()
@@ -353,8 +423,42 @@ RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
 
    mem_class = Rt.GetMemoryClass()*P.GetMemoryClass();
    MemoryType mem_type = GetMemoryType(A.GetMemoryClass()*mem_class);
-   Px.SetSize(P.Height(), mem_type);
-   APx.SetSize(A.Height(), mem_type);
+   if (!idP) { Px.SetSize(P.Height(), mem_type); }
+   if (!idRt) { APx.SetSize(A.Height(), mem_type); }
+}
+
+void RAPOperator::Mult(const Vector & x, Vector & y) const
+{
+   const Vector *Ax = &x;
+   if (!idP)
+   {
+      P.Mult(x, Px);
+      Ax = &Px;
+   }
+   if (idRt)
+   {
+      A.Mult(*Ax, y);
+      return;
+   }
+   A.Mult(*Ax, APx);
+   Rt.MultTranspose(APx, y);
+}
+
+void RAPOperator::MultTranspose(const Vector & x, Vector & y) const
+{
+   const Vector *Ax = &x;
+   if (!idRt)
+   {
+      Rt.Mult(x, APx);
+      Ax = &APx;
+   }
+   if (idP)
+   {
+      A.MultTranspose(*Ax, y);
+      return;
+   }
+   A.MultTranspose(*Ax, Px);
+   P.MultTranspose(Px, y);
 }
 
 
@@ -364,6 +468,9 @@ TripleProductOperator::TripleProductOperator(
    : Operator(A->Height(), C->Width())
    , A(A), B(B), C(C)
    , ownA(ownA), ownB(ownB), ownC(ownC)
+   , idA(IsIdentityProlongation(A))
+   , idB(IsIdentityProlongation(B))
+   , idC(IsIdentityProlongation(C))
 {
    MFEM_VERIFY(A->Width() == B->Height(),
                "incompatible Operators: A->Width() = " << A->Width()
@@ -390,8 +497,26 @@ TripleProductOperator::TripleProductOperator(
 
    mem_class = A->GetMemoryClass()*C->GetMemoryClass();
    MemoryType mem_type = GetMemoryType(mem_class*B->GetMemoryClass());
-   t1.SetSize(C->Height(), mem_type);
-   t2.SetSize(B->Height(), mem_type);
+   // t1 follows C in Mult() and B^T in MultTranspose(), t2 follows B in
+   // Mult() and A^T in MultTranspose()
+   if (!idC && (!idA || !idB)) { t1.SetSize(C->Height(), mem_type); }
+   if (!idA && (!idB || !idC)) { t2.SetSize(B->Height(), mem_type); }
+}
+
+void TripleProductOperator::Mult(const Vector &x, Vector &y) const
+{
+   const Operator *ops[3] = { C, B, A };
+   const bool id[3] = { idC, idB, idA };
+   Vector *t[3] = { &t1, &t2, NULL };
+   MultChain(3, ops, id, false, x, y, t);
+}
+
+void TripleProductOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   const Operator *ops[3] = { A, B, C };
+   const bool id[3] = { idA, idB, idC };
+   Vector *t[3] = { &t2, &t1, NULL };
+   MultChain(3, ops, id, true, x, y, t);
 }
 
 TripleProductOperator::~TripleProductOperator()
@@ -414,6 +539,7 @@ ConstrainedOperator::ConstrainedOperator(Operator *A, const Array<int> &list,
    // typically z and w are large vectors, so store them on the device
    z.SetSize(height, mem_type); z.UseDevice(true);
    w.SetSize(height, mem_type); w.UseDevice(true);
+   mz.UseDevice(true);
 }
 
 void ConstrainedOperator::EliminateRHS(const Vector &x, Vector &b) const
@@ -471,6 +597,36 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    });
 }
 
+void ConstrainedOperator::MultiMult(const MultiVector &X,
+                                    MultiVector &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->MultiMult(X, Y);
+      return;
+   }
+
+   mz = X;
+
+   const int N = X.VectorSize(), nvec = X.NumVectors();
+   auto idx = constraint_list.Read();
+   // Use read+write access - we are modifying sub-vectors of mz
+   auto d_z = mz.ReadWrite();
+   MFEM_FORALL(i, csz*nvec, d_z[idx[i % csz] + (i / csz)*N] = 0.0;);
+
+   A->MultiMult(mz, Y);
+
+   auto d_x = X.Read();
+   // Use read+write access - we are modifying sub-vectors of Y
+   auto d_y = Y.ReadWrite();
+   MFEM_FORALL(i, csz*nvec,
+   {
+      const int id = idx[i % csz] + (i / csz)*N;
+      d_y[id] = d_x[id];
+   });
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
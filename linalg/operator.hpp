@@ -13,6 +13,7 @@
 #define MFEM_OPERATOR
 
 #include "vector.hpp"
+#include "multivector.hpp"
 
 namespace mfem
 {
@@ -79,6 +80,14 @@ public:
    /// Operator application: `y=A(x)`.
    virtual void Mult(const Vector &x, Vector &y) const = 0;
 
+   /** @brief Operator application to all vectors of a MultiVector:
+       `Y_j=A(X_j)`, j = 0,...,X.NumVectors()-1. */
+   /** The MultiVector @a Y must have the same number of vectors as @a X, with
+       size Height(). The default behavior in class Operator is to call Mult()
+       for every vector. Derived classes can override it to read their data
+       only once for all vectors. */
+   virtual void MultiMult(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Action of the transpose operator: `y=A^t(x)`. The default behavior
        in class Operator is to generate an error. */
    virtual void MultTranspose(const Vector &x, Vector &y) const
@@ -585,32 +594,36 @@ public:
 
 
 /// General product operator: x -> (A*B)(x) = A(B(x)).
+/** Factors that are IdentityOperator%s are skipped, together with the
+    intermediate vector and the copy they would require. */
 class ProductOperator : public Operator
 {
    const Operator *A, *B;
    bool ownA, ownB;
+   bool idA, idB; // identity factors, see IsIdentityProlongation()
    mutable Vector z;
 
 public:
    ProductOperator(const Operator *A, const Operator *B, bool ownA, bool ownB);
 
-   virtual void Mult(const Vector &x, Vector &y) const
-   { B->Mult(x, z); A->Mult(z, y); }
+   virtual void Mult(const Vector &x, Vector &y) const;
 
-   virtual void MultTranspose(const Vector &x, Vector &y) const
-   { A->MultTranspose(x, z); B->MultTranspose(z, y); }
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
 
    virtual ~ProductOperator();
 };
 
 
 /// The operator x -> R*A*P*x constructed through the actions of R^T, A and P
+/** When @a P or @a Rt is an IdentityOperator, its action is skipped and the
+    corresponding intermediate vector is not allocated. */
 class RAPOperator : public Operator
 {
 private:
    const Operator & Rt;
    const Operator & A;
    const Operator & P;
+   bool idRt, idP; // identity factors, see IsIdentityProlongation()
    mutable Vector Px;
    mutable Vector APx;
    MemoryClass mem_class;
@@ -622,22 +635,23 @@ public:
    virtual MemoryClass GetMemoryClass() const { return mem_class; }
 
    /// Operator application.
-   virtual void Mult(const Vector & x, Vector & y) const
-   { P.Mult(x, Px); A.Mult(Px, APx); Rt.MultTranspose(APx, y); }
+   virtual void Mult(const Vector & x, Vector & y) const;
 
    /// Application of the transpose.
-   virtual void MultTranspose(const Vector & x, Vector & y) const
-   { Rt.Mult(x, APx); A.MultTranspose(APx, Px); P.MultTranspose(Px, y); }
+   virtual void MultTranspose(const Vector & x, Vector & y) const;
 };
 
 
 /// General triple product operator x -> A*B*C*x, with ownership of the factors.
+/** As in ProductOperator, IdentityOperator factors are skipped and only the
+    intermediate vectors between the remaining factors are allocated. */
 class TripleProductOperator : public Operator
 {
    const Operator *A;
    const Operator *B;
    const Operator *C;
    bool ownA, ownB, ownC;
+   bool idA, idB, idC; // identity factors, see IsIdentityProlongation()
    mutable Vector t1, t2;
    MemoryClass mem_class;
 
@@ -647,11 +661,9 @@ public:
 
    virtual MemoryClass GetMemoryClass() const { return mem_class; }
 
-   virtual void Mult(const Vector &x, Vector &y) const
-   { C->Mult(x, t1); B->Mult(t1, t2); A->Mult(t2, y); }
+   virtual void Mult(const Vector &x, Vector &y) const;
 
-   virtual void MultTranspose(const Vector &x, Vector &y) const
-   { A->MultTranspose(x, t2); B->MultTranspose(t2, t1); C->MultTranspose(t1, y); }
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
 
    virtual ~TripleProductOperator();
 };
@@ -670,6 +682,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable MultiVector mz;      ///< Auxiliary MultiVector, see MultiMult().
    MemoryClass mem_class;
 
 public:
@@ -706,6 +719,10 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Constrained operator action on all vectors of @a X, using
+       MultiMult() of the unconstrained Operator. */
+   virtual void MultiMult(const MultiVector &X, MultiVector &Y) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
    virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
 };
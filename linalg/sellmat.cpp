@@ -0,0 +1,346 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class SlicedEllpackMatrix
+
+#include "sellmat.hpp"
+#include "../general/forall.hpp"
+#include <algorithm>
+
+namespace mfem
+{
+
+SlicedEllpackMatrix::SlicedEllpackMatrix(const SparseMatrix &A, int C_,
+                                         int sigma_)
+   : Operator(A.Height(), A.Width()), At(NULL)
+{
+   Init(A, C_, sigma_);
+}
+
+void SlicedEllpackMatrix::Init(const SparseMatrix &A, int C_, int sigma_)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(C_ == 1 || C_ == 2 || C_ == 4 || C_ == 8 || C_ == 16 ||
+               C_ == 32, "invalid chunk size C = " << C_);
+   MFEM_VERIFY(sigma_ == 1 || (sigma_ > 0 && sigma_ % C_ == 0),
+               "the sorting window must be 1 or a multiple of C");
+   C = C_;
+   sigma = sigma_;
+   nchunks = (height + C - 1)/C;
+
+   const int n = height;
+   const int nslots = nchunks*C;
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   const double *data = A.HostReadData();
+
+   // Sort the rows by decreasing length within the windows of sigma rows; the
+   // stable sort keeps the original order of rows with equal lengths
+   row_perm.New(nslots);
+   row_len.New(nslots);
+   for (int t = 0; t < nslots; t++) { row_perm[t] = (t < n) ? t : -1; }
+   if (sigma > 1)
+   {
+      for (int w = 0; w < n; w += sigma)
+      {
+         std::stable_sort(row_perm + w, row_perm + std::min(w + sigma, n),
+                          [&](int i, int j)
+         { return I[i+1] - I[i] > I[j+1] - I[j]; });
+      }
+   }
+   for (int t = 0; t < nslots; t++)
+   {
+      const int i = row_perm[t];
+      row_len[t] = (i >= 0) ? I[i+1] - I[i] : 0;
+   }
+
+   chunk_ptr.New(nchunks+1);
+   chunk_ptr[0] = 0;
+   for (int c = 0; c < nchunks; c++)
+   {
+      int len = 0;
+      for (int r = 0; r < C; r++) { len = std::max(len, row_len[c*C+r]); }
+      chunk_ptr[c+1] = chunk_ptr[c] + len*C;
+   }
+
+   // Padding entries repeat the last column of their row with a zero value,
+   // so that they do not access other cache lines of the input vector
+   const int nstored = chunk_ptr[nchunks];
+   col.New(nstored);
+   val.New(nstored);
+   for (int c = 0; c < nchunks; c++)
+   {
+      const int len = (chunk_ptr[c+1] - chunk_ptr[c])/C;
+      for (int r = 0; r < C; r++)
+      {
+         const int t = c*C + r;
+         const int i = row_perm[t];
+         const int rlen = row_len[t];
+         for (int k = 0; k < len; k++)
+         {
+            const int e = chunk_ptr[c] + k*C + r;
+            if (k < rlen)
+            {
+               col[e] = J[I[i]+k];
+               val[e] = data[I[i]+k];
+            }
+            else
+            {
+               col[e] = (rlen > 0) ? J[I[i]+rlen-1] : 0;
+               val[e] = 0.0;
+            }
+         }
+      }
+   }
+}
+
+void SlicedEllpackMatrix::Destroy()
+{
+   chunk_ptr.Delete();
+   row_perm.Delete();
+   row_len.Delete();
+   col.Delete();
+   val.Delete();
+   delete At;
+}
+
+int SlicedEllpackMatrix::NumNonZeroElems() const
+{
+   const int *len = HostRead(row_len, nchunks*C);
+   int nnz = 0;
+   for (int t = 0; t < nchunks*C; t++) { nnz += len[t]; }
+   return nnz;
+}
+
+int SlicedEllpackMatrix::NumStoredEntries() const
+{
+   return HostRead(chunk_ptr, nchunks+1)[nchunks];
+}
+
+void SlicedEllpackMatrix::GetDiag(Vector &d) const
+{
+   MFEM_VERIFY(height == width, "the matrix must be square");
+   d.SetSize(height);
+   const int C = this->C;
+   auto d_ptr = Read(chunk_ptr, nchunks+1);
+   auto d_perm = Read(row_perm, nchunks*C);
+   auto d_len = Read(row_len, nchunks*C);
+   auto d_col = Read(col, col.Capacity());
+   auto d_val = Read(val, val.Capacity());
+   auto d_d = d.Write();
+   MFEM_FORALL(t, nchunks*C,
+   {
+      const int i = d_perm[t];
+      if (i < 0) { return; }
+      const int c = t / C, r = t % C;
+      double dii = 0.0;
+      for (int k = 0; k < d_len[t]; k++)
+      {
+         const int e = d_ptr[c] + k*C + r;
+         if (d_col[e] == i) { dii = d_val[e]; break; }
+      }
+      d_d[i] = dii;
+   });
+}
+
+SparseMatrix *SlicedEllpackMatrix::ToSparseMatrix() const
+{
+   const int *ptr = HostRead(chunk_ptr, nchunks+1);
+   const int *perm = HostRead(row_perm, nchunks*C);
+   const int *len = HostRead(row_len, nchunks*C);
+   const int *cj = HostRead(col, col.Capacity());
+   const double *cv = HostRead(val, val.Capacity());
+
+   int *I = Memory<int>(height+1);
+   I[0] = 0;
+   for (int t = 0; t < nchunks*C; t++)
+   {
+      if (perm[t] >= 0) { I[perm[t]+1] = len[t]; }
+   }
+   for (int i = 0; i < height; i++) { I[i+1] += I[i]; }
+   int *J = Memory<int>(I[height]);
+   double *data = Memory<double>(I[height]);
+   for (int t = 0; t < nchunks*C; t++)
+   {
+      const int i = perm[t];
+      if (i < 0) { continue; }
+      const int c = t / C, r = t % C;
+      for (int k = 0; k < len[t]; k++)
+      {
+         J[I[i]+k] = cj[ptr[c] + k*C + r];
+         data[I[i]+k] = cv[ptr[c] + k*C + r];
+      }
+   }
+   SparseMatrix *A = new SparseMatrix(I, J, data, height, width);
+   A->SortColumnIndices();
+   return A;
+}
+
+// y = a A x (add = false) or y += a A x (add = true) for chunks of C rows. On
+// the host, the C lanes of a chunk are processed together by one iteration of
+// the loop, which the compiler vectorizes.
+template <int C>
+static void SellMultHost(const int nchunks, const int *d_ptr,
+                         const int *d_perm, const int *d_col,
+                         const double *d_val, const double *d_x, double *d_y,
+                         const double a, const bool add)
+{
+   MFEM_FORALL(c, nchunks,
+   {
+      double sum[C];
+      for (int r = 0; r < C; r++) { sum[r] = 0.0; }
+      const int beg = d_ptr[c], end = d_ptr[c+1];
+      for (int e = beg; e < end; e += C)
+      {
+         for (int r = 0; r < C; r++)
+         {
+            sum[r] += d_val[e+r] * d_x[d_col[e+r]];
+         }
+      }
+      for (int r = 0; r < C; r++)
+      {
+         const int i = d_perm[c*C+r];
+         if (i >= 0) { d_y[i] = add ? d_y[i] + a*sum[r] : a*sum[r]; }
+      }
+   });
+}
+
+// Same as SellMultHost(), with one thread per row, for the GPU backends.
+static void SellMultDevice(const int C, const int nchunks, const int *d_ptr,
+                           const int *d_perm, const int *d_col,
+                           const double *d_val, const double *d_x,
+                           double *d_y, const double a, const bool add)
+{
+   MFEM_FORALL(t, nchunks*C,
+   {
+      const int i = d_perm[t];
+      if (i < 0) { return; }
+      const int c = t / C, r = t % C;
+      double sum = 0.0;
+      const int end = d_ptr[c+1];
+      for (int e = d_ptr[c] + r; e < end; e += C)
+      {
+         sum += d_val[e] * d_x[d_col[e]];
+      }
+      d_y[i] = add ? d_y[i] + a*sum : a*sum;
+   });
+}
+
+static void SellMult(const int C, const int nchunks, const int *d_ptr,
+                     const int *d_perm, const int *d_col, const double *d_val,
+                     const double *d_x, double *d_y, const double a,
+                     const bool add)
+{
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      return SellMultDevice(C, nchunks, d_ptr, d_perm, d_col, d_val, d_x, d_y,
+                            a, add);
+   }
+   switch (C)
+   {
+      case 1: return SellMultHost<1>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                        d_x, d_y, a, add);
+      case 2: return SellMultHost<2>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                        d_x, d_y, a, add);
+      case 4: return SellMultHost<4>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                        d_x, d_y, a, add);
+      case 8: return SellMultHost<8>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                        d_x, d_y, a, add);
+      case 16: return SellMultHost<16>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                          d_x, d_y, a, add);
+      case 32: return SellMultHost<32>(nchunks, d_ptr, d_perm, d_col, d_val,
+                                          d_x, d_y, a, add);
+   }
+   MFEM_ABORT("invalid chunk size C = " << C);
+}
+
+void SlicedEllpackMatrix::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   SellMult(C, nchunks, Read(chunk_ptr, nchunks+1), Read(row_perm, nchunks*C),
+            Read(col, col.Capacity()), Read(val, val.Capacity()), x.Read(),
+            y.Write(), 1.0, false);
+}
+
+void SlicedEllpackMatrix::AddMult(const Vector &x, Vector &y,
+                                  const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   SellMult(C, nchunks, Read(chunk_ptr, nchunks+1), Read(row_perm, nchunks*C),
+            Read(col, col.Capacity()), Read(val, val.Capacity()), x.Read(),
+            y.ReadWrite(), a, true);
+}
+
+void SlicedEllpackMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void SlicedEllpackMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                           const double a) const
+{
+   MFEM_ASSERT(height == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix height (" << height << ")");
+   MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix width (" << width << ")");
+   if (At)
+   {
+      At->AddMult(x, y, a);
+      return;
+   }
+   MFEM_VERIFY(!Device::Allows(Backend::DEVICE_MASK), "transpose action on "
+               "device is not enabled; see BuildTranspose() for details.");
+   const int *ptr = HostRead(chunk_ptr, nchunks+1);
+   const int *perm = HostRead(row_perm, nchunks*C);
+   const int *cj = HostRead(col, col.Capacity());
+   const double *cv = HostRead(val, val.Capacity());
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int c = 0; c < nchunks; c++)
+   {
+      for (int r = 0; r < C; r++)
+      {
+         const int i = perm[c*C+r];
+         if (i < 0) { continue; }
+         const double xi = a * xp[i];
+         for (int e = ptr[c] + r; e < ptr[c+1]; e += C)
+         {
+            yp[cj[e]] += cv[e] * xi;
+         }
+      }
+   }
+}
+
+void SlicedEllpackMatrix::BuildTranspose() const
+{
+   if (At == NULL)
+   {
+      SparseMatrix *A = ToSparseMatrix();
+      SparseMatrix *AT = Transpose(*A);
+      delete A;
+      At = new SlicedEllpackMatrix(*AT, C, sigma);
+      delete AT;
+   }
+}
+
+void SlicedEllpackMatrix::ResetTranspose() const
+{
+   delete At;
+   At = NULL;
+}
+
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SELLMAT
+#define MFEM_SELLMAT
+
+#include "../config/config.hpp"
+#include "../general/mem_manager.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/// Sparse matrix in the sliced ELLPACK format SELL-C-sigma.
+/** The rows are split into chunks of C consecutive rows. Within a chunk, the
+    rows are padded with zeros to the length of the longest one and stored
+    column by column, so that the products of the C rows of a chunk proceed in
+    lockstep over contiguous entries, which vectorizes with SIMD instructions
+    of width C and gives coalesced accesses on GPUs. To reduce the padding, the
+    rows are first sorted by decreasing length within windows of sigma rows.
+
+    The matrix is built from a finalized SparseMatrix and is an Operator, so it
+    can replace the SparseMatrix in the iterative solvers. The transpose action
+    on devices requires the internal transpose, see BuildTranspose(). */
+class SlicedEllpackMatrix : public Operator
+{
+protected:
+   int C, sigma, nchunks;
+
+   /// Offsets of the chunks in #col and #val, size nchunks+1.
+   Memory<int> chunk_ptr;
+   /// Original row of every slot (chunk c, lane r) = c*C+r, or -1 for padding.
+   Memory<int> row_perm;
+   /// Number of nonzero entries of the row of every slot.
+   Memory<int> row_len;
+   /** @brief Column indices and values. Entry k of the row in lane r of chunk
+       c is at index chunk_ptr[c] + k*C + r. */
+   Memory<int> col;
+   Memory<double> val;
+
+   /// Transpose of the matrix. Owned. Used to perform MultTranspose().
+   mutable SlicedEllpackMatrix *At;
+
+   void Init(const SparseMatrix &A, int C_, int sigma_);
+   void Destroy();
+
+public:
+   /** @brief Convert the finalized SparseMatrix @a A, using chunks of
+       @a C_ rows, sorting the rows by length within windows of @a sigma_
+       rows. */
+   /** @a C_ must be one of 1, 2, 4, 8, 16 or 32. @a sigma_ must be 1, i.e. no
+       sorting, or a multiple of @a C_. */
+   explicit SlicedEllpackMatrix(const SparseMatrix &A, int C_ = 8,
+                                int sigma_ = 64);
+
+   /// Not copyable: the matrix owns its arrays and its transpose.
+   SlicedEllpackMatrix(const SlicedEllpackMatrix &) = delete;
+   SlicedEllpackMatrix &operator=(const SlicedEllpackMatrix &) = delete;
+
+   /// Return the chunk height C.
+   int GetChunkSize() const { return C; }
+
+   /// Return the sorting window sigma.
+   int GetSortingWindow() const { return sigma; }
+
+   /// Return the number of nonzero entries, excluding the padding.
+   int NumNonZeroElems() const;
+
+   /// Return the number of stored entries, including the padding.
+   int NumStoredEntries() const;
+
+   /// Return the diagonal of the matrix in @a d.
+   void GetDiag(Vector &d) const;
+
+   /// Convert back to a finalized SparseMatrix with sorted column indices.
+   SparseMatrix *ToSparseMatrix() const;
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   /// Matrix vector multiplication y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Multiply a vector with the transposed matrix, y = A^t x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// y += a A^t x
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+
+   /** @brief Build and store internally the transpose of this matrix, in the
+       same format, which is then used by AddMultTranspose() and
+       MultTranspose(). */
+   /** Without the internal transpose, the transpose action scatters the
+       entries sequentially on the host; it is not supported on devices. If
+       the internal transpose is already built, this method has no effect. */
+   void BuildTranspose() const;
+
+   /// Reset (destroy) the internal transpose matrix.
+   void ResetTranspose() const;
+
+   virtual ~SlicedEllpackMatrix() { Destroy(); }
+};
+
+}
+
+#endif // MFEM_SELLMAT
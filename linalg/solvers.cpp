@@ -12,12 +12,14 @@
 #include "linalg.hpp"
 #include "../general/forall.hpp"
 #include "../general/globals.hpp"
+#include "../general/perf_regions.hpp"
 #include "../fem/bilinearform.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <vector>
 
 namespace mfem
 {
@@ -34,6 +36,7 @@ IterativeSolver::IterativeSolver()
    rel_tol = abs_tol = 0.0;
 #ifdef MFEM_USE_MPI
    dot_prod_type = 0;
+   dot_request = MPI_REQUEST_NULL;
 #endif
 }
 
@@ -48,6 +51,7 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
    rel_tol = abs_tol = 0.0;
    dot_prod_type = 1;
    comm = _comm;
+   dot_request = MPI_REQUEST_NULL;
 }
 #endif
 
@@ -67,6 +71,145 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::StartDots(int n, const Vector *const x[],
+                                const Vector *const y[], double *dots) const
+{
+   for (int i = 0; i < n; i++)
+   {
+      dots[i] = (*x[i]) * (*y[i]);
+   }
+   StartReduction(n, dots);
+}
+
+void IterativeSolver::StartReduction(int n, double *dots) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+#if MPI_VERSION >= 3
+      MPI_Iallreduce(MPI_IN_PLACE, dots, n, MPI_DOUBLE, MPI_SUM, comm,
+                     &dot_request);
+#else
+      MPI_Allreduce(MPI_IN_PLACE, dots, n, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+   }
+#endif
+}
+
+void IterativeSolver::WaitDots() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_request != MPI_REQUEST_NULL)
+   {
+      MPI_Wait(&dot_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+double IterativeSolver::GlobalSum(double local) const
+{
+   StartReduction(1, &local);
+   WaitDots();
+   return local;
+}
+
+namespace
+{
+
+// References to the first n columns, of size N, of the multivector V.
+struct ColumnRefs
+{
+   std::vector<Vector> cols;
+   std::vector<const Vector*> ptrs;
+
+   ColumnRefs(int n, const Vector &V, int N) : cols(n), ptrs(n)
+   {
+      for (int k = 0; k < n; k++)
+      {
+         cols[k].MakeRef(const_cast<Vector&>(V), k*N, N);
+         ptrs[k] = &cols[k];
+      }
+   }
+};
+
+}
+
+// Local part of IterativeSolver::MultiDot(). With a device backend, see
+// Vector::MultiDot(); on the host, the columns of V are traversed in blocks of
+// rows, so that each block of w is loaded once for all the columns.
+static void MultiDotLocal(int n, const Vector &V, const Vector &w, double *h,
+                          bool with_norm)
+{
+   const int N = w.Size();
+   if (Device::IsEnabled() && (V.UseDevice() || w.UseDevice()))
+   {
+      ColumnRefs Vk(n, V, N);
+      if (with_norm) { Vk.ptrs.push_back(&w); }
+      w.MultiDot((int)Vk.ptrs.size(), Vk.ptrs.data(), h);
+      return;
+   }
+   const int block = 512;
+   const double *v_data = V.HostRead();
+   const double *w_data = w.HostRead();
+   for (int k = 0; k < n; k++) { h[k] = 0.0; }
+   if (with_norm) { h[n] = 0.0; }
+   for (int i0 = 0; i0 < N; i0 += block)
+   {
+      const int i1 = std::min(i0 + block, N);
+      for (int k = 0; k < n; k++)
+      {
+         const double *vk = v_data + k*N;
+         double dot = 0.0;
+         for (int i = i0; i < i1; i++) { dot += vk[i] * w_data[i]; }
+         h[k] += dot;
+      }
+      if (with_norm)
+      {
+         double dot = 0.0;
+         for (int i = i0; i < i1; i++) { dot += w_data[i] * w_data[i]; }
+         h[n] += dot;
+      }
+   }
+}
+
+// y += a sum_k h[k] V_k, where V_k are the first n columns of the multivector
+// V, in a single pass over y.
+static void MultiAdd(int n, const Vector &V, const double *h, double a,
+                     Vector &y)
+{
+   ColumnRefs Vk(n, V, y.Size());
+   std::vector<double> ah(n);
+   for (int k = 0; k < n; k++) { ah[k] = a*h[k]; }
+   add(y, n, ah.data(), Vk.cols.data(), y);
+}
+
+void IterativeSolver::MultiDot(int n, const Vector &V, const Vector &w,
+                               double *h, bool with_norm) const
+{
+   MultiDotLocal(n, V, w, h, with_norm);
+   StartReduction(n + (with_norm ? 1 : 0), h);
+   WaitDots();
+}
+
+void IterativeSolver::OrthogonalizeCGS2(int n, const Vector &V, Vector &w,
+                                        double *h) const
+{
+   Vector h2(n+1);
+   MultiDot(n, V, w, h);
+   MultiAdd(n, V, h, -1.0, w);
+   // The second pass also computes (w, w), from which the norm of the final w
+   // follows since it is orthogonal to the correction V h2.
+   MultiDot(n, V, w, h2.GetData(), true);
+   MultiAdd(n, V, h2.GetData(), -1.0, w);
+   double norm2 = h2(n);
+   for (int k = 0; k < n; k++)
+   {
+      h[k] += h2(k);
+      norm2 -= h2(k)*h2(k);
+   }
+   h[n] = sqrt(std::max(norm2, 0.0));
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -480,241 +623,1072 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
       {
          break;
       }
-   }
-
-   if (print_level >= 0 && !converged)
-   {
-      mfem::err << "SLI: No convergence!" << '\n';
-      mfem::out << "||Br_0|| = " << nom0 << '\n'
-                << "||Br_N|| = " << nom << '\n'
-                << "Number of SLI iterations: " << final_iter << '\n';
+   }
+
+   if (print_level >= 0 && !converged)
+   {
+      mfem::err << "SLI: No convergence!" << '\n';
+      mfem::out << "||Br_0|| = " << nom0 << '\n'
+                << "||Br_N|| = " << nom << '\n'
+                << "Number of SLI iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (nom/nom0, 1.0/final_iter) << '\n';
+   }
+   final_norm = nom;
+}
+
+void SLI(const Operator &A, const Vector &b, Vector &x,
+         int print_iter, int max_num_iter,
+         double RTOLERANCE, double ATOLERANCE)
+{
+   SLISolver sli;
+   sli.SetPrintLevel(print_iter);
+   sli.SetMaxIter(max_num_iter);
+   sli.SetRelTol(sqrt(RTOLERANCE));
+   sli.SetAbsTol(sqrt(ATOLERANCE));
+   sli.SetOperator(A);
+   sli.Mult(b, x);
+}
+
+void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
+         int print_iter, int max_num_iter,
+         double RTOLERANCE, double ATOLERANCE)
+{
+   SLISolver sli;
+   sli.SetPrintLevel(print_iter);
+   sli.SetMaxIter(max_num_iter);
+   sli.SetRelTol(sqrt(RTOLERANCE));
+   sli.SetAbsTol(sqrt(ATOLERANCE));
+   sli.SetOperator(A);
+   sli.SetPreconditioner(B);
+   sli.Mult(b, x);
+}
+
+
+void CGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   d.SetSize(width);
+   z.SetSize(width);
+}
+
+void CGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("CGSolver::Mult");
+   int i;
+   double r0, den, nom, nom0, betanom, alpha, beta;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   if (prec)
+   {
+      prec->Mult(r, z); // z = B r
+      d = z;
+   }
+   else
+   {
+      d = r;
+   }
+   nom0 = nom = Dot(d, r);
+   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, nom, r, x);
+
+   if (nom < 0.0)
+   {
+      if (print_level >= 0)
+      {
+         mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                   << nom << '\n';
+      }
+      converged = 0;
+      final_iter = 0;
+      final_norm = nom;
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (nom <= r0)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
+
+   oper->Mult(d, z);  // z = A d
+   den = Dot(z, d);
+   MFEM_ASSERT(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_level >= 0)
+      {
+         mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                   << den << '\n';
+      }
+      if (den == 0.0)
+      {
+         converged = 0;
+         final_iter = 0;
+         final_norm = sqrt(nom);
+         return;
+      }
+   }
+
+   // start iteration
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      alpha = nom/den;
+      add(x,  alpha, d, x);     //  x = x + alpha d
+
+      if (prec)
+      {
+         add(r, -alpha, z, r);  //  r = r - alpha A d
+         prec->Mult(r, z);      //  z = B r
+         betanom = Dot(r, z);
+      }
+      else
+      {
+         // r = r - alpha A d and (r, r) in a single pass
+         betanom = GlobalSum(r.AxpyDot(-alpha, z, r));
+      }
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                      << betanom << '\n';
+         }
+         converged = 0;
+         final_iter = i;
+         break;
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+
+      Monitor(i, betanom, r, x);
+
+      if (betanom < r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << betanom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      if (prec)
+      {
+         add(z, beta, d, d);   //  d = z + beta d
+      }
+      else
+      {
+         add(r, beta, d, d);
+      }
+      oper->Mult(d, z);       //  z = A d
+      den = Dot(d, z);
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_level >= 0)
+         {
+            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      nom = betanom;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (betanom/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+// Cholesky factorization A = L L^t of a small symmetric positive definite
+// matrix, overwriting the lower triangle of A with L. Returns false if A is not
+// numerically positive definite.
+static bool CholeskyFactor(DenseMatrix &A)
+{
+   const int n = A.Height();
+   for (int j = 0; j < n; j++)
+   {
+      double d = A(j,j);
+      for (int k = 0; k < j; k++) { d -= A(j,k)*A(j,k); }
+      if (d <= 1e-14*A(j,j)) { return false; }
+      A(j,j) = sqrt(d);
+      for (int i = j+1; i < n; i++)
+      {
+         double t = A(i,j);
+         for (int k = 0; k < j; k++) { t -= A(i,k)*A(j,k); }
+         A(i,j) = t/A(j,j);
+      }
+   }
+   return true;
+}
+
+// X <- L^{-1} X for the lower triangular Cholesky factor L stored in A.
+static void CholeskyLSolve(const DenseMatrix &A, DenseMatrix &X)
+{
+   const int n = A.Height();
+   for (int c = 0; c < X.Width(); c++)
+   {
+      for (int i = 0; i < n; i++)
+      {
+         double t = X(i,c);
+         for (int k = 0; k < i; k++) { t -= A(i,k)*X(k,c); }
+         X(i,c) = t/A(i,i);
+      }
+   }
+}
+
+// X <- L^{-t} X for the lower triangular Cholesky factor L stored in A.
+static void CholeskyLtSolve(const DenseMatrix &A, DenseMatrix &X)
+{
+   const int n = A.Height();
+   for (int c = 0; c < X.Width(); c++)
+   {
+      for (int i = n-1; i >= 0; i--)
+      {
+         double t = X(i,c);
+         for (int k = i+1; k < n; k++) { t -= A(k,i)*X(k,c); }
+         X(i,c) = t/A(i,i);
+      }
+   }
+}
+
+// Eigenvalues and orthonormal eigenvectors (the columns of V) of a small
+// symmetric matrix with the cyclic Jacobi method. The matrix A is overwritten.
+static void SymmetricEigensystem(DenseMatrix &A, Vector &ev, DenseMatrix &V)
+{
+   const int n = A.Height();
+   V.Diag(1.0, n);
+   for (int sweep = 0; sweep < 50; sweep++)
+   {
+      double off = 0.0, diag = 0.0;
+      for (int j = 0; j < n; j++)
+      {
+         diag += A(j,j)*A(j,j);
+         for (int i = 0; i < j; i++) { off += A(i,j)*A(i,j); }
+      }
+      if (off <= 1e-30*diag) { break; }
+      for (int p = 0; p < n; p++)
+      {
+         for (int q = p+1; q < n; q++)
+         {
+            if (A(p,q) == 0.0) { continue; }
+            const double theta = (A(q,q) - A(p,p))/(2.0*A(p,q));
+            const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                             (std::abs(theta) + sqrt(theta*theta + 1.0));
+            const double c = 1.0/sqrt(t*t + 1.0), s = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const double akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - s*akq;
+               A(k,q) = s*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - s*aqk;
+               A(q,k) = s*apk + c*aqk;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - s*vkq;
+               V(k,q) = s*vkp + c*vkq;
+            }
+         }
+      }
+   }
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(i,i); }
+}
+
+void RecycledCGSolver::SetOperator(const Operator &op)
+{
+   const int old_width = width;
+   CGSolver::SetOperator(op);
+   q.SetSize(width);
+   if (width != old_width) { ClearRecycleSpace(); }
+   SetupRecycleSpace();
+}
+
+void RecycledCGSolver::SetupRecycleSpace() const
+{
+   const int k = W.NumVectors();
+   if (k == 0) { return; }
+   AW.SetSize(height, k);
+   oper->MultiMult(W, AW);
+   DenseMatrix E;
+   W.InnerProducts(AW, E);
+   StartReduction(k*k, E.Data());
+   WaitDots();
+   E.Symmetrize();
+   Array<int> ipiv(k);
+   LUFactors lu(E.Data(), ipiv.GetData());
+   if (!lu.Factor(k))
+   {
+      ClearRecycleSpace();
+      return;
+   }
+   Einv.SetSize(k);
+   lu.GetInverseMatrix(k, Einv.Data());
+}
+
+void RecycledCGSolver::UpdateRecycleSpace(int np) const
+{
+   const int n = height, k = W.NumVectors(), nu = k + np;
+   if (np == 0 || rdim <= 0) { return; }
+
+   // Basis U = [W, P] of the search space and its image A U
+   MultiVector U(n, nu), AU(n, nu);
+   for (int j = 0; j < k; j++)
+   {
+      W.CopyVector(j, U, j);
+      AW.CopyVector(j, AU, j);
+   }
+   for (int j = 0; j < np; j++)
+   {
+      P.CopyVector(j, U, k+j);
+      AP.CopyVector(j, AU, k+j);
+   }
+   DenseMatrix G, F;
+   U.InnerProducts(AU, G); // U^t A U
+   U.InnerProducts(U, F);  // U^t U
+   Vector buf(2*nu*nu);
+   std::copy(G.Data(), G.Data() + nu*nu, buf.GetData());
+   std::copy(F.Data(), F.Data() + nu*nu, buf.GetData() + nu*nu);
+   StartReduction(buf.Size(), buf.GetData());
+   WaitDots();
+   std::copy(buf.GetData(), buf.GetData() + nu*nu, G.Data());
+   std::copy(buf.GetData() + nu*nu, buf.GetData() + 2*nu*nu, F.Data());
+   G.Symmetrize();
+
+   // Scale the basis so that diag(G) = 1. The Ritz values are the eigenvalues
+   // theta of G y = theta F y; with G = L L^t we compute the largest
+   // eigenvalues 1/theta of L^{-1} F L^{-t}.
+   Vector D(nu);
+   for (int i = 0; i < nu; i++)
+   {
+      if (G(i,i) <= 0.0) { return; }
+      D(i) = 1.0/sqrt(G(i,i));
+   }
+   for (int j = 0; j < nu; j++)
+   {
+      for (int i = 0; i < nu; i++)
+      {
+         G(i,j) *= D(i)*D(j);
+         F(i,j) *= D(i)*D(j);
+      }
+   }
+   DenseMatrix L(G);
+   if (!CholeskyFactor(L)) { return; }
+   CholeskyLSolve(L, F);
+   F.Transpose();
+   CholeskyLSolve(L, F);
+   F.Symmetrize();
+   Vector mu;
+   DenseMatrix V;
+   SymmetricEigensystem(F, mu, V);
+
+   // Select the eigenvectors of the largest 1/theta
+   const int knew = std::min(rdim, nu);
+   Array<int> order(nu);
+   for (int i = 0; i < nu; i++) { order[i] = i; }
+   std::sort(order.begin(), order.end(),
+             [&mu](int a, int b) { return mu(a) > mu(b); });
+   DenseMatrix Y(nu, knew);
+   for (int j = 0; j < knew; j++)
+   {
+      for (int i = 0; i < nu; i++) { Y(i,j) = V(i,order[j]); }
+   }
+   CholeskyLtSolve(L, Y);
+   Y.LeftScaling(D);
+
+   W.SetSize(n, knew);
+   AW.SetSize(n, knew);
+   W = 0.0;
+   AW = 0.0;
+   U.AddMult(Y, W);
+   AU.AddMult(Y, AW);
+
+   // W^t A W = V^t V = I up to round-off; invert the computed product
+   G.InvLeftScaling(D);
+   G.InvRightScaling(D);
+   DenseMatrix GY(nu, knew), E(knew);
+   mfem::Mult(G, Y, GY);
+   MultAtB(Y, GY, E);
+   E.Symmetrize();
+   Array<int> ipiv(knew);
+   LUFactors lu(E.Data(), ipiv.GetData());
+   if (!lu.Factor(knew))
+   {
+      ClearRecycleSpace();
+      return;
+   }
+   Einv.SetSize(knew);
+   lu.GetInverseMatrix(knew, Einv.Data());
+}
+
+void RecycledCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("RecycledCGSolver::Mult");
+   const int n = width, k = W.NumVectors(), m = 2*rdim;
+   int i, np = 0;
+   double r0, den, nom, nom0, betanom, alpha, beta;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   Vector mu(k);
+   h.SetSize(k+1);
+   if (k > 0)
+   {
+      // Galerkin projection on W: x = x + W E^{-1} W^t r, r = r - A W (...)
+      MultiDot(k, W, r, h.GetData());
+      Einv.Mult(h.GetData(), mu.GetData());
+      MultiAdd(k, W, mu.GetData(), 1.0, x);
+      MultiAdd(k, AW, mu.GetData(), -1.0, r);
+   }
+   if (prec) { prec->Mult(r, z); } // z = B r
+   const Vector &br = prec ? z : r;
+
+   // (B r, r) and (A W)^t B r with a single reduction
+   MultiDotLocal(k, AW, br, h.GetData(), false);
+   h(k) = br * r;
+   StartReduction(k+1, h.GetData());
+   WaitDots();
+   nom0 = nom = h(k);
+   d = br;
+   if (k > 0)
+   {
+      Einv.Mult(h.GetData(), mu.GetData());
+      MultiAdd(k, W, mu.GetData(), -1.0, d); // d = B r - W E^{-1} (A W)^t B r
+   }
+   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, nom, r, x);
+
+   if (nom < 0.0)
+   {
+      if (print_level >= 0)
+      {
+         mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                   << nom << '\n';
+      }
+      converged = 0;
+      final_iter = 0;
+      final_norm = nom;
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (nom <= r0)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
+
+   P.SetSize(n, m);
+   AP.SetSize(n, m);
+   oper->Mult(d, q);  // q = A d
+   den = Dot(q, d);
+   MFEM_ASSERT(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_level >= 0)
+      {
+         mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                   << den << '\n';
+      }
+      if (den == 0.0)
+      {
+         converged = 0;
+         final_iter = 0;
+         final_norm = sqrt(nom);
+         return;
+      }
+   }
+
+   // start iteration
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      if (np < m)
+      {
+         Vector pj;
+         P.GetVectorView(np, pj);
+         pj = d;
+         AP.GetVectorView(np, pj);
+         pj = q;
+         np++;
+      }
+      alpha = nom/den;
+      add(x,  alpha, d, x);     //  x = x + alpha d
+      add(r, -alpha, q, r);     //  r = r - alpha A d
+
+      if (prec) { prec->Mult(r, z); } //  z = B r
+      MultiDotLocal(k, AW, br, h.GetData(), false);
+      h(k) = br * r;
+      StartReduction(k+1, h.GetData());
+      WaitDots();
+      betanom = h(k);
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                      << betanom << '\n';
+         }
+         converged = 0;
+         final_iter = i;
+         break;
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+
+      Monitor(i, betanom, r, x);
+
+      if (betanom < r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << betanom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      add(br, beta, d, d);   //  d = B r + beta d - W E^{-1} (A W)^t B r
+      if (k > 0)
+      {
+         Einv.Mult(h.GetData(), mu.GetData());
+         MultiAdd(k, W, mu.GetData(), -1.0, d);
+      }
+      oper->Mult(d, q);       //  q = A d
+      den = Dot(d, q);
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_level >= 0)
+         {
+            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      nom = betanom;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (betanom/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   UpdateRecycleSpace(np);
+}
+
+void SingleReductionCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   u.SetSize(width);
+   w.SetSize(width);
+   p.SetSize(width);
+   s.SetSize(width);
+   if (pipelined)
+   {
+      m.SetSize(width);
+      n.SetSize(width);
+      q.SetSize(width);
+      z.SetSize(width);
+   }
+}
+
+void SingleReductionCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE(pipelined ? "PipelinedCGSolver::Mult" :
+                   "SingleReductionCGSolver::Mult");
+   int i;
+   double dots[2], nom0 = 0.0, r0 = 0.0, betanom = 0.0;
+   double nom = 0.0, alpha = 0.0, beta, den;
+   const Vector *const dot_x[2] = { &r, &w };
+   const Vector *const dot_y[2] = { &u, &u };
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec) { prec->Mult(r, u); } // u = B r
+   else { u = r; }
+   oper->Mult(u, w);               // w = A u
+
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 0; true; i++)
+   {
+      // The two inner products (u, r) and (w, u) use a single reduction which,
+      // in the pipelined variant, is overlapped with m = B w and n = A m.
+      StartDots(2, dot_x, dot_y, dots);
+      if (pipelined)
+      {
+         if (prec) { prec->Mult(w, m); }
+         else { m = w; }
+         oper->Mult(m, n);
+      }
+      WaitDots();
+      betanom = dots[0];
+      den = dots[1];
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+
+      if (i == 0)
+      {
+         nom0 = betanom;
+         r0 = std::max(nom0*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (print_level == 1 || (i == 0 && print_level == 3))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << (i == 0 && print_level == 3 ? " ...\n" : "\n");
+      }
+      Monitor(i, betanom, r, x);
+
+      if (betanom < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. "
+                      "(Br, r) = " << betanom << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      if (betanom <= r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3 && i > 0)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << betanom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i == max_iter) { break; }
+
+      // With s = A p, (A p, p) = (w, u) - beta (B r, r)/alpha
+      beta = (i == 0) ? 0.0 : betanom/nom;
+      if (i > 0) { den -= beta*betanom/alpha; }
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The operator is not positive definite. "
+                      "(Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = betanom/den;
+      nom = betanom;
+
+      if (i == 0)
+      {
+         p = u;
+         s = w;
+         if (pipelined)
+         {
+            q = m;
+            z = n;
+         }
+      }
+      else
+      {
+         add(u, beta, p, p);   //  p = u + beta p
+         add(w, beta, s, s);   //  s = w + beta s
+         if (pipelined)
+         {
+            add(m, beta, q, q); //  q = m + beta q
+            add(n, beta, z, z); //  z = n + beta z
+         }
+      }
+      add(x,  alpha, p, x);    //  x = x + alpha p
+      add(r, -alpha, s, r);    //  r = r - alpha s
+      if (pipelined)
+      {
+         add(u, -alpha, q, u); //  u = u - alpha q
+         add(w, -alpha, z, w); //  w = w - alpha z
+      }
+      else
+      {
+         if (prec) { prec->Mult(r, u); }
+         else { u = r; }
+         oper->Mult(u, w);
+      }
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter
+                   << "  (B r, r) = " << betanom << '\n';
+      }
+      mfem::out << "PCG: No convergence!" << '\n';
    }
    if (print_level >= 1 || (print_level >= 0 && !converged))
    {
       mfem::out << "Average reduction factor = "
-                << pow (nom/nom0, 1.0/final_iter) << '\n';
+                << pow (betanom/nom0, 0.5/final_iter) << '\n';
    }
-   final_norm = nom;
-}
-
-void SLI(const Operator &A, const Vector &b, Vector &x,
-         int print_iter, int max_num_iter,
-         double RTOLERANCE, double ATOLERANCE)
-{
-   SLISolver sli;
-   sli.SetPrintLevel(print_iter);
-   sli.SetMaxIter(max_num_iter);
-   sli.SetRelTol(sqrt(RTOLERANCE));
-   sli.SetAbsTol(sqrt(ATOLERANCE));
-   sli.SetOperator(A);
-   sli.Mult(b, x);
-}
+   final_norm = sqrt(betanom);
 
-void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
-         int print_iter, int max_num_iter,
-         double RTOLERANCE, double ATOLERANCE)
-{
-   SLISolver sli;
-   sli.SetPrintLevel(print_iter);
-   sli.SetMaxIter(max_num_iter);
-   sli.SetRelTol(sqrt(RTOLERANCE));
-   sli.SetAbsTol(sqrt(ATOLERANCE));
-   sli.SetOperator(A);
-   sli.SetPreconditioner(B);
-   sli.Mult(b, x);
+   Monitor(final_iter, final_norm, r, x, true);
 }
 
-
-void CGSolver::UpdateVectors()
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
 {
-   r.SetSize(width);
-   d.SetSize(width);
-   z.SetSize(width);
+   MultiVector B, X;
+   B.MakeRef(const_cast<Vector&>(b), b.Size(), 1);
+   X.MakeRef(x, x.Size(), 1);
+   MultiMult(B, X);
 }
 
-void CGSolver::Mult(const Vector &b, Vector &x) const
+void BlockCGSolver::MultiMult(const MultiVector &B, MultiVector &X) const
 {
-   int i;
-   double r0, den, nom, nom0, betanom, alpha, beta;
+   MFEM_PERF_SCOPE("BlockCGSolver::MultiMult");
+   const int n = height, s = B.NumVectors();
+   MFEM_VERIFY(B.VectorSize() == n && X.VectorSize() == n &&
+               X.NumVectors() == s, "incompatible MultiVector sizes");
 
+   R.SetSize(n, s);
+   Z.SetSize(n, s);
    if (iterative_mode)
    {
-      oper->Mult(x, r);
-      subtract(b, r, r); // r = b - A x
+      oper->MultiMult(X, R);
+      subtract(B, R, R); // R = B - A X
    }
    else
    {
-      r = b;
-      x = 0.0;
+      R = B;
+      X = 0.0;
    }
-
    if (prec)
    {
-      prec->Mult(r, z); // z = B r
-      d = z;
+      prec->MultiMult(R, Z); // Z = B R
    }
    else
    {
-      d = r;
+      Z = R;
+   }
+   Xa = X;
+
+   // 'active' maps the vectors of R, Z and Xa to the vectors of X
+   Array<int> active(s);
+   Vector nom(s), r0(s), final_nom(s);
+   buf.SetSize(s);
+   Z.ColumnInnerProducts(R, buf);
+   Reduce(s);
+   for (int j = 0; j < s; j++)
+   {
+      active[j] = j;
+      nom(j) = final_nom(j) = buf(j);
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
    }
-   nom0 = nom = Dot(d, r);
-   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
    if (print_level == 1 || print_level == 3)
    {
-      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
-                << nom << (print_level == 3 ? " ...\n" : "\n");
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                << nom.Max() << (print_level == 3 ? " ...\n" : "\n");
    }
-   Monitor(0, nom, r, x);
-
-   if (nom < 0.0)
+   Monitor(0, sqrt(std::max(nom.Max(), 0.0)), R, X);
+   if (nom.Min() < 0.0)
    {
       if (print_level >= 0)
       {
-         mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
-                   << nom << '\n';
+         mfem::out << "BlockPCG: The preconditioner is not positive definite. "
+                   << "(Br, r) = " << nom.Min() << '\n';
       }
       converged = 0;
       final_iter = 0;
-      final_norm = nom;
-      return;
-   }
-   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
-   if (nom <= r0)
-   {
-      converged = 1;
-      final_iter = 0;
-      final_norm = sqrt(nom);
+      final_norm = sqrt(final_nom.Max());
       return;
    }
 
-   oper->Mult(d, z);  // z = A d
-   den = Dot(z, d);
-   MFEM_ASSERT(IsFinite(den), "den = " << den);
-   if (den <= 0.0)
+   DenseMatrix PQ, PR, QZ, LU;
+   Array<int> ipiv;
+   LUFactors lu;
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 1; true; )
    {
-      if (Dot(d, d) > 0.0 && print_level >= 0)
+      // Remove the converged vectors from the block, storing their solutions
+      int na = 0;
+      for (int j = 0; j < active.Size(); j++)
       {
-         mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
-                   << den << '\n';
+         if (nom(j) <= r0(j))
+         {
+            Xa.CopyVector(j, X, active[j]);
+            continue;
+         }
+         if (na != j)
+         {
+            R.CopyVector(j, R, na);
+            Z.CopyVector(j, Z, na);
+            Xa.CopyVector(j, Xa, na);
+            for (int k = 0; k < QZ.Height(); k++) { QZ(k,na) = QZ(k,j); }
+         }
+         active[na] = active[j];
+         nom(na) = nom(j);
+         r0(na) = r0(j);
+         na++;
       }
-      if (den == 0.0)
+      if (na == 0)
       {
-         converged = 0;
-         final_iter = 0;
-         final_norm = sqrt(nom);
-         return;
+         converged = 1;
+         final_iter = i-1;
+         break;
       }
-   }
-
-   // start iteration
-   converged = 0;
-   final_iter = max_iter;
-   for (i = 1; true; )
-   {
-      alpha = nom/den;
-      add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
+      if (i > max_iter) { break; }
+      active.SetSize(na);
+      nom.SetSize(na);
+      r0.SetSize(na);
+      R.SetSize(n, na);
+      Z.SetSize(n, na);
+      Xa.SetSize(n, na);
 
-      if (prec)
+      // New search directions: P = Z - P (P^T A P)^{-1} (A P)^T Z
+      if (i == 1)
       {
-         prec->Mult(r, z);      //  z = B r
-         betanom = Dot(r, z);
+         P = Z;
       }
       else
       {
-         betanom = Dot(r, r);
-      }
-      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
-      if (betanom < 0.0)
+         QZ.SetSize(QZ.Height(), na);
+         lu.Solve(PQ.Height(), na, QZ.Data());
+         Q = Z;
+         P.AddMult(QZ, Q, -1.0);
+         P.Swap(Q);
+      }
+      const int np = P.NumVectors();
+      Q.SetSize(n, np);
+      oper->MultiMult(P, Q); // Q = A P
+
+      // First reduction: P^T Q and P^T R
+      P.InnerProducts(Q, PQ);
+      P.InnerProducts(R, PR);
+      buf.SetSize(np*np + np*na);
+      std::copy(PQ.Data(), PQ.Data() + np*np, buf.GetData());
+      std::copy(PR.Data(), PR.Data() + np*na, buf.GetData() + np*np);
+      Reduce(buf.Size());
+      std::copy(buf.GetData(), buf.GetData() + np*np, PQ.Data());
+      std::copy(buf.GetData() + np*np, buf.GetData() + buf.Size(), PR.Data());
+
+      LU = PQ;
+      ipiv.SetSize(np);
+      lu.data = LU.Data();
+      lu.ipiv = ipiv.GetData();
+      if (!lu.Factor(np))
       {
          if (print_level >= 0)
          {
-            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
-                      << betanom << '\n';
+            mfem::out << "BlockPCG: Breakdown, (A P, P) is singular.\n";
          }
-         converged = 0;
          final_iter = i;
          break;
       }
-
-      if (print_level == 1)
+      lu.Solve(np, na, PR.Data()); // alpha = (P^T A P)^{-1} P^T R
+      P.AddMult(PR, Xa);           // X = X + P alpha
+      Q.AddMult(PR, R, -1.0);      // R = R - A P alpha
+      if (prec)
       {
-         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
-                   << betanom << '\n';
+         prec->MultiMult(R, Z);    // Z = B R
+      }
+      else
+      {
+         Z = R;
       }
 
-      Monitor(i, betanom, r, x);
-
-      if (betanom < r0)
+      // Second reduction: Q^T Z and (Z_j, R_j)
+      Q.InnerProducts(Z, QZ);
+      buf.SetSize(np*na + na);
+      std::copy(QZ.Data(), QZ.Data() + np*na, buf.GetData());
+      Vector nom_loc(buf.GetData() + np*na, na);
+      Z.ColumnInnerProducts(R, nom_loc);
+      Reduce(buf.Size());
+      std::copy(buf.GetData(), buf.GetData() + np*na, QZ.Data());
+      for (int j = 0; j < na; j++)
       {
-         if (print_level == 2)
-         {
-            mfem::out << "Number of PCG iterations: " << i << '\n';
-         }
-         else if (print_level == 3)
+         nom(j) = final_nom(active[j]) = buf(np*na + j);
+      }
+      MFEM_ASSERT(IsFinite(nom.Max()), "nom = " << nom.Max());
+      if (nom.Min() < 0.0)
+      {
+         if (print_level >= 0)
          {
-            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
-                      << betanom << '\n';
+            mfem::out << "BlockPCG: The preconditioner is not positive "
+                      << "definite. (Br, r) = " << nom.Min() << '\n';
          }
-         converged = 1;
          final_iter = i;
          break;
       }
-
-      if (++i > max_iter)
+      if (print_level == 1)
       {
-         break;
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << nom.Max() << '\n';
       }
+      Monitor(i, sqrt(nom.Max()), R, Xa);
+      i++;
+   }
+   // Store the solutions of the vectors that have not converged
+   for (int j = 0; j < active.Size(); j++)
+   {
+      Xa.CopyVector(j, X, active[j]);
+   }
+   final_norm = sqrt(final_nom.Max());
 
-      beta = betanom/nom;
-      if (prec)
-      {
-         add(z, beta, d, d);   //  d = z + beta d
-      }
-      else
-      {
-         add(r, beta, d, d);
-      }
-      oper->Mult(d, z);       //  z = A d
-      den = Dot(d, z);
-      MFEM_ASSERT(IsFinite(den), "den = " << den);
-      if (den <= 0.0)
-      {
-         if (Dot(d, d) > 0.0 && print_level >= 0)
-         {
-            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
-                      << den << '\n';
-         }
-         if (den == 0.0)
-         {
-            final_iter = i;
-            break;
-         }
-      }
-      nom = betanom;
+   if (print_level == 2)
+   {
+      mfem::out << "Number of BlockPCG iterations: " << final_iter << '\n';
    }
-   if (print_level >= 0 && !converged)
+   else if (print_level == 3)
    {
-      if (print_level != 1)
-      {
-         if (print_level != 3)
-         {
-            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
-                      << nom0 << " ...\n";
-         }
-         mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
-                   << betanom << '\n';
-      }
-      mfem::out << "PCG: No convergence!" << '\n';
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  max (B r, r) = " << final_nom.Max() << '\n';
    }
-   if (print_level >= 1 || (print_level >= 0 && !converged))
+   if (!converged && print_level >= 0)
    {
-      mfem::out << "Average reduction factor = "
-                << pow (betanom/nom0, 0.5/final_iter) << '\n';
+      mfem::out << "BlockPCG: No convergence!\n";
    }
-   final_norm = sqrt(betanom);
 
-   Monitor(final_iter, final_norm, r, x, true);
+   Monitor(final_iter, final_norm, R, X, true);
 }
 
 void CG(const Operator &A, const Vector &b, Vector &x,
@@ -795,8 +1769,27 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
    }
 }
 
+inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
+                   const Vector &V)
+{
+   Vector y(s);
+
+   // Backsolve:
+   for (int i = k; i >= 0; i--)
+   {
+      y(i) /= h(i,i);
+      for (int j = i - 1; j >= 0; j--)
+      {
+         y(j) -= h(j,i) * y(i);
+      }
+   }
+
+   MultiAdd(k+1, V, y.GetData(), 1.0, x);
+}
+
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("GMRESSolver::Mult");
    // Generalized Minimum Residual method following the algorithm
    // on p. 20 of the SIAM Templates book.
 
@@ -805,7 +1798,8 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
    DenseMatrix H(m+1, m);
    Vector s(m+1), cs(m+1), sn(m+1);
    Vector r(n), w(n);
-   Array<Vector *> v;
+   // The Krylov basis, stored as a multivector with columns v_i, i = 0,...,m
+   Vector V, vi;
 
    double resid;
    int i, j, k;
@@ -864,36 +1858,32 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
    Monitor(0, beta, r, x);
 
-   v.SetSize(m+1, NULL);
+   V.SetSize(n*(m+1));
 
    for (j = 1; j <= max_iter; )
    {
-      if (v[0] == NULL) { v[0] = new Vector(n); }
-      v[0]->Set(1.0/beta, r);
+      vi.MakeRef(V, 0, n);
+      vi.Set(1.0/beta, r);
       s = 0.0; s(0) = beta;
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
+         vi.MakeRef(V, i*n, n);
          if (prec)
          {
-            oper->Mult(*v[i], r);
+            oper->Mult(vi, r);
             prec->Mult(r, w);        // w = M A v[i]
          }
          else
          {
-            oper->Mult(*v[i], w);
-         }
-
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            oper->Mult(vi, w);
          }
 
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+         // H(k,i) = w * v[k], w -= H(k,i) * v[k], H(i+1,i) = ||w||
+         OrthogonalizeCGS2(i+1, V, w, &H(0,i));
          MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
-         if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
-         v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
+         vi.MakeRef(V, (i+1)*n, n);
+         vi.Set(1.0/H(i+1,i), w);      // v[i+1] = w / H(i+1,i)
 
          for (k = 0; k < i; k++)
          {
@@ -909,7 +1899,7 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
          if (resid <= final_norm)
          {
-            Update(x, i, H, s, v);
+            Update(x, i, H, s, V);
             final_norm = resid;
             final_iter = j;
             converged = 1;
@@ -931,7 +1921,7 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
          mfem::out << "Restarting..." << '\n';
       }
 
-      Update(x, i-1, H, s, v);
+      Update(x, i-1, H, s, V);
 
       oper->Mult(x, r);
       if (prec)
@@ -975,20 +1965,17 @@ finish:
    }
 
    Monitor(final_iter, final_norm, r, x, true);
-
-   for (i = 0; i < v.Size(); i++)
-   {
-      delete v[i];
-   }
 }
 
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("FGMRESSolver::Mult");
    DenseMatrix H(m+1,m);
    Vector s(m+1), cs(m+1), sn(m+1);
    Vector r(b.Size());
 
    int i, j, k;
+   const int n = b.Size();
 
 
    if (iterative_mode)
@@ -1023,48 +2010,35 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 
    Monitor(0, beta, r, x);
 
-   Array<Vector*> v(m+1);
-   Array<Vector*> z(m+1);
-   for (i= 0; i<=m; i++)
-   {
-      v[i] = NULL;
-      z[i] = NULL;
-   }
+   // The Krylov basis v_i and the preconditioned vectors z_i = M v_i, stored
+   // as multivectors
+   Vector V(n*(m+1)), Z(n*m), vi, zi;
 
    j = 1;
    while (j <= max_iter)
    {
-      if (v[0] == NULL) { v[0] = new Vector(b.Size()); }
-      (*v[0]) = 0.0;
-      v[0] -> Add (1.0/beta, r);   // v[0] = r / ||r||
+      vi.MakeRef(V, 0, n);
+      vi.Set(1.0/beta, r);         // v[0] = r / ||r||
       s = 0.0; s(0) = beta;
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
-
-         if (z[i] == NULL) { z[i] = new Vector(b.Size()); }
-         (*z[i]) = 0.0;
-
+         vi.MakeRef(V, i*n, n);
+         zi.MakeRef(Z, i*n, n);
          if (prec)
          {
-            prec->Mult(*v[i], *z[i]);
+            prec->Mult(vi, zi);
          }
          else
          {
-            (*z[i]) = (*v[i]);
+            zi = vi;
          }
-         oper->Mult(*z[i], r);
+         oper->Mult(zi, r);
 
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
-         }
-
-         H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
-         if (v[i+1] == NULL) { v[i+1] = new Vector(b.Size()); }
-         (*v[i+1]) = 0.0;
-         v[i+1] -> Add (1.0/H(i+1,i), r); // v[i+1] = r / H(i+1,i)
+         // H(k,i) = r * v[k], r -= H(k,i) * v[k], H(i+1,i) = ||r||
+         OrthogonalizeCGS2(i+1, V, r, &H(0,i));
+         vi.MakeRef(V, (i+1)*n, n);
+         vi.Set(1.0/H(i+1,i), r);   // v[i+1] = r / H(i+1,i)
 
          for (k = 0; k < i; k++)
          {
@@ -1087,7 +2061,7 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 
          if (resid <= final_norm)
          {
-            Update(x, i, H, s, z);
+            Update(x, i, H, s, Z);
             final_norm = resid;
             final_iter = j;
             converged = 1;
@@ -1096,12 +2070,6 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
             {
                mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
             }
-
-            for (i= 0; i<=m; i++)
-            {
-               if (v[i]) { delete v[i]; }
-               if (z[i]) { delete z[i]; }
-            }
             return;
          }
       }
@@ -1111,7 +2079,7 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
          mfem::out << "Restarting..." << endl;
       }
 
-      Update(x, i-1, H, s, z);
+      Update(x, i-1, H, s, Z);
 
       oper->Mult(x, r);
       subtract(b,r,r);
@@ -1127,21 +2095,10 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
          {
             mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
          }
-
-         for (i= 0; i<=m; i++)
-         {
-            if (v[i]) { delete v[i]; }
-            if (z[i]) { delete z[i]; }
-         }
          return;
       }
    }
 
-   for (i = 0; i <= m; i++)
-   {
-      if (v[i]) { delete v[i]; }
-      if (z[i]) { delete z[i]; }
-   }
    converged = 0;
 
    if (print_level >= 0)
@@ -1191,6 +2148,7 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("BiCGSTABSolver::Mult");
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
@@ -1251,8 +2209,10 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       else
       {
          beta = (rho_1/rho_2) * (alpha/omega);
-         add(p, -omega, v, p);  //  p = p - omega * v
-         add(r, beta, p, p);    //  p = r + beta * p
+         //  p = r + beta * (p - omega * v), in a single pass
+         const double pc[3] = { 1.0, beta, -beta*omega };
+         const Vector *pv[3] = { &r, &p, &v };
+         add(3, pc, pv, p);
       }
       if (prec)
       {
@@ -1264,8 +2224,8 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       }
       oper->Mult(phat, v);     //  v = A * phat
       alpha = rho_1 / Dot(rtilde, v);
-      add(r, -alpha, v, s); //  s = r - alpha * v
-      resid = Norm(s);
+      //  s = r - alpha * v and ||s|| in a single pass
+      resid = sqrt(GlobalSum(s.AxpbyNorm2(1.0, r, -alpha, v)));
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (resid < tol_goal)
       {
@@ -1291,13 +2251,23 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
          shat = s;
       }
       oper->Mult(shat, t);     //  t = A * shat
-      omega = Dot(t, s) / Dot(t, t);
-      x.Add(alpha, phat);   //  x += alpha * phat
-      x.Add(omega, shat);   //  x += omega * shat
-      add(s, -omega, t, r); //  r = s - omega * t
+      {
+         //  (t, s) and (t, t) with a single pass and reduction
+         double ts_tt[2];
+         const Vector *st[2] = { &s, &t };
+         t.MultiDot(2, st, ts_tt);
+         StartReduction(2, ts_tt);
+         WaitDots();
+         omega = ts_tt[0] / ts_tt[1];
+      }
+      //  x += alpha * phat + omega * shat
+      const double xc[3] = { 1.0, alpha, omega };
+      const Vector *xv[3] = { &x, &phat, &shat };
+      add(3, xc, xv, x);
+      //  r = s - omega * t and ||r|| in a single pass
+      resid = sqrt(GlobalSum(r.AxpbyNorm2(1.0, s, -omega, t)));
 
       rho_2 = rho_1;
-      resid = Norm(r);
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (print_level >= 0)
       {
@@ -1364,6 +2334,7 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("MINRESSolver::Mult");
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -1425,17 +2396,18 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
       {
          q.Add(-beta, v0);
       }
-      add(q, -alpha, v1, v0);
 
       delta = gamma1*alpha - gamma0*sigma1*beta;
       rho3 = sigma0*beta;
       rho2 = sigma1*alpha + gamma0*gamma1*beta;
       if (!prec)
       {
-         beta = Norm(v0);
+         // v0 = q - alpha v1 and ||v0|| in a single pass
+         beta = sqrt(GlobalSum(v0.AxpbyNorm2(1.0, q, -alpha, v1)));
       }
       else
       {
+         add(q, -alpha, v1, v0);
          prec->Mult(v0, q);
          beta = sqrt(Dot(v0, q));
       }
@@ -1446,14 +2418,13 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
       {
          w0.Set(1./rho1, *z);   // (w0 == 0) and (w1 == 0)
       }
-      else if (it == 2)
-      {
-         add(1./rho1, *z, -rho2/rho1, w1, w0);   // (w0 == 0)
-      }
       else
       {
-         add(-rho3/rho1, w0, -rho2/rho1, w1, w0);
-         w0.Add(1./rho1, *z);
+         // w0 = (z - rho2 w1 - rho3 w0)/rho1 in a single pass, where the last
+         // term is omitted for (it == 2) since (w0 == 0)
+         const double wc[3] = { 1./rho1, -rho2/rho1, -rho3/rho1 };
+         const Vector *wv[3] = { z, &w1, &w0 };
+         add(it == 2 ? 2 : 3, wc, wv, w0);
       }
 
       gamma0 = gamma1;
@@ -2277,6 +3248,9 @@ void BlockILU::SetOperator(const Operator &op)
    MFEM_ASSERT(A->Finalized(), "Matrix must be finalized.");
    CreateBlockPattern(*A);
    Factorize();
+   const int nblockrows = height/block_size;
+   lower_levels.Build(nblockrows, IB, JB, SparseLevelSchedule::LOWER);
+   upper_levels.Build(nblockrows, IB, JB, SparseLevelSchedule::UPPER);
 }
 
 void BlockILU::CreateBlockPattern(const SparseMatrix &A)
@@ -2486,51 +3460,69 @@ void BlockILU::Factorize()
 void BlockILU::Mult(const Vector &b, Vector &x) const
 {
    MFEM_ASSERT(height > 0, "BlockILU(0) preconditioner is not constructed");
-   int nblockrows = Height()/block_size;
    y.SetSize(Height());
 
-   DenseMatrix B;
-   Vector yi, yj, xi, xj;
-   Vector tmp(block_size);
+   // The block rows are processed by levels of independent rows, see
+   // SparseLevelSchedule, so the blocks are accessed through raw pointers
+   // instead of the shared DenseMatrix returned by DenseTensor::operator().
+   const int bs = block_size;
+   const double *ab = AB.Data();
+   const int *ib = IB.GetData(), *id = ID.GetData(), *jb = JB.GetData();
+   const int *p = P.GetData();
+   const double *bp = b.HostRead();
+   double *yp = y.HostWrite();
+   double *xp = x.HostWrite();
+
    // Forward substitute to solve Ly = b
    // Implicitly, L has identity on the diagonal
-   y = 0.0;
-   for (int i=0; i<nblockrows; ++i)
+   lower_levels.Forall([=](int i)
    {
-      yi.SetDataAndSize(&y[i*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+      double *yi = yp + i*bs;
+      for (int r = 0; r < bs; ++r)
       {
-         yi[ib] = b[ib + P[i]*block_size];
+         yi[r] = bp[r + p[i]*bs];
       }
-      for (int k=IB[i]; k<ID[i]; ++k)
+      for (int k = ib[i]; k < id[i]; ++k)
       {
-         int j = JB[k];
-         const DenseMatrix &L_ij = AB(k);
-         yj.SetDataAndSize(&y[j*block_size], block_size);
          // y_i = y_i - L_ij*y_j
-         L_ij.AddMult_a(-1.0, yj, yi);
+         const double *L_ij = ab + k*bs*bs;
+         const double *yj = yp + jb[k]*bs;
+         for (int c = 0; c < bs; ++c)
+         {
+            const double yj_c = -yj[c];
+            for (int r = 0; r < bs; ++r)
+            {
+               yi[r] += yj_c*L_ij[r + c*bs];
+            }
+         }
       }
-   }
+   });
    // Backward substitution to solve Ux = y
-   for (int i=nblockrows-1; i >= 0; --i)
+   upper_levels.Forall([=](int i)
    {
-      xi.SetDataAndSize(&x[P[i]*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+      double *xi = xp + p[i]*bs;
+      for (int r = 0; r < bs; ++r)
       {
-         xi[ib] = y[ib + i*block_size];
+         xi[r] = yp[r + i*bs];
       }
-      for (int k=ID[i]+1; k<IB[i+1]; ++k)
+      for (int k = id[i]+1; k < ib[i+1]; ++k)
       {
-         int j = JB[k];
-         const DenseMatrix &U_ij = AB(k);
-         xj.SetDataAndSize(&x[P[j]*block_size], block_size);
          // x_i = x_i - U_ij*x_j
-         U_ij.AddMult_a(-1.0, xj, xi);
+         const double *U_ij = ab + k*bs*bs;
+         const double *xj = xp + p[jb[k]]*bs;
+         for (int c = 0; c < bs; ++c)
+         {
+            const double xj_c = -xj[c];
+            for (int r = 0; r < bs; ++r)
+            {
+               xi[r] += xj_c*U_ij[r + c*bs];
+            }
+         }
       }
-      LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
+      LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*bs]);
       // x_i = D_ii^{-1} x_i
-      A_ii_inv.Solve(block_size, 1, xi);
-   }
+      A_ii_inv.Solve(bs, 1, xi);
+   });
 }
 
 #ifdef MFEM_USE_SUITESPARSE
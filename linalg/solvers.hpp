@@ -14,13 +14,13 @@
 
 #include "../config/config.hpp"
 #include "densemat.hpp"
+#include "sparsemat.hpp"
 
 #ifdef MFEM_USE_MPI
 #include <mpi.h>
 #endif
 
 #ifdef MFEM_USE_SUITESPARSE
-#include "sparsemat.hpp"
 #include <umfpack.h>
 #include <klu.h>
 #endif
@@ -58,6 +58,7 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   mutable MPI_Request dot_request; // see StartDots()
 #endif
 
 protected:
@@ -74,6 +75,36 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /** @brief Start the computation of the @a n dot products (*x[i], *y[i]),
+       i = 0,...,n-1, with a single global reduction. */
+   /** The local products are computed immediately and, in parallel, their
+       sum is started with a non-blocking MPI_Iallreduce. The results in
+       @a dots can be used only after the call to WaitDots(). */
+   void StartDots(int n, const Vector *const x[], const Vector *const y[],
+                  double *dots) const;
+   /** @brief Start the global sum of the @a n local values in @a dots, which
+       is completed by WaitDots(). */
+   void StartReduction(int n, double *dots) const;
+   /// Complete the reduction started with StartDots() or StartReduction().
+   void WaitDots() const;
+   /** @brief Return the global sum of the local value @a local, e.g. of a
+       local product returned by Vector::AxpyDot(), with the same reduction as
+       Dot(). */
+   double GlobalSum(double local) const;
+   /** @brief Compute the inner products h[k] = (V_k, w), k = 0,...,n-1, of
+       @a w with the first @a n columns V_k of the multivector @a V, and also
+       h[n] = (w, w) when @a with_norm is true, with a single global
+       reduction. */
+   /** The columns of @a V have size w.Size() and are stored contiguously in
+       column-major order. */
+   void MultiDot(int n, const Vector &V, const Vector &w, double *h,
+                 bool with_norm = false) const;
+   /** @brief Orthogonalize @a w against the first @a n columns of the
+       multivector @a V with classical Gram-Schmidt and one reorthogonalization
+       pass (CGS2), using two global reductions. */
+   /** The projections are returned in h[k], k = 0,...,n-1, and the norm of the
+       orthogonalized @a w in h[n]. */
+   void OrthogonalizeCGS2(int n, const Vector &V, Vector &w, double *h) const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -255,6 +286,142 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/** @brief Preconditioned conjugate gradient method with a single global
+    reduction per iteration (Chronopoulos-Gear). */
+/** The two inner products of every iteration, (B r, r) and (A B r, B r), are
+    computed together with StartDots(), and the search direction and its image
+    under A are updated by recurrences. Each iteration applies the operator and
+    the preconditioner once, as CGSolver. The tolerances and the printed and
+    monitored quantities are the same as in CGSolver. */
+class SingleReductionCGSolver : public IterativeSolver
+{
+protected:
+   /// Use the pipelined recurrences, see PipelinedCGSolver.
+   bool pipelined;
+   mutable Vector r, u, w, p, s; // u = B r, w = A u, s = A p
+   mutable Vector m, n, q, z;    // m = B w, n = A m, q = B s, z = A q
+
+   void UpdateVectors();
+
+public:
+   SingleReductionCGSolver() : pipelined(false) { }
+
+#ifdef MFEM_USE_MPI
+   SingleReductionCGSolver(MPI_Comm _comm)
+      : IterativeSolver(_comm), pipelined(false) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief Pipelined preconditioned conjugate gradient method
+    (Ghysels-Vanroose). */
+/** The single non-blocking reduction of every iteration is overlapped with
+    the application of the preconditioner and the operator, which act on the
+    auxiliary vector w = A B r instead of the new search direction. This hides
+    the latency of the reduction at the cost of four more vectors and vector
+    updates per iteration and a somewhat larger attainable accuracy floor. */
+class PipelinedCGSolver : public SingleReductionCGSolver
+{
+public:
+   PipelinedCGSolver() { pipelined = true; }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm _comm) : SingleReductionCGSolver(_comm)
+   { pipelined = true; }
+#endif
+};
+
+/** @brief Preconditioned conjugate gradient method with deflation by a
+    recycled subspace, for sequences of systems with the same or slowly
+    changing operator. */
+/** The solver keeps a subspace W of SetRecycleDim() vectors, together with
+    A W, across calls to Mult(). The initial guess is corrected by a Galerkin
+    projection on W and the search directions are kept A-orthogonal to W, so
+    the eigenvalues captured by W no longer slow down the convergence (deflated
+    CG of Saad, Yeung, Erhel and Guyomarc'h). The first 2 SetRecycleDim()
+    search directions of every solve are stored, and at the end of the solve W
+    is replaced by the Ritz vectors of A for the smallest Ritz values in the
+    span of W and the stored directions. SetOperator() keeps W and recomputes
+    A W, so that the subspace is reused and further improved when the operator
+    changes slightly, e.g. in time-stepping. */
+class RecycledCGSolver : public CGSolver
+{
+protected:
+   int rdim;
+   mutable MultiVector W, AW; // recycled subspace and its image under A
+   mutable DenseMatrix Einv;  // (W^t A W)^{-1}
+   mutable MultiVector P, AP; // stored search directions and their images
+   mutable Vector q, h;
+
+   /// Compute A W and (W^t A W)^{-1} for the current W.
+   void SetupRecycleSpace() const;
+   /** Replace W by the Ritz vectors for the smallest Ritz values of A in the
+       span of W and the first @a np stored search directions. */
+   void UpdateRecycleSpace(int np) const;
+
+public:
+   RecycledCGSolver() : rdim(10) { }
+
+#ifdef MFEM_USE_MPI
+   RecycledCGSolver(MPI_Comm _comm) : CGSolver(_comm), rdim(10) { }
+#endif
+
+   /// Set the dimension of the recycled subspace (default 10).
+   void SetRecycleDim(int dim) { rdim = dim; }
+
+   /// Discard the recycled subspace.
+   void ClearRecycleSpace() const { W.SetSize(0, 0); AW.SetSize(0, 0); }
+
+   /// Return the current dimension of the recycled subspace.
+   int GetRecycleSpaceDim() const { return W.NumVectors(); }
+
+   /** Also recomputes A W and (W^t A W)^{-1} if the size of the operator did
+       not change, otherwise the recycled subspace is discarded. */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief Block preconditioned conjugate gradient method (O'Leary) for
+    several right-hand sides. */
+/** All right-hand sides share one block Krylov space. Every iteration applies
+    the operator and the preconditioner to all search directions at once with
+    Operator::MultiMult() and needs two global reductions of small dense
+    matrices. A right-hand side is removed from the block as soon as its
+    preconditioned residual norm, sqrt((B r_j, r_j)), satisfies the tolerances
+    relative to its initial value, so the small systems remain nonsingular. The
+    right-hand sides are assumed to be linearly independent. GetFinalNorm()
+    returns the largest final residual norm. The IterativeSolverMonitor, if
+    any, receives the largest norm, and the residuals and the solutions of the
+    vectors still in the block, stored one after the other; the final call
+    receives all solutions. */
+class BlockCGSolver : public IterativeSolver
+{
+protected:
+   mutable MultiVector R, Z, P, Q, Xa; // Xa = not yet converged solutions
+   mutable Vector buf;
+
+   void Reduce(int n) const
+   { StartReduction(n, buf.GetData()); WaitDots(); }
+
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Solve for a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve for all right-hand sides in @a B.
+   virtual void MultiMult(const MultiVector &B, MultiVector &X) const;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -608,7 +775,10 @@ public:
     */
    void SetOperator(const Operator &op);
 
-   /// Solve the system `LUx = b`, where `L` and `U` are the block ILU factors.
+   /** Solve the system `LUx = b`, where `L` and `U` are the block ILU factors.
+    *  The independent block rows of the substitutions are processed in
+    *  parallel when Backend::THREADS is enabled.
+    */
    void Mult(const Vector &b, Vector &x) const;
 
    /** Get the I array for the block CSR representation of the factorization.
@@ -658,6 +828,11 @@ private:
    mutable DenseTensor DB;
    /// Pivot arrays for the LU factorizations given by #DB
    mutable Array<int> ipiv;
+
+   /** Level schedules of the block forward and backward substitutions, used
+    *  to process independent block rows in parallel in Mult().
+    */
+   SparseLevelSchedule lower_levels, upper_levels;
 };
 
 #ifdef MFEM_USE_SUITESPARSE
@@ -28,6 +28,60 @@ namespace mfem
 
 using namespace std;
 
+void SparseLevelSchedule::Build(int n, const int *I, const int *J, Type type)
+{
+   Array<int> level(n);
+   level = 0;
+   int nlevels = (n > 0) ? 1 : 0;
+   if (type == UPPER)
+   {
+      for (int i = n-1; i >= 0; i--)
+      {
+         int l = 0;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            if (J[k] > i) { l = std::max(l, level[J[k]] + 1); }
+         }
+         level[i] = l;
+         nlevels = std::max(nlevels, l + 1);
+      }
+   }
+   else
+   {
+      for (int i = 0; i < n; i++)
+      {
+         // For GAUSS_SEIDEL, level[i] already bounds the levels of the rows
+         // j < i with a_ji != 0, which read the old value of row i
+         int l = level[i];
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            if (J[k] < i) { l = std::max(l, level[J[k]] + 1); }
+         }
+         level[i] = l;
+         nlevels = std::max(nlevels, l + 1);
+         if (type == GAUSS_SEIDEL)
+         {
+            for (int k = I[i]; k < I[i+1]; k++)
+            {
+               const int j = J[k];
+               if (j > i) { level[j] = std::max(level[j], l + 1); }
+            }
+         }
+      }
+   }
+
+   // Sort the rows by level, keeping the rows of each level increasing
+   offsets.SetSize(nlevels + 1);
+   offsets = 0;
+   for (int i = 0; i < n; i++) { offsets[level[i]+1]++; }
+   for (int l = 0; l < nlevels; l++) { offsets[l+1] += offsets[l]; }
+   rows.SetSize(n);
+   for (int i = 0; i < n; i++) { rows[offsets[level[i]]++] = i; }
+   for (int l = nlevels; l > 0; l--) { offsets[l] = offsets[l-1]; }
+   offsets[0] = 0;
+}
+
+
 SparseMatrix::SparseMatrix(int nrows, int ncols)
    : AbstractSparseMatrix(nrows, (ncols >= 0) ? ncols : nrows),
      Rows(new RowNode *[nrows]),
@@ -35,6 +89,7 @@ SparseMatrix::SparseMatrix(int nrows, int ncols)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     Levels(NULL),
      isSorted(false)
 {
    // We probably do not need to set the ownership flags here.
@@ -58,6 +113,7 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     Levels(NULL),
      isSorted(false)
 {
    I.Wrap(i, height+1, true);
@@ -76,6 +132,7 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n,
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     Levels(NULL),
      isSorted(issorted)
 {
    I.Wrap(i, height+1, ownij);
@@ -106,6 +163,7 @@ SparseMatrix::SparseMatrix(int nrows, int ncols, int rowsize)
    , ColPtrJ(NULL)
    , ColPtrNode(NULL)
    , At(NULL)
+   , Levels(NULL)
    , isSorted(false)
 {
 #ifdef MFEM_USE_MEMALLOC
@@ -183,6 +241,7 @@ SparseMatrix::SparseMatrix(const SparseMatrix &mat, bool copy_graph)
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   Levels = NULL;
    isSorted = mat.isSorted;
 }
 
@@ -192,6 +251,7 @@ SparseMatrix::SparseMatrix(const Vector &v)
    , ColPtrJ(NULL)
    , ColPtrNode(NULL)
    , At(NULL)
+   , Levels(NULL)
    , isSorted(true)
 {
 #ifdef MFEM_USE_MEMALLOC
@@ -246,6 +306,7 @@ void SparseMatrix::SetEmpty()
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   Levels = NULL;
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
@@ -616,6 +677,47 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 #endif
 }
 
+void SparseMatrix::MultiMult(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_ASSERT(width == X.VectorSize(), "Input vector size ("
+               << X.VectorSize() << ") must match matrix width (" << width
+               << ")");
+   MFEM_ASSERT(height == Y.VectorSize() && X.NumVectors() == Y.NumVectors(),
+               "incompatible output MultiVector");
+
+   if (!Finalized())
+   {
+      Operator::MultiMult(X, Y);
+      return;
+   }
+
+   const int height = this->height;
+   const int width = this->width;
+   const int nvec = X.NumVectors();
+   const int nnz = J.Capacity();
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   auto d_x = X.Read();
+   Y.UseDevice(true);
+   auto d_y = Y.Write();
+   MFEM_FORALL(i, height,
+   {
+      const int begin = d_I[i], end = d_I[i+1];
+      // The entries of row i are reused from the cache for all vectors
+      for (int k = 0; k < nvec; k++)
+      {
+         const double *x_k = d_x + k*width;
+         double d = 0.0;
+         for (int j = begin; j < end; j++)
+         {
+            d += d_A[j] * x_k[d_J[j]];
+         }
+         d_y[i + k*height] = d;
+      }
+   });
+}
+
 void SparseMatrix::MultTranspose(const Vector &x, Vector &y) const
 {
    if (Finalized()) { y.UseDevice(true); }
@@ -682,6 +784,25 @@ void SparseMatrix::ResetTranspose() const
    At = NULL;
 }
 
+void SparseMatrix::BuildLevelSchedule() const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+   MFEM_VERIFY(height == width, "Matrix must be square.");
+   if (Levels == NULL)
+   {
+      const int nnz = J.Capacity();
+      Levels = new SparseLevelSchedule;
+      Levels->Build(height, HostRead(I, height+1), HostRead(J, nnz),
+                    SparseLevelSchedule::GAUSS_SEIDEL);
+   }
+}
+
+void SparseMatrix::ResetLevelSchedule() const
+{
+   delete Levels;
+   Levels = NULL;
+}
+
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
@@ -1960,6 +2081,42 @@ void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
       double *yp = y.HostReadWrite();
       const double *xp = x.HostRead();
 
+      if (Device::Allows(Backend::THREADS_MASK))
+      {
+         BuildLevelSchedule();
+         Levels->Forall([=](int i)
+         {
+            double sum = 0.0;
+            int d = -1;
+            for (int j = Ip[i]; j < Ip[i+1]; j++)
+            {
+               const int c = Jp[j];
+               if (c == i)
+               {
+                  d = j;
+               }
+               else
+               {
+                  sum += Ap[j] * yp[c];
+               }
+            }
+
+            if (d >= 0 && Ap[d] != 0.0)
+            {
+               yp[i] = (xp[i] - sum) / Ap[d];
+            }
+            else if (xp[i] == sum)
+            {
+               yp[i] = sum;
+            }
+            else
+            {
+               mfem_error("SparseMatrix::Gauss_Seidel_forw(...) #3");
+            }
+         });
+         return;
+      }
+
       for (int i = 0, j = Ip[0]; i < s; i++)
       {
          const int end = Ip[i+1];
@@ -2043,6 +2200,42 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
       double *yp = y.HostReadWrite();
       const double *xp = x.HostRead();
 
+      if (Device::Allows(Backend::THREADS_MASK))
+      {
+         BuildLevelSchedule();
+         Levels->Forall([=](int i)
+         {
+            double sum = 0.;
+            int d = -1;
+            for (int j = Ip[i+1]-1; j >= Ip[i]; j--)
+            {
+               const int c = Jp[j];
+               if (c == i)
+               {
+                  d = j;
+               }
+               else
+               {
+                  sum += Ap[j] * yp[c];
+               }
+            }
+
+            if (d >= 0 && Ap[d] != 0.0)
+            {
+               yp[i] = (xp[i] - sum) / Ap[d];
+            }
+            else if (xp[i] == sum)
+            {
+               yp[i] = sum;
+            }
+            else
+            {
+               mfem_error("SparseMatrix::Gauss_Seidel_back(...) #3");
+            }
+         }, true);
+         return;
+      }
+
       for (int i = s-1, j = Ip[s]-1; i >= 0; i--)
       {
          const int beg = Ip[i];
@@ -2938,6 +3131,7 @@ void SparseMatrix::Destroy()
    delete NodesMem;
 #endif
    delete At;
+   delete Levels;
 }
 
 int SparseMatrix::ActualWidth() const
@@ -3665,6 +3859,7 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ColPtrJ, other.ColPtrJ);
    mfem::Swap(ColPtrNode, other.ColPtrNode);
    mfem::Swap(At, other.At);
+   mfem::Swap(Levels, other.Levels);
 
 #ifdef MFEM_USE_MEMALLOC
    mfem::Swap(NodesMem, other.NodesMem);
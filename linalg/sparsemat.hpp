@@ -19,11 +19,88 @@
 #include "../general/device.hpp"
 #include "../general/table.hpp"
 #include "../general/globals.hpp"
+#include "../general/threads.hpp"
 #include "densemat.hpp"
 
 namespace mfem
 {
 
+/// Level schedule of the rows of a sparse triangular sweep.
+/** The rows are grouped into levels such that the rows of a level depend only
+    on rows of the previous levels. The levels are processed in order and the
+    rows of each level in parallel when Backend::THREADS is enabled, giving the
+    same result as the sequential sweep. */
+class SparseLevelSchedule
+{
+public:
+   /// Dependencies between the rows of the sweep.
+   enum Type
+   {
+      /** Forward substitution: row i depends on the columns j < i of row i.
+          Use with Forall(). */
+      LOWER,
+      /** Backward substitution: row i depends on the columns j > i of row i.
+          Use with Forall(). */
+      UPPER,
+      /** In-place Gauss-Seidel sweeps: row i depends on the rows j < i that
+          are connected to it, i.e. with a_ij != 0 or a_ji != 0. Use with
+          Forall() for the forward sweep and with Forall(body, true) for the
+          backward sweep. */
+      GAUSS_SEIDEL
+   };
+
+protected:
+   Array<int> offsets; // level l has the rows rows[offsets[l]..offsets[l+1])
+   Array<int> rows;
+
+public:
+   SparseLevelSchedule() { }
+
+   /** @brief Build the schedule of the square CSR pattern @a I, @a J with
+       @a n rows. */
+   void Build(int n, const int *I, const int *J, Type type);
+
+   /// Return the number of levels.
+   int NumLevels() const { return offsets.Size() ? offsets.Size()-1 : 0; }
+
+   /// Return the number of rows.
+   int Size() const { return rows.Size(); }
+
+   /// Return the rows sorted by level; the rows of a level are increasing.
+   const Array<int> &GetRows() const { return rows; }
+
+   /// Return the offsets of the levels in GetRows().
+   const Array<int> &GetLevelOffsets() const { return offsets; }
+
+   /** @brief Call @a body(i) for all rows i, level by level, in increasing
+       order of the levels or, if @a reverse is true, in decreasing order. */
+   template <typename BODY>
+   void Forall(BODY &&body, bool reverse = false) const
+   {
+      const bool use_threads = Device::Allows(Backend::THREADS_MASK);
+      const int nlevels = NumLevels();
+      for (int k = 0; k < nlevels; k++)
+      {
+         const int l = reverse ? nlevels-1-k : k;
+         const int *lrows = rows.GetData() + offsets[l];
+         const int size = offsets[l+1] - offsets[l];
+         if (use_threads && size >= 128)
+         {
+            ThreadExecutor &exec = GetThreadExecutor();
+            const int grain = ThreadsGrainSize(size, exec.NumThreads(), 64);
+            exec.ParallelFor(size, grain, [&](int begin, int end)
+            {
+               for (int r = begin; r < end; r++) { body(lrows[r]); }
+            });
+         }
+         else
+         {
+            for (int r = 0; r < size; r++) { body(lrows[r]); }
+         }
+      }
+   }
+};
+
 class
 #if defined(__alignas_is_defined)
    alignas(double)
@@ -69,6 +146,9 @@ protected:
    /// Transpose of A. Owned. Used to perform MultTranspose() on devices.
    mutable SparseMatrix *At;
 
+   /// Level schedule of the Gauss-Seidel sweeps. Owned.
+   mutable SparseLevelSchedule *Levels;
+
 #ifdef MFEM_USE_MEMALLOC
    typedef MemAlloc <RowNode, 1024> RowNodeAlloc;
    RowNodeAlloc * NodesMem;
@@ -270,6 +350,10 @@ public:
    /// y += A * x (default)  or  y += a * A * x
    void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
+   /** @brief Matrix multiplication with all vectors of @a X: Y_j = A * X_j.
+       The rows of the finalized matrix are read once for all vectors. */
+   virtual void MultiMult(const MultiVector &X, MultiVector &Y) const;
+
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -395,9 +479,32 @@ public:
    virtual void EliminateZeroRows(const double threshold = 1e-12);
 
    /// Gauss-Seidel forward and backward iterations over a vector x.
+   /** When the matrix is finalized and Backend::THREADS is enabled, the rows
+       are processed in parallel following the level schedule built with
+       BuildLevelSchedule(), with the same result as the sequential sweep. */
    void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
    void Gauss_Seidel_back(const Vector &x, Vector &y) const;
 
+   /** @brief Build and store internally the level schedule of the Gauss-Seidel
+       sweeps, see SparseLevelSchedule::GAUSS_SEIDEL. */
+   /** The schedule depends only on the sparsity pattern and is built on the
+       first threaded call of Gauss_Seidel_forw() or Gauss_Seidel_back(). If
+       it is already built, this method has no effect.
+
+       Warning: changes in the sparsity pattern of this matrix invalidate the
+       schedule. To rebuild it, call ResetLevelSchedule() followed by a call to
+       this method.
+
+       This method can only be used when the sparse matrix is finalized. */
+   void BuildLevelSchedule() const;
+
+   /** Reset (destroy) the internal level schedule. See BuildLevelSchedule()
+       for more details. */
+   void ResetLevelSchedule() const;
+
+   /// Return the internal level schedule, or NULL if it is not built.
+   const SparseLevelSchedule *GetLevelSchedule() const { return Levels; }
+
    /// Determine appropriate scaling for Jacobi iteration
    double GetJacobiScaling() const;
    /** One scaled Jacobi iteration for the system A x = b.
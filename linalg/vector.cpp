@@ -382,6 +382,98 @@ void add(const double a, const Vector &x,
    }
 }
 
+// Maximum number of vectors combined in one pass of the fused kernels
+static const int max_fused_terms = 16;
+
+// y = x + sum_i a[i] v[i], or y = sum_i a[i] v[i] when x is NULL, in passes
+// over y of up to max_fused_terms nonzero terms.
+static void MultiAdd(const Vector *x, int n, const double *a,
+                     const Vector *const *v, Vector &y)
+{
+   const int N = y.Size();
+   int i0 = 0;
+   bool first = true;
+   do
+   {
+      int m = 0;
+      double am[max_fused_terms];
+      const Vector *vm[max_fused_terms];
+      for ( ; i0 < n && m < max_fused_terms; i0++)
+      {
+         if (a[i0] == 0.0) { continue; }
+         MFEM_ASSERT(v[i0]->Size() == N, "incompatible Vectors!");
+         MFEM_ASSERT(first || v[i0] != &y,
+                     "the output must not be a term after the first "
+                     << max_fused_terms << " nonzero terms");
+         am[m] = a[i0];
+         vm[m++] = v[i0];
+      }
+      if (!first && m == 0) { break; }
+      bool use_dev = y.UseDevice() || (x && x->UseDevice());
+      for (int j = 0; j < m; j++) { use_dev = use_dev || vm[j]->UseDevice(); }
+#if !defined(MFEM_USE_LEGACY_OPENMP)
+      const double *vd[max_fused_terms];
+      for (int j = 0; j < m; j++) { vd[j] = vm[j]->Read(use_dev); }
+      const double *xd;
+      double *yd;
+      if (!first || x == &y)
+      {
+         yd = y.ReadWrite(use_dev);
+         xd = yd;
+      }
+      else
+      {
+         // Note: get read access first, in case y is the same as x.
+         xd = x ? x->Read(use_dev) : NULL;
+         yd = y.Write(use_dev);
+      }
+      const bool add_x = (xd != NULL);
+      MFEM_FORALL_SWITCH(use_dev, i, N,
+      {
+         double yi = add_x ? xd[i] : 0.0;
+         for (int j = 0; j < m; j++) { yi += am[j]*vd[j][i]; }
+         yd[i] = yi;
+      });
+#else
+      const double *vd[max_fused_terms];
+      for (int j = 0; j < m; j++) { vd[j] = vm[j]->HostRead(); }
+      const double *xd = (!first || x == &y) ? y.HostRead() :
+                         (x ? x->HostRead() : NULL);
+      double *yd = y.HostReadWrite();
+      #pragma omp parallel for
+      for (int i = 0; i < N; i++)
+      {
+         double yi = xd ? xd[i] : 0.0;
+         for (int j = 0; j < m; j++) { yi += am[j]*vd[j][i]; }
+         yd[i] = yi;
+      }
+#endif
+      first = false;
+   }
+   while (i0 < n);
+}
+
+void add(const Vector &x, int n, const double *a, const Vector *v, Vector &y)
+{
+   MFEM_ASSERT(x.size == y.size, "incompatible Vectors!");
+   // Pass the terms in groups, continuing the sum in y after the first one
+   const Vector *vp[max_fused_terms];
+   int i0 = 0;
+   do
+   {
+      const int m = std::min(n - i0, max_fused_terms);
+      for (int j = 0; j < m; j++) { vp[j] = &v[i0+j]; }
+      MultiAdd(i0 == 0 ? &x : &y, m, a + i0, vp, y);
+      i0 += m;
+   }
+   while (i0 < n);
+}
+
+void add(int n, const double *a, const Vector *const v[], Vector &y)
+{
+   MultiAdd(NULL, n, a, v, y);
+}
+
 void subtract(const Vector &x, const Vector &y, Vector &z)
 {
    MFEM_ASSERT(x.size == y.size && x.size == z.size,
@@ -1019,11 +1111,7 @@ double Vector::operator*(const Vector &v) const
    MFEM_ASSERT(size == v.size, "incompatible Vectors!");
 
    const bool use_dev = UseDevice() || v.UseDevice();
-#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP) || defined(MFEM_USE_OPENMP)
    auto m_data = Read(use_dev);
-#else
-   Read(use_dev);
-#endif
    auto v_data = v.Read(use_dev);
 
    if (!use_dev) { goto vector_dot_cpu; }
@@ -1062,6 +1150,12 @@ double Vector::operator*(const Vector &v) const
       return prod;
    }
 #endif
+   if (Device::Allows(Backend::THREADS_MASK))
+   {
+      return ThreadsReduce(size, 0.0,
+                           [=](int i) { return m_data[i] * v_data[i]; },
+                           [](double a, double b) { return a + b; });
+   }
    if (Device::Allows(Backend::DEBUG))
    {
       const int N = size;
@@ -1079,6 +1173,147 @@ vector_dot_cpu:
    return operator*(v_data);
 }
 
+// Return true if the fused update-and-reduce kernels below run through the
+// host memory for the given use_dev, i.e. unless a device backend is used, in
+// which case they are composed of the separate kernels.
+static inline bool FusedReduceOnHost(bool use_dev)
+{
+   return !use_dev || !Device::Allows(Backend::DEVICE_MASK);
+}
+
+// Return the sum of body(i), i in [0,N), where body(i) may also update the
+// entries i of the vectors it uses. Without a parallel backend, four partial
+// sums are used, which the compiler can keep in SIMD registers.
+template <typename BODY>
+static double FusedSum(const int N, const bool use_dev, BODY &&body)
+{
+   if (use_dev && Device::Allows(Backend::THREADS_MASK))
+   {
+      return ThreadsReduce(N, 0.0, body,
+                           [](double a, double b) { return a + b; });
+   }
+#ifdef MFEM_USE_OPENMP
+   if (use_dev && Device::Allows(Backend::OMP_MASK))
+   {
+      double sum = 0.0;
+      #pragma omp parallel for reduction(+:sum)
+      for (int i = 0; i < N; i++) { sum += body(i); }
+      return sum;
+   }
+#endif
+   double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+   int i = 0;
+   for ( ; i + 4 <= N; i += 4)
+   {
+      s0 += body(i);
+      s1 += body(i+1);
+      s2 += body(i+2);
+      s3 += body(i+3);
+   }
+   for ( ; i < N; i++) { s0 += body(i); }
+   return (s0 + s1) + (s2 + s3);
+}
+
+double Vector::AxpyDot(double a, const Vector &x, const Vector &w)
+{
+   MFEM_ASSERT(size == x.size && size == w.size, "incompatible Vectors!");
+
+   const bool use_dev = UseDevice() || x.UseDevice() || w.UseDevice();
+   if (!FusedReduceOnHost(use_dev))
+   {
+      Add(a, x);
+      return (*this)*w;
+   }
+   const double *xd = x.Read(use_dev);
+   const double *wd = w.Read(use_dev);
+   double *yd = ReadWrite(use_dev);
+   // Note: yd[i] is written before wd[i] is read, in case w is *this.
+   return FusedSum(size, use_dev, [=](int i)
+   {
+      yd[i] += a*xd[i];
+      return yd[i]*wd[i];
+   });
+}
+
+double Vector::AxpbyNorm2(double a, const Vector &x, double b, const Vector &y)
+{
+   MFEM_ASSERT(size == x.size && size == y.size, "incompatible Vectors!");
+
+   const bool use_dev = UseDevice() || x.UseDevice() || y.UseDevice();
+   if (!FusedReduceOnHost(use_dev))
+   {
+      add(a, x, b, y, *this);
+      return (*this)*(*this);
+   }
+   // Note: get read access first, in case *this is the same as x or y.
+   const double *xd = x.Read(use_dev);
+   const double *yd = y.Read(use_dev);
+   double *zd = (&x == this || &y == this) ? ReadWrite(use_dev) :
+                Write(use_dev);
+   return FusedSum(size, use_dev, [=](int i)
+   {
+      const double zi = a*xd[i] + b*yd[i];
+      zd[i] = zi;
+      return zi*zi;
+   });
+}
+
+void Vector::MultiDot(int n, const Vector *const v[], double *d) const
+{
+   bool use_dev = UseDevice();
+   for (int k = 0; k < n; k++)
+   {
+      MFEM_ASSERT(v[k]->size == size, "incompatible Vectors!");
+      use_dev = use_dev || v[k]->UseDevice();
+   }
+   if (!FusedReduceOnHost(use_dev) ||
+       (use_dev && Device::Allows(Backend::OMP_MASK)))
+   {
+      for (int k = 0; k < n; k++) { d[k] = (*v[k])*(*this); }
+      return;
+   }
+
+   // Sums of a group of products
+   const int max_group = 8;
+   struct Sums
+   {
+      double s[max_group];
+   };
+   const int N = size;
+   const double *wd = Read(use_dev);
+   for (int k0 = 0; k0 < n; k0 += max_group)
+   {
+      const int m = std::min(n - k0, max_group);
+      const double *vd[max_group];
+      for (int j = 0; j < m; j++) { vd[j] = v[k0+j]->Read(use_dev); }
+      Sums sums;
+      for (int j = 0; j < max_group; j++) { sums.s[j] = 0.0; }
+      if (use_dev && Device::Allows(Backend::THREADS_MASK))
+      {
+         sums = ThreadsReduce(N, sums, [=](int i)
+         {
+            Sums r;
+            for (int j = 0; j < m; j++) { r.s[j] = vd[j][i]*wd[i]; }
+            return r;
+         },
+         [=](Sums a, const Sums &b)
+         {
+            for (int j = 0; j < m; j++) { a.s[j] += b.s[j]; }
+            return a;
+         });
+      }
+      else
+      {
+         for (int i = 0; i < N; i++)
+         {
+            const double wi = wd[i];
+            for (int j = 0; j < m; j++) { sums.s[j] += vd[j][i]*wi; }
+         }
+      }
+      for (int j = 0; j < m; j++) { d[k0+j] = sums.s[j]; }
+   }
+}
+
 double Vector::Min() const
 {
    if (size == 0) { return infinity(); }
@@ -1122,6 +1357,13 @@ double Vector::Min() const
    }
 #endif
 
+   if (Device::Allows(Backend::THREADS_MASK))
+   {
+      return ThreadsReduce(size, infinity(),
+                           [=](int i) { return m_data[i]; },
+                           [](double a, double b) { return std::min(a, b); });
+   }
+
    if (Device::Allows(Backend::DEBUG))
    {
       const int N = size;
@@ -223,6 +223,22 @@ public:
    /// Return the inner-product.
    double operator*(const Vector &v) const;
 
+   /// (*this) += a * x, returning the inner product of the result with @a w.
+   /** The update and the product are computed in a single pass over memory.
+       The vector @a w may be (*this), which gives the squared l2 norm of the
+       result. As with operator*(), the product is local to the processor. */
+   double AxpyDot(double a, const Vector &x, const Vector &w);
+
+   /// (*this) = a * x + b * y, returning the squared l2 norm of the result.
+   /** The update and the norm are computed in a single pass over memory. The
+       vector @a y may be (*this). */
+   double AxpbyNorm2(double a, const Vector &x, double b, const Vector &y);
+
+   /// Set d[i] to the inner product of (*this) with *v[i], i = 0,...,n-1.
+   /** The products are computed in groups of up to 8 vectors, with a single
+       pass over (*this) per group. */
+   void MultiDot(int n, const Vector *const v[], double *d) const;
+
    /// Copy Size() entries from @a v.
    Vector &operator=(const double *v);
 
@@ -271,6 +287,17 @@ public:
    friend void add(const double a, const Vector &x,
                    const double b, const Vector &y, Vector &z);
 
+   /// y = x + sum_{i<n} a[i] * v[i], computed in a single pass over y.
+   /** Terms with a[i] == 0 are skipped. The output @a y may be the same as
+       @a x, but not as any of the vectors @a v. */
+   friend void add(const Vector &x, int n, const double *a, const Vector *v,
+                   Vector &y);
+
+   /// y = sum_{i<n} a[i] * (*v[i]), computed in a single pass over y.
+   /** Terms with a[i] == 0 are skipped. The output @a y may be one of the
+       vectors *v[i] when there are at most 16 nonzero terms. */
+   friend void add(int n, const double *a, const Vector *const v[], Vector &y);
+
    /// Set v = v1 - v2.
    friend void subtract(const Vector &v1, const Vector &v2, Vector &v);
 
@@ -23,7 +23,9 @@
 #include "general/sort_pairs.hpp"
 #include "general/stable3d.hpp"
 #include "general/table.hpp"
+#include "general/threads.hpp"
 #include "general/tic_toc.hpp"
+#include "general/perf_regions.hpp"
 #ifdef MFEM_USE_ADIOS2
 #include "general/adios2stream.hpp"
 #endif
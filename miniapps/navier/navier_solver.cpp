@@ -254,7 +254,9 @@ void NavierSolver::Setup(double dt)
       SpInvOrthoPC = new OrthoSolver();
       SpInvOrthoPC->SetOperator(*SpInvPC);
    }
-   SpInv = new CGSolver(MPI_COMM_WORLD);
+   // The pressure Poisson system is solved in every time step with the same
+   // operator, so the solver recycles a deflation subspace between the steps.
+   SpInv = new RecycledCGSolver(MPI_COMM_WORLD);
    SpInv->iterative_mode = true;
    SpInv->SetOperator(*Sp);
    if (pres_dbcs.empty())
@@ -965,36 +967,16 @@ void NavierSolver::AddAccelTerm(VecFuncT *f, Array<int> &attr)
 
 void NavierSolver::SetTimeIntegrationCoefficients(int step)
 {
-   if (step == 0)
-   {
-      bd0 = 1.0;
-      bd1 = -1.0;
-      bd2 = 0.0;
-      bd3 = 0.0;
-      ab1 = 1.0;
-      ab2 = 0.0;
-      ab3 = 0.0;
-   }
-   else if (step == 1)
-   {
-      bd0 = 3.0 / 2.0;
-      bd1 = -4.0 / 2.0;
-      bd2 = 1.0 / 2.0;
-      bd3 = 0.0;
-      ab1 = 2.0;
-      ab2 = -1.0;
-      ab3 = 0.0;
-   }
-   else if (step == 2)
-   {
-      bd0 = 11.0 / 6.0;
-      bd1 = -18.0 / 6.0;
-      bd2 = 9.0 / 6.0;
-      bd3 = -2.0 / 6.0;
-      ab1 = 3.0;
-      ab2 = -3.0;
-      ab3 = 1.0;
-   }
+   // The BDFk/EXTk coefficients of the ODE solver, bootstrapped from order 1
+   double bd[4], ab[3];
+   BDFEXTSolver::GetCoefficients(std::min(step + 1, 3), bd, ab);
+   bd0 = bd[0];
+   bd1 = bd[1];
+   bd2 = bd[2];
+   bd3 = bd[3];
+   ab1 = ab[0];
+   ab2 = ab[1];
+   ab3 = ab[2];
 }
 
 void NavierSolver::PrintTimingData()
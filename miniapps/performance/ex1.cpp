@@ -13,6 +13,7 @@
 //               ex1 -m ../../data/ball-nurbs.mesh -std  -asm -pc ho  -sc
 //               ex1 -m ../../data/pipe-nurbs.mesh -perf -mf  -pc lor
 //               ex1 -m ../../data/pipe-nurbs.mesh -std  -asm -pc ho  -sc
+//               ex1 -m ../../data/fichera.mesh -perf -mf  -pc amg -sp
 //
 // Description:  This example code demonstrates the use of MFEM to define a
 //               simple finite element discretization of the Laplace problem
@@ -71,6 +72,7 @@ int main(int argc, char *argv[])
    const char *pc = "none";
    bool perf = true;
    bool matrix_free = true;
+   bool single_prec = false;
    bool visualization = 1;
 
    OptionsParser args(argc, argv);
@@ -91,7 +93,11 @@ int main(int argc, char *argv[])
                   "the high-performance version.");
    args.AddOption(&pc, "-pc", "--preconditioner",
                   "Preconditioner: lor - low-order-refined (matrix-free) GS, "
-                  "ho - high-order (assembled) GS, none.");
+                  "ho - high-order (assembled) GS, amg - smoothed aggregation "
+                  "AMG of the high-order matrix, none.");
+   args.AddOption(&single_prec, "-sp", "--single-precision", "-dp",
+                  "--double-precision",
+                  "Store the preconditioner in single precision.");
    args.AddOption(&static_cond, "-sc", "--static-condensation", "-no-sc",
                   "--no-static-condensation", "Enable static condensation.");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
@@ -113,9 +119,10 @@ int main(int argc, char *argv[])
                "--standard-version is not compatible with --matrix-free");
    args.PrintOptions(cout);
 
-   enum PCType { NONE, LOR, HO };
+   enum PCType { NONE, LOR, HO, AMG };
    PCType pc_choice;
    if (!strcmp(pc, "ho")) { pc_choice = HO; }
+   else if (!strcmp(pc, "amg")) { pc_choice = AMG; }
    else if (!strcmp(pc, "lor")) { pc_choice = LOR; }
    else if (!strcmp(pc, "none")) { pc_choice = NONE; }
    else
@@ -254,7 +261,10 @@ int main(int argc, char *argv[])
    BilinearForm *a = new BilinearForm(fespace);
    BilinearForm *a_pc = NULL;
    if (pc_choice == LOR) { a_pc = new BilinearForm(fespace_lor); }
-   if (pc_choice == HO)  { a_pc = new BilinearForm(fespace); }
+   if (pc_choice == HO || pc_choice == AMG)
+   {
+      a_pc = new BilinearForm(fespace);
+   }
 
    // 11. Assemble the bilinear form and the corresponding linear system,
    //     applying any necessary transformations such as: eliminating boundary
@@ -330,7 +340,7 @@ int main(int argc, char *argv[])
       a_pc->Assemble();
       a_pc->FormSystemMatrix(ess_tdof_list, A_pc);
    }
-   else if (pc_choice == HO)
+   else if (pc_choice == HO || pc_choice == AMG)
    {
       if (!matrix_free)
       {
@@ -347,16 +357,47 @@ int main(int argc, char *argv[])
    tic_toc.Stop();
    cout << " done, " << tic_toc.RealTime() << "s." << endl;
 
-   // Solve with CG or PCG, depending if the matrix A_pc is available
-   if (pc_choice != NONE)
+   // Setup the preconditioner, optionally stored in single precision while
+   // the CG iteration remains in double precision
+   cout << "Setting up the preconditioner ..." << flush;
+   tic_toc.Clear();
+   tic_toc.Start();
+   Solver *M = NULL;
+   FloatSparseMatrix *A_pc32 = NULL;
+   if (pc_choice == AMG)
+   {
+      SmoothedAggregationAMG *amg = new SmoothedAggregationAMG;
+      amg->SetSinglePrecision(single_prec);
+      amg->SetOperator(A_pc);
+      M = amg;
+   }
+   else if (pc_choice != NONE && single_prec)
+   {
+      A_pc32 = new FloatSparseMatrix(A_pc);
+      M = new FloatGSSmoother(*A_pc32);
+   }
+   else if (pc_choice != NONE)
+   {
+      M = new GSSmoother(A_pc);
+   }
+   tic_toc.Stop();
+   cout << " done, " << tic_toc.RealTime() << "s." << endl;
+
+   // Solve with CG or PCG, depending if the preconditioner is available
+   tic_toc.Clear();
+   tic_toc.Start();
+   if (M)
    {
-      GSSmoother M(A_pc);
-      PCG(*a_oper, M, B, X, 1, 500, 1e-12, 0.0);
+      PCG(*a_oper, *M, B, X, 1, 500, 1e-12, 0.0);
    }
    else
    {
       CG(*a_oper, B, X, 1, 500, 1e-12, 0.0);
    }
+   tic_toc.Stop();
+   cout << "Time to solution: " << tic_toc.RealTime() << "s." << endl;
+   delete M;
+   delete A_pc32;
 
    // 13. Recover the solution as a finite element grid function.
    if (perf && matrix_free)
@@ -0,0 +1,174 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+static double coeff(const Vector &x) { return 1.0 + x(0)*x(0) + x(1); }
+
+// Check that the elements of each color have no common dofs and that every
+// element has exactly one color.
+static void TestColoring(const FiniteElementSpace &fes)
+{
+   const Table &colors = fes.GetElementColoring();
+   Array<int> dofs, dof_color(fes.GetNDofs()), elem_count(fes.GetNE());
+   dof_color = -1;
+   elem_count = 0;
+   int conflicts = 0;
+   for (int c = 0; c < colors.Size(); c++)
+   {
+      for (int k = 0; k < colors.RowSize(c); k++)
+      {
+         const int e = colors.GetRow(c)[k];
+         elem_count[e]++;
+         fes.GetElementDofs(e, dofs);
+         for (int j = 0; j < dofs.Size(); j++)
+         {
+            const int d = (dofs[j] >= 0) ? dofs[j] : -1-dofs[j];
+            if (dof_color[d] == c) { conflicts++; }
+            dof_color[d] = c;
+         }
+      }
+   }
+   REQUIRE(conflicts == 0);
+   REQUIRE(elem_count.Min() == 1);
+   REQUIRE(elem_count.Max() == 1);
+}
+
+// Add the integrators of the given test case to the forms.
+static void AddIntegrators(int test_case, Coefficient &q, VectorCoefficient &f,
+                           BilinearForm &a, LinearForm &b)
+{
+   if (test_case == 0)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(q));
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.AddBoundaryIntegrator(new MassIntegrator(q));
+      b.AddDomainIntegrator(new DomainLFIntegrator(q));
+   }
+   else if (test_case == 1)
+   {
+      a.AddDomainIntegrator(new ElasticityIntegrator(q, q));
+      b.AddDomainIntegrator(new VectorDomainLFIntegrator(f));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new CurlCurlIntegrator(q));
+      a.AddDomainIntegrator(new VectorFEMassIntegrator);
+      b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(f));
+   }
+}
+
+static double MaxDiff(const SparseMatrix &A, const SparseMatrix &B)
+{
+   SparseMatrix *D = Add(1.0, A, -1.0, B);
+   const double max_diff = D->MaxNorm();
+   delete D;
+   return max_diff;
+}
+
+TEST_CASE("Colored element assembly", "[ColoredAssembly]")
+{
+   Mesh mesh(5, 3, Element::QUADRILATERAL, true);
+   FunctionCoefficient q(coeff);
+   Vector f_val(2);
+   f_val(0) = 1.0;
+   f_val(1) = -2.0;
+   VectorConstantCoefficient f(f_val);
+
+   H1_FECollection h1_fec(2, 2);
+   ND_FECollection nd_fec(2, 2);
+   L2_FECollection l2_fec(1, 2);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec);
+   FiniteElementSpace h1v_fes(&mesh, &h1_fec, 2);
+   FiniteElementSpace nd_fes(&mesh, &nd_fec);
+   FiniteElementSpace l2_fes(&mesh, &l2_fec);
+
+   TestColoring(h1_fes);
+   TestColoring(nd_fes);
+   TestColoring(l2_fes);
+
+   FiniteElementSpace *spaces[3] = { &h1_fes, &h1v_fes, &nd_fes };
+   for (int test_case = 0; test_case < 3; test_case++)
+   {
+      FiniteElementSpace *fes = spaces[test_case];
+      BilinearForm a_ref(fes), a(fes);
+      LinearForm b_ref(fes), b(fes);
+      AddIntegrators(test_case, q, f, a_ref, b_ref);
+      AddIntegrators(test_case, q, f, a, b);
+
+      a_ref.Assemble();
+      a_ref.Finalize();
+      b_ref.Assemble();
+      {
+         Device device("threads");
+         a.Assemble();
+         b.Assemble();
+      }
+      a.Finalize();
+      const double tol = 1e-12*a_ref.SpMat().MaxNorm();
+      REQUIRE(a.SpMat().Finalized());
+      REQUIRE(MaxDiff(a_ref.SpMat(), a.SpMat()) <= tol);
+      b -= b_ref;
+      REQUIRE(b.Normlinf() <= 1e-12*b_ref.Normlinf());
+
+      // Reassembly into the existing matrix
+      a.SpMat() = 0.0;
+      {
+         Device device("threads");
+         a.Assemble();
+      }
+      REQUIRE(MaxDiff(a_ref.SpMat(), a.SpMat()) <= tol);
+   }
+
+   // Forms whose element matrices are computed by the element assembly
+   // kernels, with concurrent colors in all builds
+   Mesh tri_mesh(4, 3, Element::TRIANGLE, true);
+   FiniteElementSpace tri_fes(&tri_mesh, &h1_fec);
+   FiniteElementSpace *ea_spaces[3] = { &h1_fes, &l2_fes, &tri_fes };
+   for (int k = 0; k < 3; k++)
+   {
+      BilinearForm a_ref(ea_spaces[k]), a(ea_spaces[k]);
+      BilinearForm *forms[2] = { &a_ref, &a };
+      for (int j = 0; j < 2; j++)
+      {
+         forms[j]->AddDomainIntegrator(new MassIntegrator(q));
+         forms[j]->AddDomainIntegrator(new DiffusionIntegrator);
+         forms[j]->AddDomainIntegrator(new ConvectionIntegrator(f));
+      }
+      a_ref.Assemble();
+      a_ref.Finalize();
+      {
+         Device device("threads");
+         a.Assemble();
+      }
+      a.Finalize();
+      REQUIRE(MaxDiff(a_ref.SpMat(), a.SpMat()) <=
+              1e-12*a_ref.SpMat().MaxNorm());
+   }
+
+   MixedBilinearForm m_ref(&h1_fes, &l2_fes), m(&h1_fes, &l2_fes);
+   m_ref.AddDomainIntegrator(new MixedScalarMassIntegrator(q));
+   m.AddDomainIntegrator(new MixedScalarMassIntegrator(q));
+   m_ref.Assemble();
+   m_ref.Finalize();
+   {
+      Device device("threads");
+      m.Assemble();
+   }
+   m.Finalize();
+   REQUIRE(m.SpMat().Height() == l2_fes.GetVSize());
+   REQUIRE(m.SpMat().Width() == h1_fes.GetVSize());
+   REQUIRE(MaxDiff(m_ref.SpMat(), m.SpMat()) <=
+           1e-12*m_ref.SpMat().MaxNorm());
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v = 0.0;
+   v(0) = x(1);
+   v(1) = -x(0);
+}
+
+static void AddIntegrators(bool dg, Coefficient &q, VectorCoefficient &vel,
+                           BilinearForm &a)
+{
+   a.AddDomainIntegrator(new MassIntegrator(q));
+   if (!dg)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(q));
+      a.AddDomainIntegrator(new ConvectionIntegrator(vel, -1.0));
+   }
+}
+
+static double MaxDiff(const SparseMatrix &A, const SparseMatrix &B)
+{
+   SparseMatrix *D = Add(1.0, A, -1.0, B);
+   const double max_diff = D->MaxNorm();
+   delete D;
+   return max_diff;
+}
+
+static void TestFullAssembly(Mesh &mesh, int order, bool dg)
+{
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   FiniteElementCollection *fec;
+   if (dg) { fec = new L2_FECollection(order, dim, BasisType::GaussLobatto); }
+   else { fec = new H1_FECollection(order, dim); }
+   FiniteElementSpace fes(&mesh, fec);
+
+   ConstantCoefficient q(2.0);
+   VectorFunctionCoefficient vel(dim, velocity);
+
+   Array<int> ess_tdofs;
+   if (!dg)
+   {
+      Array<int> ess_bdr(mesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   }
+   Vector x(fes.GetVSize()), b(fes.GetVSize());
+   x.Randomize(1);
+   b.Randomize(2);
+   Vector x_ref(x), b_ref(b), X_ref, B_ref;
+
+   BilinearForm a_ref(&fes);
+   AddIntegrators(dg, q, vel, a_ref);
+   a_ref.Assemble(0);
+   a_ref.Finalize(0);
+   SparseMatrix A_ref_full(a_ref.SpMat());
+   OperatorHandle A_ref;
+   a_ref.FormLinearSystem(ess_tdofs, x_ref, b_ref, A_ref, X_ref, B_ref);
+
+   {
+      Device device("threads");
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::FULL);
+      AddIntegrators(dg, q, vel, a);
+      a.Assemble();
+      a.Finalize();
+
+      const double tol = 1e-12*A_ref_full.MaxNorm();
+      REQUIRE(a.SpMat().Finalized());
+      REQUIRE(a.SpMat().NumNonZeroElems() == A_ref_full.NumNonZeroElems());
+      REQUIRE(MaxDiff(A_ref_full, a.SpMat()) <= tol);
+
+      OperatorHandle A;
+      Vector X, B;
+      a.FormLinearSystem(ess_tdofs, x, b, A, X, B);
+      REQUIRE(MaxDiff(*A_ref.As<SparseMatrix>(), *A.As<SparseMatrix>()) <= tol);
+      B -= B_ref;
+      REQUIRE(B.Normlinf() <= 1e-12*B_ref.Normlinf());
+   }
+   delete fec;
+}
+
+TEST_CASE("Full assembly from element matrices", "[FullAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      Mesh mesh_2d(3, 4, Element::QUADRILATERAL, true);
+      Mesh mesh_3d(2, 2, 3, Element::HEXAHEDRON, true);
+      TestFullAssembly(mesh_2d, order, false);
+      TestFullAssembly(mesh_2d, order, true);
+      TestFullAssembly(mesh_3d, order, false);
+      TestFullAssembly(mesh_3d, order, true);
+   }
+}
+
+static void TestHostFallback(FiniteElementSpace &fes, bool vector)
+{
+   ConstantCoefficient q(2.0);
+   BilinearForm a_ref(&fes);
+   if (vector) { a_ref.AddDomainIntegrator(new VectorMassIntegrator(q)); }
+   else
+   {
+      a_ref.AddDomainIntegrator(new MassIntegrator(q));
+      a_ref.AddBoundaryIntegrator(new BoundaryMassIntegrator(q));
+   }
+   a_ref.Assemble(0);
+   a_ref.Finalize(0);
+
+   Device device("threads");
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::FULL);
+   if (vector) { a.AddDomainIntegrator(new VectorMassIntegrator(q)); }
+   else
+   {
+      a.AddDomainIntegrator(new MassIntegrator(q));
+      a.AddBoundaryIntegrator(new BoundaryMassIntegrator(q));
+   }
+   a.Assemble(0);
+   a.Finalize(0);
+
+   REQUIRE(a.SpMat().NumNonZeroElems() == a_ref.SpMat().NumNonZeroElems());
+   REQUIRE(MaxDiff(a_ref.SpMat(), a.SpMat()) <=
+           1e-12*a_ref.SpMat().MaxNorm());
+}
+
+TEST_CASE("Full assembly of unsupported forms on the host", "[FullAssembly]")
+{
+   // Forms that FABilinearFormExtension cannot assemble, here with a boundary
+   // integrator or on a vector space, fall back to the host assembly.
+   Mesh mesh(3, 4, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   TestHostFallback(fes, false);
+   FiniteElementSpace vfes(&mesh, &fec, mesh.Dimension());
+   TestHostFallback(vfes, true);
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include <fstream>
+#include <iostream>
+
+using namespace mfem;
+
+namespace mf_kernels
+{
+
+void velocity_function(const Vector &x, Vector &v)
+{
+   int dim = x.Size();
+   switch (dim)
+   {
+      case 1: v(0) = 1.0; break;
+      case 2: v(0) = x(1); v(1) = -x(0); break;
+      case 3: v(0) = x(1); v(1) = -x(0); v(2) = x(0); break;
+   }
+}
+
+double coeff_function(const Vector &x)
+{
+   return 1.0 + x(0)*x(0);
+}
+
+BilinearFormIntegrator *NewIntegrator(int pb, Coefficient &q,
+                                      VectorCoefficient &vel)
+{
+   switch (pb)
+   {
+      case 0: return new MassIntegrator(q);
+      case 1: return new ConvectionIntegrator(vel, -1.0);
+      default: return new DiffusionIntegrator(q);
+   }
+}
+
+void test_mf(Mesh &&mesh, int order, const int pb, const int batch)
+{
+   mesh.EnsureNodes();
+   mesh.SetCurvature(mesh.GetNodalFESpace()->GetOrder(0));
+   int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   BilinearForm k_mf(&fespace);
+   BilinearForm k_pa(&fespace);
+
+   FunctionCoefficient q(coeff_function);
+   VectorFunctionCoefficient vel_coeff(dim, velocity_function);
+
+   k_pa.AddDomainIntegrator(NewIntegrator(pb, q, vel_coeff));
+   BilinearFormIntegrator *integ = NewIntegrator(pb, q, vel_coeff);
+   integ->SetMFBatchSize(batch);
+   k_mf.AddDomainIntegrator(integ);
+
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   k_mf.SetAssemblyLevel(AssemblyLevel::NONE);
+   k_mf.Assemble();
+
+   GridFunction x(&fespace), y_pa(&fespace), y_mf(&fespace);
+
+   x.Randomize(1);
+
+   k_pa.Mult(x,y_pa);
+   k_mf.Mult(x,y_mf);
+
+   y_mf -= y_pa;
+
+   REQUIRE(y_mf.Normlinf() < 1.e-12 * std::max(1.0, y_pa.Normlinf()));
+
+   if (pb != 1)
+   {
+      Vector diag_pa(fespace.GetVSize()), diag_mf(fespace.GetVSize());
+      k_pa.AssembleDiagonal(diag_pa);
+      k_mf.AssembleDiagonal(diag_mf);
+      diag_mf -= diag_pa;
+      REQUIRE(diag_mf.Normlinf() < 1.e-12 * std::max(1.0, diag_pa.Normlinf()));
+   }
+}
+
+TEST_CASE("Matrix-Free Assembly", "[MatrixFree]")
+{
+   SECTION("2D")
+   {
+      for (int pb : {0, 1, 2})
+      {
+         for (int batch : {3, 4096})
+         {
+            for (int order : {2, 3})
+            {
+               test_mf(Mesh("../../data/periodic-square.mesh", 1, 1), order, pb,
+                       batch);
+               test_mf(Mesh("../../data/star-q3.mesh", 1, 1), order, pb, batch);
+            }
+         }
+      }
+   }
+
+   SECTION("3D")
+   {
+      for (int pb : {0, 1, 2})
+      {
+         for (int batch : {3, 4096})
+         {
+            int order = 2;
+            test_mf(Mesh("../../data/periodic-cube.mesh", 1, 1), order, pb,
+                    batch);
+            test_mf(Mesh("../../data/fichera-q3.mesh", 1, 1), order, pb, batch);
+         }
+      }
+   }
+}
+
+} // namespace mf_kernels
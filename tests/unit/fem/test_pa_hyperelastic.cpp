@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_hyperelastic
+{
+
+static void deform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*sin(M_PI*x(1));
+   y(1) += 0.1*x(0)*x(0);
+}
+
+static double shear_modulus(const Vector &x)
+{
+   return 1.0 + x(0);
+}
+
+static double Error(const Vector &x, const Vector &x_ref)
+{
+   Vector diff(x);
+   diff -= x_ref;
+   return diff.Normlinf() / std::max(1.0, x_ref.Normlinf());
+}
+
+static HyperelasticModel *NewModel(int m, Coefficient &mu, Coefficient &K)
+{
+   switch (m)
+   {
+      case 0: return new InverseHarmonicModel;
+      case 1: return new NeoHookeanModel(0.25, 5.0, 1.2);
+      default: return new NeoHookeanModel(mu, K);
+   }
+}
+
+static void TestHyperelasticPA(Mesh &mesh, int order, int m)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+
+   FunctionCoefficient mu(shear_modulus);
+   ConstantCoefficient K(3.0);
+   HyperelasticModel *model_ref = NewModel(m, mu, K);
+   HyperelasticModel *model = NewModel(m, mu, K);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+
+   NonlinearForm nlf_ref(&fes);
+   nlf_ref.AddDomainIntegrator(new HyperelasticNLFIntegrator(model_ref));
+   nlf_ref.SetEssentialBC(ess_bdr);
+
+   NonlinearForm nlf(&fes);
+   nlf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf.SetEssentialBC(ess_bdr);
+   nlf.Setup();
+
+   // The state is a smooth deformation of the mesh
+   GridFunction x(&fes);
+   VectorFunctionCoefficient deformation(dim, deform);
+   x.ProjectCoefficient(deformation);
+
+   Vector y_ref(fes.GetTrueVSize()), y(fes.GetTrueVSize());
+   nlf_ref.Mult(x, y_ref);
+   nlf.Mult(x, y);
+   REQUIRE(Error(y, y_ref) <= 1e-12);
+
+   Vector v(fes.GetTrueVSize());
+   v.Randomize(1);
+   nlf_ref.GetGradient(x).Mult(v, y_ref);
+   nlf.GetGradient(x).Mult(v, y);
+   REQUIRE(Error(y, y_ref) <= 1e-12);
+
+   delete model;
+   delete model_ref;
+}
+
+TEST_CASE("PA hyperelastic integrator", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int simplex = 0; simplex <= 1; simplex++)
+      {
+         const Element::Type type = (dim == 2) ?
+                                    (simplex ? Element::TRIANGLE :
+                                     Element::QUADRILATERAL) :
+                                    (simplex ? Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON);
+         Mesh *mesh = (dim == 2) ? new Mesh(3, 3, type, true) :
+                      new Mesh(2, 2, 2, type, true);
+         for (int order = 1; order <= 2; order++)
+         {
+            for (int m = 0; m < 3; m++)
+            {
+               TestHyperelasticPA(*mesh, order, m);
+            }
+         }
+         delete mesh;
+      }
+   }
+}
+
+} // namespace pa_hyperelastic
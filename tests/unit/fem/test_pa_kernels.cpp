@@ -457,4 +457,117 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
    }
 }//test case
 
+double test_pa_mass_diffusion_3d(Mesh &mesh, int order, bool diffusion)
+{
+   H1_FECollection fec(order, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf_fa(&fes), blf_pa(&fes);
+   if (diffusion)
+   {
+      blf_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+      blf_pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+   }
+   else
+   {
+      blf_fa.AddDomainIntegrator(new MassIntegrator(one));
+      blf_pa.AddDomainIntegrator(new MassIntegrator(one));
+   }
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+   blf_fa.Mult(x, y_fa);
+
+   blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_pa.Assemble();
+   blf_pa.Mult(x, y_pa);
+
+   y_fa -= y_pa;
+   return y_fa.Norml2();
+}
+
+// The number of elements is not a multiple of the SIMD width to exercise the
+// padded lanes of the host SIMD kernels.
+TEST_CASE("PA Mass Diffusion 3D", "[PartialAssembly]")
+{
+   SECTION("Cartesian")
+   {
+      Mesh mesh(3, 2, 1, Element::HEXAHEDRON, 0, 1.0, 1.0, 1.0);
+      for (int order : {1, 2, 3, 4})
+      {
+         REQUIRE(test_pa_mass_diffusion_3d(mesh, order, false) < 1.e-12);
+         REQUIRE(test_pa_mass_diffusion_3d(mesh, order, true) < 1.e-12);
+      }
+   }
+
+   SECTION("Curved")
+   {
+      Mesh mesh("../../data/fichera-q3.mesh", 1, 1);
+      for (int order : {1, 2, 3})
+      {
+         REQUIRE(test_pa_mass_diffusion_3d(mesh, order, false) < 1.e-12);
+         REQUIRE(test_pa_mass_diffusion_3d(mesh, order, true) < 1.e-12);
+      }
+   }
+}
+
+static double batch_coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0);
+}
+
+// Relative difference between the element-batched action of
+// PABilinearFormExtension and the assembled matrix.
+static double test_pa_element_batches(Mesh &mesh, int order, int batch)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient q(batch_coeff);
+
+   BilinearForm blf_fa(&fes), blf_pa(&fes);
+   blf_fa.AddDomainIntegrator(new MassIntegrator(q));
+   blf_fa.AddDomainIntegrator(new DiffusionIntegrator(q));
+   blf_pa.AddDomainIntegrator(new MassIntegrator(q));
+   blf_pa.AddDomainIntegrator(new DiffusionIntegrator(q));
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+
+   PABilinearFormExtension pa_ext(&blf_pa);
+   pa_ext.Assemble();
+   pa_ext.SetElementBatchSize(batch);
+
+   Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   x.Randomize(1);
+   blf_fa.Mult(x, y_fa);
+   pa_ext.Mult(x, y_pa);
+
+   const double scale = std::max(1.0, y_fa.Normlinf());
+   y_fa -= y_pa;
+   return y_fa.Normlinf() / scale;
+}
+
+TEST_CASE("PA element batches", "[PartialAssembly]")
+{
+   const char *meshes[] = { "../../data/star-q3.mesh",
+                            "../../data/inline-tri.mesh",
+                            "../../data/fichera-q3.mesh",
+                            "../../data/inline-tet.mesh"
+                          };
+   for (int m = 0; m < 4; m++)
+   {
+      Mesh mesh(meshes[m], 1, 1);
+      for (int order : {1, 2})
+      {
+         for (int batch : {0, 1, 7})
+         {
+            REQUIRE(test_pa_element_batches(mesh, order, batch) < 1.e-12);
+         }
+      }
+   }
+}
+
 }// namespace pa_kernels
@@ -0,0 +1,162 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_simplices
+{
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v = 0.0;
+   v(0) = x(1);
+   v(1) = -x(0);
+}
+
+static double coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0);
+}
+
+static void perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(M_PI*x(1));
+   y(1) += 0.05*sin(M_PI*x(0));
+}
+
+static BilinearFormIntegrator *NewIntegrator(int pb, Coefficient &q,
+                                             VectorCoefficient &vel)
+{
+   static ConstantCoefficient two(2.0);
+   switch (pb)
+   {
+      case 0: return new MassIntegrator(q);
+      case 1: return new DiffusionIntegrator(q);
+      case 2: return new ConvectionIntegrator(vel, -1.0);
+      default: return new VectorMassIntegrator(two);
+   }
+}
+
+static void TestSimplexAssembly(Mesh &mesh, int order, int pb)
+{
+   const int dim = mesh.Dimension();
+   const bool vector = (pb == 3);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vector ? dim : 1);
+   REQUIRE(!UsesTensorBasis(fes));
+
+   FunctionCoefficient q(coeff);
+   VectorFunctionCoefficient vel(dim, velocity);
+
+   BilinearForm a_fa(&fes);
+   a_fa.AddDomainIntegrator(NewIntegrator(pb, q, vel));
+   a_fa.Assemble(0);
+   a_fa.Finalize(0);
+
+   Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y(fes.GetVSize());
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+   const double tol = 1e-12*std::max(1.0, y_fa.Normlinf());
+
+   // Vector mass has neither element assembly nor matrix-free kernels
+   const int nlevels = vector ? 1 : 3;
+   const AssemblyLevel levels[3] = { AssemblyLevel::PARTIAL,
+                                     AssemblyLevel::ELEMENT,
+                                     AssemblyLevel::NONE
+                                   };
+   for (int l = 0; l < nlevels; l++)
+   {
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(levels[l]);
+      a.AddDomainIntegrator(NewIntegrator(pb, q, vel));
+      a.Assemble();
+      a.Mult(x, y);
+      y -= y_fa;
+      REQUIRE(y.Normlinf() <= tol);
+
+      if (pb != 2 && levels[l] != AssemblyLevel::ELEMENT)
+      {
+         Vector diag(fes.GetVSize()), diag_fa(fes.GetVSize());
+         a.AssembleDiagonal(diag);
+         a_fa.SpMat().GetDiag(diag_fa);
+         diag -= diag_fa;
+         REQUIRE(diag.Normlinf() <= 1e-12*std::max(1.0, diag_fa.Normlinf()));
+      }
+   }
+}
+
+static void TestQuadratureInterpolator(Mesh &mesh, int order)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient q(coeff);
+   GridFunction u(&fes);
+   u.ProjectCoefficient(q);
+
+   const IntegrationRule &ir = IntRules.Get(mesh.GetElementBaseGeometry(0),
+                                            2*order);
+   const int ne = mesh.GetNE(), nq = ir.GetNPoints();
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(R->Height()), q_val(nq*ne), q_der(dim*nq*ne);
+   R->Mult(u, e_vec);
+   qi->Values(e_vec, q_val);
+   qi->PhysDerivatives(e_vec, q_der);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+
+   Vector grad(dim);
+   double err = 0.0;
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      for (int k = 0; k < nq; k++)
+      {
+         T.SetIntPoint(&ir.IntPoint(k));
+         u.GetGradient(T, grad);
+         err = std::max(err, fabs(u.GetValue(T, ir.IntPoint(k)) -
+                                  q_val(k + nq*e)));
+         for (int d = 0; d < dim; d++)
+         {
+            err = std::max(err, fabs(grad(d) - q_der(d + dim*(k + nq*e))));
+         }
+      }
+   }
+   REQUIRE(err <= 1e-12);
+}
+
+TEST_CASE("PA and EA on simplices", "[PartialAssembly], [ElementAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 3, Element::TRIANGLE, true) :
+                   new Mesh(2, 2, 2, Element::TETRAHEDRON, true);
+      mesh->SetCurvature(2);
+      mesh->Transform(perturb);
+      for (int order = 1; order <= 3; order++)
+      {
+         for (int pb = 0; pb < 4; pb++)
+         {
+            TestSimplexAssembly(*mesh, order, pb);
+         }
+         TestQuadratureInterpolator(*mesh, order);
+      }
+      delete mesh;
+   }
+}
+
+} // namespace pa_simplices
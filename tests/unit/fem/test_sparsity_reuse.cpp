@@ -0,0 +1,101 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+static void AddIntegrators(int space, Coefficient &q, BilinearForm &a)
+{
+   if (space == 0)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(q));
+      a.AddBoundaryIntegrator(new MassIntegrator(q));
+   }
+   else if (space == 1)
+   {
+      a.AddDomainIntegrator(new ElasticityIntegrator(q, q));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new CurlCurlIntegrator);
+      a.AddDomainIntegrator(new VectorFEMassIntegrator(q));
+   }
+}
+
+static double MaxDiff(const SparseMatrix &A, const SparseMatrix &B)
+{
+   SparseMatrix *D = Add(1.0, A, -1.0, B);
+   const double max_diff = D->MaxNorm();
+   delete D;
+   return max_diff;
+}
+
+TEST_CASE("Sparsity pattern reuse", "[BilinearForm]")
+{
+   Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+   H1_FECollection h1_fec(2, 2);
+   ND_FECollection nd_fec(2, 2);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec);
+   FiniteElementSpace h1v_fes(&mesh, &h1_fec, 2);
+   FiniteElementSpace nd_fes(&mesh, &nd_fec);
+   FiniteElementSpace *spaces[3] = { &h1_fes, &h1v_fes, &nd_fes };
+
+   for (int space = 0; space < 3; space++)
+   {
+      FiniteElementSpace &fes = *spaces[space];
+      Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdofs;
+      ess_bdr = 0;
+      ess_bdr[0] = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+      ConstantCoefficient q(1.0);
+      BilinearForm a(&fes);
+      AddIntegrators(space, q, a);
+      a.EnableSparsityReuse();
+
+      const double *data = NULL;
+      for (int step = 0; step < 3; step++)
+      {
+         q.constant = 1.0 + step;
+         BilinearForm a_ref(&fes);
+         AddIntegrators(space, q, a_ref);
+         // Keep the zeros, so that the pattern of a_ref remains symmetric
+         a_ref.Assemble(0);
+         a_ref.Finalize(0);
+
+         if (step == 2)
+         {
+            // Reassembly through the colored traversal
+            Device device("threads");
+            a.Assemble();
+         }
+         else
+         {
+            a.Assemble();
+         }
+         a.Finalize();
+         REQUIRE(a.SpMat().Finalized());
+         if (step == 0) { data = a.SpMat().GetData(); }
+         REQUIRE(a.SpMat().GetData() == data);
+
+         const double tol = 1e-12*a_ref.SpMat().MaxNorm();
+         REQUIRE(MaxDiff(a_ref.SpMat(), a.SpMat()) <= tol);
+
+         // Elimination of the essential dofs, redone after each reassembly
+         SparseMatrix A, A_ref;
+         a.FormSystemMatrix(ess_tdofs, A);
+         a_ref.FormSystemMatrix(ess_tdofs, A_ref);
+         REQUIRE(MaxDiff(A_ref, A) <= tol);
+      }
+   }
+}
@@ -14,6 +14,8 @@
 
 #ifndef _WIN32
 #include <unistd.h>
+#include <atomic>
+#include <thread>
 
 using namespace mfem;
 
@@ -111,4 +113,109 @@ TEST_CASE("MemoryManager", "[MemoryManager]")
    }
 }
 
+TEST_CASE("MemoryPool", "[MemoryManager]")
+{
+   // The Device of a previous test case may have destroyed the MemoryManager
+   mm.Init();
+   const MemoryType mt = MemoryType::HOST_POOL;
+   const MemoryPoolStats s0 = mm.GetPoolStats(mt);
+
+   SECTION("Reuse")
+   {
+      // 8000 and 8080 bytes are in the same size class of 8192 bytes
+      Memory<double> a(1000, mt);
+      Memory<double> b(1010, mt);
+      MemoryPoolStats s1 = mm.GetPoolStats(mt);
+      REQUIRE(s1.in_use - s0.in_use == 2*8192);
+      a.Delete();
+      b.Delete();
+      REQUIRE(mm.GetPoolStats(mt).in_use == s0.in_use);
+
+      Vector v(1005, mt);
+      v = 1.0;
+      REQUIRE(v*v == Approx(1005.0));
+      MemoryPoolStats s2 = mm.GetPoolStats(mt);
+      REQUIRE(s2.hits == s1.hits + 1);
+      REQUIRE(s2.misses == s1.misses);
+      REQUIRE(s2.peak >= s2.reserved);
+      REQUIRE(s2.reserved >= s2.in_use);
+   }
+
+   SECTION("Sizes")
+   {
+      for (int n : {0, 1, 7, 9, 100, 4097, 12345, 1 << 20})
+      {
+         Memory<double> m(n, mt);
+         double *h = m.Write(MemoryClass::HOST, n);
+         for (int i = 0; i < n; i++) { h[i] = i; }
+         REQUIRE(((uintptr_t) h) % 64 == 0);
+         m.Delete();
+      }
+      REQUIRE(mm.GetPoolStats(mt).in_use == s0.in_use);
+   }
+
+   SECTION("Largest class")
+   {
+      // Blocks of up to 1 GB are kept in the pool, larger ones are returned
+      // to the system when freed
+      const int gb = 1 << 30;
+      Memory<char> m(gb, mt);
+      m.Delete();
+      const MemoryPoolStats s1 = mm.GetPoolStats(mt);
+      REQUIRE(s1.reserved == s0.reserved + gb);
+      Memory<char> l(gb + 1, mt);
+      REQUIRE(mm.GetPoolStats(mt).in_use == s0.in_use + gb + 1);
+      l.Delete();
+      REQUIRE(mm.GetPoolStats(mt).reserved == s1.reserved);
+      mm.ReleasePool(mt);
+   }
+
+   SECTION("Unregistered")
+   {
+      // Host allocations from the pool are not added to the memory maps
+      Memory<double> m(100, mt);
+      REQUIRE(!mm.IsKnown(m.Write(MemoryClass::HOST, 100)));
+      m.Delete();
+      REQUIRE(mm.GetPoolStats(mt).in_use == s0.in_use);
+   }
+
+   SECTION("Threads")
+   {
+      // Each thread allocates and frees through its own cache; the blocks of
+      // the caches go back to the shared free lists when the threads exit
+      std::vector<std::thread> threads;
+      std::atomic<int> errors(0);
+      for (int i = 0; i < 4; i++)
+      {
+         threads.emplace_back([&errors, mt, i]()
+         {
+            for (int it = 0; it < 1000; it++)
+            {
+               const int n = 1 + (it*37 + i*101) % 5000;
+               Memory<double> m(n, mt);
+               double *h = m.Write(MemoryClass::HOST, n);
+               for (int j = 0; j < n; j++) { h[j] = i; }
+               Memory<double> w(n/2 + 1, mt);
+               w.Write(MemoryClass::HOST, n/2 + 1)[0] = 0.0;
+               for (int j = 0; j < n; j++) { if (h[j] != i) { errors++; } }
+               w.Delete();
+               m.Delete();
+            }
+         });
+      }
+      for (std::thread &t : threads) { t.join(); }
+      REQUIRE(errors == 0);
+      REQUIRE(mm.GetPoolStats(mt).in_use == s0.in_use);
+   }
+
+   SECTION("Release")
+   {
+      Memory<int> m(100, mt);
+      m.Delete();
+      mm.ReleasePool(mt);
+      MemoryPoolStats s1 = mm.GetPoolStats(mt);
+      REQUIRE(s1.reserved == s1.in_use);
+   }
+}
+
 #endif // _WIN32
@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mfem;
+
+// Return the lines of the report, without the header.
+static std::vector<std::string> PerfReport()
+{
+   std::ostringstream os;
+   PerfRegions::Print(os);
+   std::istringstream is(os.str());
+   std::vector<std::string> lines;
+   std::string line;
+   std::getline(is, line);
+   while (std::getline(is, line)) { lines.push_back(line); }
+   return lines;
+}
+
+// Return the number of calls of the region on the given line.
+static long long PerfCalls(const std::string &line, const std::string &name)
+{
+   std::istringstream is(line.substr(name.length()));
+   long long calls = -1;
+   is >> calls;
+   return calls;
+}
+
+TEST_CASE("PerfRegions", "[PerfRegions]")
+{
+   PerfRegions::Reset();
+   PerfRegions::Enable();
+
+   SECTION("Nesting")
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         MFEM_PERF_SCOPE("outer");
+         MFEM_PERF_FLOPS(10.0);
+         {
+            MFEM_PERF_SCOPE("inner");
+         }
+         if (i == 0)
+         {
+            PerfRegions::Begin("other");
+            PerfRegions::End();
+         }
+      }
+      {
+         MFEM_PERF_SCOPE("inner");
+      }
+
+      std::vector<std::string> lines = PerfReport();
+      REQUIRE(lines.size() == 4);
+      REQUIRE(lines[0].compare(0, 6, "outer ") == 0);
+      REQUIRE(PerfCalls(lines[0], "outer") == 3);
+      REQUIRE(lines[1].compare(0, 8, "  inner ") == 0);
+      REQUIRE(PerfCalls(lines[1], "  inner") == 3);
+      REQUIRE(lines[2].compare(0, 8, "  other ") == 0);
+      REQUIRE(PerfCalls(lines[2], "  other") == 1);
+      REQUIRE(lines[3].compare(0, 6, "inner ") == 0);
+      REQUIRE(PerfCalls(lines[3], "inner") == 1);
+   }
+
+   SECTION("Disabled")
+   {
+      PerfRegions::Disable();
+      {
+         MFEM_PERF_SCOPE("outer");
+      }
+      REQUIRE(PerfReport().size() == 0);
+   }
+
+   SECTION("IfElse")
+   {
+      // The macros are single statements, usable in an if-else without braces
+      int others = 0;
+      for (int i = 0; i < 4; i++)
+      {
+         MFEM_PERF_SCOPE("outer");
+         if (i == 0)
+            MFEM_PERF_FLOPS(10.0);
+         else
+            others++;
+         if (i == 1)
+            MFEM_PERF_BYTES(8.0);
+         else
+            others++;
+      }
+      REQUIRE(others == 6);
+   }
+
+   SECTION("Solver")
+   {
+      Mesh mesh(4, 4, Element::QUADRILATERAL);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.Assemble();
+
+      Vector b(fes.GetVSize()), x(fes.GetVSize());
+      b = 1.0;
+      x = 0.0;
+      CGSolver cg;
+      cg.SetOperator(a);
+      cg.SetRelTol(1e-8);
+      cg.SetMaxIter(100);
+      cg.Mult(b, x);
+
+      std::string report;
+      for (const std::string &line : PerfReport()) { report += line + '\n'; }
+      REQUIRE(report.find("BilinearForm::Assemble") != std::string::npos);
+      REQUIRE(report.find("\nCGSolver::Mult") != std::string::npos);
+      REQUIRE(report.find("\n  PABilinearFormExtension::Mult") !=
+              std::string::npos);
+      REQUIRE(report.find("\n    MassIntegrator::AddMultPA") !=
+              std::string::npos);
+   }
+
+   PerfRegions::Disable();
+   PerfRegions::Reset();
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mfem;
+
+// Executor that runs the chunks sequentially, in reverse order.
+class ReverseExecutor : public ThreadExecutor
+{
+public:
+   int calls = 0;
+
+   int NumThreads() const { return 3; }
+
+   void ParallelFor(int N, int grain, const RangeBody &body)
+   {
+      calls++;
+      for (int c = (N + grain - 1) / grain - 1; c >= 0; c--)
+      {
+         body(c * grain, std::min((c + 1) * grain, N));
+      }
+   }
+};
+
+TEST_CASE("WorkStealingThreadPool", "[Threads]")
+{
+   WorkStealingThreadPool pool(4);
+   REQUIRE(pool.NumThreads() == 4);
+
+   SECTION("ParallelFor")
+   {
+      for (int grain : {1, 7, 1000, 20000})
+      {
+         const int N = 10007;
+         std::vector<std::atomic<int>> count(N);
+         for (int i = 0; i < N; i++) { count[i] = 0; }
+         std::atomic<int> max_size(0);
+         pool.ParallelFor(N, grain, [&](int begin, int end)
+         {
+            // Catch assertions are not thread-safe
+            int size = max_size.load();
+            while (end - begin > size &&
+                   !max_size.compare_exchange_weak(size, end - begin)) { }
+            for (int i = begin; i < end; i++) { count[i]++; }
+         });
+         REQUIRE(max_size <= grain);
+         int errors = 0;
+         for (int i = 0; i < N; i++) { errors += (count[i] != 1); }
+         REQUIRE(errors == 0);
+      }
+   }
+
+   SECTION("Nested")
+   {
+      const int N = 64, M = 100;
+      std::atomic<int> sum(0);
+      pool.ParallelFor(N, 1, [&](int begin, int end)
+      {
+         for (int i = begin; i < end; i++)
+         {
+            pool.ParallelFor(M, 10, [&](int b, int e) { sum += e - b; });
+         }
+      });
+      REQUIRE(sum == N*M);
+   }
+
+   SECTION("Reduce")
+   {
+      SetThreadExecutor(&pool);
+      const int N = 100003;
+      const double sum =
+         ThreadsReduce(N, 0.0, [](int i) { return (double) i; },
+                       [](double a, double b) { return a + b; });
+      REQUIRE(sum == Approx(0.5 * N * (N - 1)));
+      SetThreadExecutor(NULL);
+   }
+}
+
+TEST_CASE("ThreadExecutor", "[Threads]")
+{
+   ReverseExecutor exec;
+   SetThreadExecutor(&exec);
+   REQUIRE(&GetThreadExecutor() == &exec);
+
+   const int N = 5000;
+   const double min =
+      ThreadsReduce(N, infinity(),
+                    [](int i) { return (i - 1234.0)*(i - 1234.0); },
+                    [](double a, double b) { return std::min(a, b); });
+   REQUIRE(min == 0.0);
+   REQUIRE(exec.calls == 1);
+
+   SetThreadExecutor(NULL);
+   REQUIRE(&GetThreadExecutor() != &exec);
+}
+
+TEST_CASE("Default thread pool creation", "[Threads]")
+{
+   // Several host threads request the default pool for the first time at once
+   // and must all get the same one.
+   for (int rep = 0; rep < 10; rep++)
+   {
+      SetNumThreads(2); // destroys the current default pool
+      const int nt = 4;
+      std::atomic<int> ready(0);
+      std::vector<ThreadExecutor*> execs(nt, NULL);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < nt; t++)
+      {
+         threads.emplace_back([&, t]()
+         {
+            ready++;
+            while (ready < nt) { }
+            execs[t] = &GetThreadExecutor();
+         });
+      }
+      for (std::thread &t : threads) { t.join(); }
+      for (int t = 1; t < nt; t++) { REQUIRE(execs[t] == execs[0]); }
+      REQUIRE(execs[0]->NumThreads() == 2);
+   }
+   SetNumThreads(0);
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace amg
+{
+
+static int SolveWithAMG(const SparseMatrix &A, int print_level = -1)
+{
+   SmoothedAggregationAMG amg(A);
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetAbsTol(0.0);
+   cg.SetMaxIter(200);
+   cg.SetPrintLevel(print_level);
+   cg.SetPreconditioner(amg);
+   cg.SetOperator(A);
+
+   Vector b(A.Height()), x(A.Height());
+   b.Randomize(1);
+   x = 0.0;
+   cg.Mult(b, x);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(amg.GetNumLevels() > 1);
+   REQUIRE(amg.GetOperatorComplexity() < 2.0);
+   return cg.GetNumIterations();
+}
+
+TEST_CASE("Threaded sparse matrix product", "[AMG]")
+{
+   Mesh mesh(10, 10, Element::TRIANGLE, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   SparseMatrix *AA_ref = Mult(A, A);
+   Vector x(A.Width()), y(A.Height()), y_ref(A.Height());
+   x.Randomize(2);
+   AA_ref->Mult(x, y_ref);
+   for (int threads = 0; threads <= 1; threads++)
+   {
+      Device device(threads ? "threads" : "cpu");
+      SparseMatrix *AA = ThreadedMult(A, A);
+      REQUIRE(AA->NumNonZeroElems() == AA_ref->NumNonZeroElems());
+      AA->Mult(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() <= 1e-12*y_ref.Normlinf());
+      delete AA;
+   }
+   delete AA_ref;
+}
+
+TEST_CASE("Smoothed aggregation AMG", "[AMG]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(64, 64, Element::QUADRILATERAL, true) :
+                   new Mesh(16, 16, 16, Element::HEXAHEDRON, true);
+      H1_FECollection fec(1, dim);
+      FiniteElementSpace fes(mesh, &fec);
+
+      Array<int> ess_tdofs;
+      Array<int> ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      SparseMatrix A;
+      a.FormSystemMatrix(ess_tdofs, A);
+
+      const int iter = SolveWithAMG(A);
+      REQUIRE(iter < 20);
+
+      // The threaded setup builds the same hierarchy
+      {
+         Device device("threads");
+         REQUIRE(std::abs(SolveWithAMG(A) - iter) <= 1);
+      }
+
+      delete mesh;
+   }
+}
+
+TEST_CASE("AMG coarsest level solver", "[AMG]")
+{
+   Mesh mesh(16, 16, Element::QUADRILATERAL, true);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+   REQUIRE(A.Height() > 200);
+
+   Vector b(A.Height()), x(A.Height()), r(A.Height());
+   b.Randomize(3);
+   SmoothedAggregationAMG amg;
+   amg.SetMaxLevels(1);
+   for (int k = 0; k < 3; k++)
+   {
+      // Dense LU above the coarse size, smoothing only, dense LU again
+      amg.SetMaxDenseSize(k == 0 ? 2000 : 0);
+      amg.SetCoarseSize(k == 2 ? A.Height() : 200);
+      amg.SetOperator(A);
+      REQUIRE(amg.GetNumLevels() == 1);
+      amg.Mult(b, x);
+      A.Mult(x, r);
+      r -= b;
+      const bool exact = (r.Normlinf() <= 1e-10*b.Normlinf());
+      REQUIRE(exact == (k != 1));
+   }
+}
+
+// Two-level p-multigrid with the AMG as coarse level solver
+class AMGCoarseMultigrid : public Multigrid
+{
+private:
+   ConstantCoefficient one;
+
+   void AddForm(FiniteElementSpace &fespace, Array<int> &ess_bdr,
+                bool partial)
+   {
+      BilinearForm *form = new BilinearForm(&fespace);
+      if (partial) { form->SetAssemblyLevel(AssemblyLevel::PARTIAL); }
+      form->AddDomainIntegrator(new DiffusionIntegrator(one));
+      form->Assemble();
+      bfs.Append(form);
+      essentialTrueDofs.Append(new Array<int>());
+      fespace.GetEssentialTrueDofs(ess_bdr, *essentialTrueDofs.Last());
+   }
+
+public:
+   AMGCoarseMultigrid(FiniteElementSpaceHierarchy &fespaces,
+                      Array<int> &ess_bdr)
+      : Multigrid(fespaces), one(1.0)
+   {
+      AddForm(fespaces.GetFESpaceAtLevel(0), ess_bdr, false);
+      SparseMatrix *A0 = new SparseMatrix;
+      bfs.Last()->FormSystemMatrix(*essentialTrueDofs.Last(), *A0);
+      AddLevel(A0, new SmoothedAggregationAMG(*A0), true, true);
+
+      AddForm(fespaces.GetFESpaceAtLevel(1), ess_bdr, true);
+      OperatorPtr op;
+      op.SetType(Operator::ANY_TYPE);
+      bfs.Last()->FormSystemMatrix(*essentialTrueDofs.Last(), op);
+      op.SetOperatorOwner(false);
+      Vector diag(fespaces.GetFESpaceAtLevel(1).GetTrueVSize());
+      bfs.Last()->AssembleDiagonal(diag);
+      smoother_diag.Append(new Vector(diag));
+      AddLevel(op.Ptr(), new OperatorChebyshevSmoother(
+                  op.Ptr(), *smoother_diag.Last(), *essentialTrueDofs.Last(),
+                  2), true, true);
+   }
+
+   Array<Vector*> smoother_diag;
+
+   ~AMGCoarseMultigrid()
+   {
+      for (int i = 0; i < smoother_diag.Size(); i++) { delete smoother_diag[i]; }
+   }
+};
+
+TEST_CASE("AMG as coarse solver of Multigrid", "[AMG]")
+{
+   Mesh mesh(32, 32, Element::QUADRILATERAL, true);
+   H1_FECollection fec1(1, 2), fec2(2, 2);
+   FiniteElementSpace *coarse_fespace = new FiniteElementSpace(&mesh, &fec1);
+   FiniteElementSpaceHierarchy fespaces(&mesh, coarse_fespace, false, true);
+   fespaces.AddOrderRefinedLevel(&fec2);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   AMGCoarseMultigrid M(fespaces, ess_bdr);
+   M.SetCycleType(Multigrid::CycleType::VCYCLE, 1, 1);
+
+   LinearForm b(&fespaces.GetFinestFESpace());
+   ConstantCoefficient one(1.0);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fespaces.GetFinestFESpace());
+   x = 0.0;
+
+   OperatorPtr A;
+   Vector B, X;
+   M.FormFineLinearSystem(x, b, A, X, B);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetAbsTol(0.0);
+   cg.SetMaxIter(100);
+   cg.SetOperator(*A);
+   cg.SetPreconditioner(M);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(cg.GetNumIterations() < 30);
+}
+
+} // namespace amg
@@ -0,0 +1,180 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace bsrmat
+{
+
+static double MaxDiff(const Vector &x, const Vector &y)
+{
+   Vector d(x);
+   d -= y;
+   return d.Normlinf();
+}
+
+static Mesh *MakeMesh(int dim)
+{
+   return (dim == 2) ?
+          new Mesh(8, 8, Element::QUADRILATERAL, true) :
+          new Mesh(4, 4, 4, Element::HEXAHEDRON, true);
+}
+
+TEST_CASE("Block CSR matrix", "[BSRMatrix]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec, dim, Ordering::byVDIM);
+      ConstantCoefficient lambda(1.0), mu(1.0), one(1.0);
+
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+      a.AddBoundaryIntegrator(new VectorMassIntegrator(one));
+      a.Assemble(0);
+      a.Finalize(0);
+      const SparseMatrix &A = a.SpMat();
+      BSRMatrix *B = a.AssembleBSR();
+      REQUIRE(B->GetBlockSize() == dim);
+      REQUIRE(B->NumBlockRows() == fes.GetNDofs());
+
+      const int n = A.Height();
+      Vector x(n), y(n), y_ref(n);
+      x.Randomize(1);
+      A.Mult(x, y_ref);
+      const double tol = 1e-12*y_ref.Normlinf();
+
+      B->Mult(x, y);
+      REQUIRE(MaxDiff(y, y_ref) <= tol);
+      y = y_ref;
+      B->AddMult(x, y, -1.0);
+      REQUIRE(y.Normlinf() <= tol);
+      B->MultTranspose(x, y);
+      REQUIRE(MaxDiff(y, y_ref) <= tol);
+      {
+         Device device("threads");
+         B->Mult(x, y);
+      }
+      REQUIRE(MaxDiff(y, y_ref) <= tol);
+
+      SparseMatrix *S = B->ToSparseMatrix();
+      S->Add(-1.0, A);
+      REQUIRE(S->MaxNorm() <= tol);
+      delete S;
+
+      Vector d, d_ref;
+      B->GetDiag(d);
+      A.GetDiag(d_ref);
+      REQUIRE(MaxDiff(d, d_ref) <= tol);
+
+      // Conversion from the SparseMatrix
+      BSRMatrix C(A, dim);
+      REQUIRE(C.NumNonZeroBlocks() == B->NumNonZeroBlocks());
+      C.Mult(x, y);
+      REQUIRE(MaxDiff(y, y_ref) <= tol);
+
+      // Elimination of the boundary dofs
+      Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_vdofs;
+      ess_bdr = 0;
+      ess_bdr[0] = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_vdofs);
+      REQUIRE(ess_vdofs.Size() > 0);
+      Vector sol(n), rhs(n), rhs_ref(n);
+      sol.Randomize(2);
+      rhs.Randomize(3);
+      rhs_ref = rhs;
+      SparseMatrix A_e(A);
+      for (int k = 0; k < ess_vdofs.Size(); k++)
+      {
+         const int vdof = ess_vdofs[k];
+         A_e.EliminateRowCol(vdof, sol(vdof), rhs_ref);
+      }
+      B->EliminateRowsCols(ess_vdofs, sol, rhs);
+      REQUIRE(MaxDiff(rhs, rhs_ref) <= 1e-12*rhs_ref.Normlinf());
+      A_e.Mult(x, y_ref);
+      B->Mult(x, y);
+      REQUIRE(MaxDiff(y, y_ref) <= tol);
+
+      // Threaded block Gauss-Seidel sweeps match the sequential ones
+      Vector b(n), x_seq(n), x_thr(n);
+      b.Randomize(4);
+      x_seq = 0.0;
+      B->BlockGaussSeidelForw(b, x_seq);
+      B->BlockGaussSeidelBack(b, x_seq);
+      x_thr = 0.0;
+      {
+         Device device("threads");
+         B->BlockGaussSeidelForw(b, x_thr);
+         B->BlockGaussSeidelBack(b, x_thr);
+      }
+      REQUIRE(MaxDiff(x_thr, x_seq) == 0.0);
+
+      delete B;
+      delete mesh;
+   }
+}
+
+TEST_CASE("Block CSR smoothers in CG", "[BSRMatrix][CGSolver]")
+{
+   const int dim = 3;
+   Mesh *mesh = MakeMesh(dim);
+   H1_FECollection fec(1, dim);
+   FiniteElementSpace fes(mesh, &fec, dim, Ordering::byVDIM);
+   ConstantCoefficient lambda(1.0), mu(1.0);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   BSRMatrix *A = a.AssembleBSR();
+   Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_vdofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_vdofs);
+   A->EliminateRowsCols(ess_vdofs);
+
+   const int n = A->Height();
+   Vector b(n), x(n);
+   b.Randomize(5);
+   for (int k = 0; k < ess_vdofs.Size(); k++) { b(ess_vdofs[k]) = 0.0; }
+
+   int iters[3];
+   const BSRSmoother::Type types[3] =
+   {
+      BSRSmoother::JACOBI, BSRSmoother::GS_SYMMETRIC, BSRSmoother::GS_SYMMETRIC
+   };
+   for (int k = 0; k < 3; k++)
+   {
+      BSRSmoother smoother(*A, types[k], 1.0, k == 2 ? 2 : 1);
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(500);
+      cg.SetOperator(*A);
+      cg.SetPreconditioner(smoother);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+      iters[k] = cg.GetNumIterations();
+
+      Vector r(b);
+      A->AddMult(x, r, -1.0);
+      REQUIRE(r.Normlinf() <= 1e-8*b.Normlinf());
+   }
+   REQUIRE(iters[1] < iters[0]);
+   REQUIRE(iters[2] <= iters[1]);
+
+   delete A;
+   delete mesh;
+}
+
+} // namespace bsrmat
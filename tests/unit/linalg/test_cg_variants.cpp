@@ -0,0 +1,107 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace cg_variants
+{
+
+class CountingMonitor : public IterativeSolverMonitor
+{
+public:
+   int calls = 0, final_calls = 0;
+
+   virtual void MonitorResidual(int it, double norm, const Vector &r,
+                                bool final)
+   {
+      calls++;
+      if (final) { final_calls++; }
+   }
+};
+
+static void TestCGVariant(IterativeSolver &solver, const SparseMatrix &A,
+                          Solver *prec, const Vector &b, const Vector &x_ref,
+                          int ref_iter)
+{
+   CountingMonitor monitor;
+   solver.SetRelTol(1e-12);
+   solver.SetAbsTol(0.0);
+   solver.SetMaxIter(500);
+   solver.SetPrintLevel(-1);
+   solver.SetMonitor(monitor);
+   if (prec) { solver.SetPreconditioner(*prec); }
+   solver.SetOperator(A);
+
+   Vector x(b.Size());
+   x = 0.0;
+   solver.Mult(b, x);
+   REQUIRE(solver.GetConverged());
+   REQUIRE(std::abs(solver.GetNumIterations() - ref_iter) <= 2);
+   REQUIRE(monitor.final_calls == 1);
+   REQUIRE(monitor.calls == solver.GetNumIterations() + 2);
+
+   x -= x_ref;
+   REQUIRE(x.Normlinf() <= 1e-8*x_ref.Normlinf());
+}
+
+TEST_CASE("Single-reduction and pipelined CG", "[CGSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   LinearForm lf(&fes);
+   ConstantCoefficient one(1.0);
+   lf.AddDomainIntegrator(new DomainLFIntegrator(one));
+   lf.Assemble();
+   GridFunction u(&fes);
+   u = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdofs, u, lf, A, X, B);
+
+   for (int use_prec = 0; use_prec <= 1; use_prec++)
+   {
+      DSmoother jacobi(A);
+      Solver *prec = use_prec ? &jacobi : NULL;
+
+      CGSolver cg;
+      cg.SetRelTol(1e-12);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(500);
+      if (prec) { cg.SetPreconditioner(*prec); }
+      cg.SetOperator(A);
+      Vector x_ref(B.Size());
+      x_ref = 0.0;
+      cg.Mult(B, x_ref);
+      REQUIRE(cg.GetConverged());
+
+      SingleReductionCGSolver src;
+      TestCGVariant(src, A, prec, B, x_ref, cg.GetNumIterations());
+
+      PipelinedCGSolver pcg;
+      TestCGVariant(pcg, A, prec, B, x_ref, cg.GetNumIterations());
+   }
+}
+
+} // namespace cg_variants
@@ -0,0 +1,187 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace floatmat
+{
+
+static double MaxDiff(const Vector &x, const Vector &y)
+{
+   Vector d(x);
+   d -= y;
+   return d.Normlinf();
+}
+
+// Diffusion matrix with eliminated boundary dofs
+static SparseMatrix *AssembleDiffusion(Mesh &mesh, int order)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdofs, A);
+   return new SparseMatrix(A);
+}
+
+TEST_CASE("Single precision sparse matrix", "[FloatSparseMatrix]")
+{
+   Mesh mesh(12, 12, Element::TRIANGLE, true);
+   SparseMatrix *A_ptr = AssembleDiffusion(mesh, 2);
+   const SparseMatrix &A = *A_ptr;
+   FloatSparseMatrix A32(A);
+   REQUIRE(A32.NumNonZeroElems() == A.NumNonZeroElems());
+
+   const int n = A.Height();
+   Vector x(n), y(n), y_ref(n);
+   x.Randomize(1);
+   A.Mult(x, y_ref);
+   const double tol = 1e-6*A.MaxNorm()*x.Normlinf();
+
+   A32.Mult(x, y);
+   REQUIRE(MaxDiff(y, y_ref) <= tol);
+   y = y_ref;
+   A32.AddMult(x, y, -1.0);
+   REQUIRE(y.Normlinf() <= tol);
+   A32.MultTranspose(x, y);
+   REQUIRE(MaxDiff(y, y_ref) <= tol);
+   {
+      Device device("threads");
+      A32.Mult(x, y);
+   }
+   REQUIRE(MaxDiff(y, y_ref) <= tol);
+
+   Vector d, d_ref;
+   A32.GetDiag(d);
+   A.GetDiag(d_ref);
+   REQUIRE(MaxDiff(d, d_ref) <= 1e-6*d_ref.Normlinf());
+
+   // The conversion back gives the rounded entries
+   SparseMatrix *B = A32.ToSparseMatrix();
+   B->Add(-1.0, A);
+   REQUIRE(B->MaxNorm() <= 1e-7*A.MaxNorm());
+   delete B;
+
+   // Threaded Gauss-Seidel sweeps match the sequential ones
+   Vector y_seq(n), y_thr(n);
+   FloatGSSmoother gs(A32);
+   gs.Mult(x, y_seq);
+   {
+      Device device("threads");
+      gs.Mult(x, y_thr);
+   }
+   REQUIRE(MaxDiff(y_thr, y_seq) == 0.0);
+   delete A_ptr;
+}
+
+TEST_CASE("Mixed precision solvers", "[FloatSparseMatrix][AMG]")
+{
+   Mesh mesh(32, 32, Element::QUADRILATERAL, true);
+   SparseMatrix *A_ptr = AssembleDiffusion(mesh, 2);
+   const SparseMatrix &A = *A_ptr;
+   FloatSparseMatrix A32(A);
+   FloatGSSmoother gs32(A32);
+
+   const int n = A.Height();
+   Vector b(n), x(n), r(n);
+   b.Randomize(2);
+   const double rtol = 1e-12;
+
+   // PCG with the single precision Gauss-Seidel preconditioner takes about
+   // as many iterations as with the double precision one
+   int iters[2];
+   GSSmoother gs(A);
+   for (int k = 0; k < 2; k++)
+   {
+      CGSolver cg;
+      cg.SetRelTol(rtol);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(1000);
+      cg.SetOperator(A);
+      cg.SetPreconditioner(k == 0 ? (Solver&)gs : (Solver&)gs32);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+      iters[k] = cg.GetNumIterations();
+   }
+   REQUIRE(std::abs(iters[1] - iters[0]) <= 2);
+
+   // Iterative refinement and flexible GMRES in double precision around an
+   // inner CG solver on the single precision matrix, with a loose tolerance
+   CGSolver inner;
+   inner.SetRelTol(1e-3);
+   inner.SetAbsTol(0.0);
+   inner.SetMaxIter(100);
+   inner.SetPreconditioner(gs32);
+   inner.SetOperator(A32);
+   for (int k = 0; k < 2; k++)
+   {
+      SLISolver sli;
+      FGMRESSolver fgmres;
+      IterativeSolver &outer = (k == 0) ? (IterativeSolver&)sli :
+                               (IterativeSolver&)fgmres;
+      outer.SetRelTol(rtol);
+      outer.SetAbsTol(0.0);
+      outer.SetMaxIter(20);
+      outer.SetOperator(A);
+      outer.SetPreconditioner(inner);
+      x = 0.0;
+      outer.Mult(b, x);
+      REQUIRE(outer.GetConverged());
+      A.Mult(x, r);
+      subtract(b, r, r);
+      REQUIRE(r.Norml2() <= 10*rtol*b.Norml2());
+   }
+
+   // AMG with a single precision hierarchy
+   for (int k = 0; k < 2; k++)
+   {
+      SmoothedAggregationAMG amg;
+      amg.SetSinglePrecision(k == 1);
+      amg.SetOperator(A);
+      CGSolver cg;
+      cg.SetRelTol(rtol);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(200);
+      cg.SetOperator(A);
+      cg.SetPreconditioner(amg);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+      iters[k] = cg.GetNumIterations();
+   }
+   REQUIRE(std::abs(iters[1] - iters[0]) <= 2);
+
+   // Switching to single precision after the setup rebuilds the hierarchy
+   {
+      SmoothedAggregationAMG amg_ref, amg(A);
+      amg_ref.SetSinglePrecision();
+      amg_ref.SetOperator(A);
+      amg.SetSinglePrecision();
+      Vector y(A.Height()), y_ref(A.Height());
+      amg_ref.Mult(b, y_ref);
+      amg.Mult(b, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() <= 1e-12*y_ref.Normlinf());
+   }
+   delete A_ptr;
+}
+
+} // namespace floatmat
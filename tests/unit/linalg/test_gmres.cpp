@@ -0,0 +1,90 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace gmres
+{
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 10.0*x(1);
+   v(1) = -10.0*x(0);
+}
+
+static double Residual(const SparseMatrix &A, const Vector &b, const Vector &x)
+{
+   Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   return r.Norml2() / b.Norml2();
+}
+
+TEST_CASE("GMRES and FGMRES with CGS2", "[GMRESSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+   // Non-symmetric convection-diffusion system
+   VectorFunctionCoefficient vel(2, velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new ConvectionIntegrator(vel));
+   a.Assemble();
+   LinearForm lf(&fes);
+   ConstantCoefficient one(1.0);
+   lf.AddDomainIntegrator(new DomainLFIntegrator(one));
+   lf.Assemble();
+   GridFunction u(&fes);
+   u = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdofs, u, lf, A, X, B);
+
+   for (int use_prec = 0; use_prec <= 1; use_prec++)
+   {
+      DSmoother jacobi(A);
+      for (int kdim = 10; kdim <= 200; kdim += 190)
+      {
+         GMRESSolver gmres;
+         FGMRESSolver fgmres;
+         IterativeSolver *solvers[2] = { &gmres, &fgmres };
+         gmres.SetKDim(kdim);
+         fgmres.SetKDim(kdim);
+         for (int s = 0; s < 2; s++)
+         {
+            IterativeSolver &solver = *solvers[s];
+            solver.SetRelTol(1e-10);
+            solver.SetAbsTol(0.0);
+            solver.SetMaxIter(1000);
+            if (use_prec) { solver.SetPreconditioner(jacobi); }
+            solver.SetOperator(A);
+            X = 0.0;
+            solver.Mult(B, X);
+            REQUIRE(solver.GetConverged());
+            // The preconditioned residual is used by GMRES
+            REQUIRE(Residual(A, B, X) <= (use_prec && s == 0 ? 1e-7 : 1e-9));
+         }
+      }
+   }
+}
+
+} // namespace gmres
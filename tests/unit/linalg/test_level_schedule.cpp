@@ -0,0 +1,146 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace level_schedule
+{
+
+// Diagonally dominant matrix with a random, nonsymmetric sparsity pattern
+static SparseMatrix *RandomMatrix(int n, int row_size)
+{
+   SparseMatrix *A = new SparseMatrix(n, n);
+   srand(1);
+   for (int i = 0; i < n; i++)
+   {
+      A->Add(i, i, 2.0*row_size);
+      for (int k = 0; k < row_size; k++)
+      {
+         const int j = std::max(0, std::min(n-1, i + rand()%2000 - 1000));
+         A->Add(i, j, -rand()/double(RAND_MAX));
+      }
+   }
+   A->Finalize();
+   return A;
+}
+
+TEST_CASE("Level schedule", "[SparseMatrix]")
+{
+   SparseMatrix *A = RandomMatrix(5000, 6);
+   const int n = A->Height();
+   const int *I = A->GetI(), *J = A->GetJ();
+
+   for (int t = 0; t < 3; t++)
+   {
+      const SparseLevelSchedule::Type type = (SparseLevelSchedule::Type)t;
+      SparseLevelSchedule levels;
+      levels.Build(n, I, J, type);
+      REQUIRE(levels.Size() == n);
+      REQUIRE(levels.NumLevels() > 1);
+      REQUIRE(levels.NumLevels() < n/10);
+
+      Array<int> level(n);
+      level = -1;
+      const Array<int> &rows = levels.GetRows();
+      const Array<int> &offsets = levels.GetLevelOffsets();
+      for (int l = 0; l < levels.NumLevels(); l++)
+      {
+         for (int k = offsets[l]; k < offsets[l+1]; k++)
+         {
+            level[rows[k]] = l;
+         }
+      }
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(level[i] >= 0);
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int j = J[k];
+            if (j == i) { continue; }
+            if (type == SparseLevelSchedule::LOWER && j < i)
+            {
+               REQUIRE(level[j] < level[i]);
+            }
+            if (type == SparseLevelSchedule::UPPER && j > i)
+            {
+               REQUIRE(level[j] < level[i]);
+            }
+            if (type == SparseLevelSchedule::GAUSS_SEIDEL)
+            {
+               REQUIRE((j < i) == (level[j] < level[i]));
+            }
+         }
+      }
+   }
+   delete A;
+}
+
+TEST_CASE("Threaded Gauss-Seidel", "[SparseMatrix]")
+{
+   SparseMatrix *A = RandomMatrix(5000, 6);
+   const int n = A->Height();
+   Vector b(n), x0(n), y_ref(n), y(n);
+   b.Randomize(1);
+   x0.Randomize(2);
+
+   for (int type = 0; type < 3; type++)
+   {
+      GSSmoother gs(*A, type, 2);
+      gs.iterative_mode = true;
+      y_ref = x0;
+      gs.Mult(b, y_ref);
+      REQUIRE(A->GetLevelSchedule() == NULL);
+      {
+         Device device("threads");
+         y = x0;
+         gs.Mult(b, y);
+      }
+      REQUIRE(A->GetLevelSchedule() != NULL);
+      // The threaded sweeps perform the same operations
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == 0.0);
+      A->ResetLevelSchedule();
+   }
+   delete A;
+}
+
+TEST_CASE("Threaded BlockILU", "[ILU]")
+{
+   Mesh mesh(16, 16, Element::QUADRILATERAL, true);
+   DG_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm a(&fes);
+   const double sigma = -1.0, kappa = 9.0;
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(sigma, kappa));
+   a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(sigma, kappa));
+   a.Assemble();
+   a.Finalize();
+
+   const int block_size = fes.GetFE(0)->GetDof();
+   const int n = fes.GetVSize();
+   Vector b(n), x_ref(n), x(n);
+   b.Randomize(1);
+   BlockILU ilu(a.SpMat(), block_size);
+   ilu.Mult(b, x_ref);
+   {
+      Device device("threads");
+      ilu.Mult(b, x);
+   }
+   x -= x_ref;
+   REQUIRE(x.Normlinf() == 0.0);
+}
+
+} // namespace level_schedule
@@ -293,3 +293,84 @@ TEST_CASE("DenseTensor LinearSolve methods",
       }
    }
 }
+
+TEST_CASE("DenseTensor batched kernels", "[DenseMatrix]")
+{
+   // Sizes with compile-time kernels and runtime sizes
+   const int sizes[] = { 3, 8, 27, 5, 12 };
+   const int NE = 20;
+   const double tol = 1e-10;
+   for (int threads = 0; threads <= 1; threads++)
+   {
+      Device device(threads ? "threads" : "cpu");
+      for (int s = 0; s < 5; s++)
+      {
+         const int m = sizes[s];
+         // Nonsymmetric matrices A(e) = R(e) + I and symmetric positive
+         // definite matrices S(e) = A(e)^t A(e) + m I
+         DenseTensor A(m, m, NE), S(m, m, NE), B(m, m, NE);
+         Vector A_vec(A.Data(), m*m*NE), B_vec(B.Data(), m*m*NE);
+         A_vec.Randomize(1);
+         B_vec.Randomize(2);
+         Vector X(m*NE);
+         X.Randomize(3);
+         for (int e = 0; e < NE; e++)
+         {
+            for (int i = 0; i < m; i++) { A(e)(i,i) += 1.0; }
+            MultAtB(A(e), A(e), S(e));
+            for (int i = 0; i < m; i++) { S(e)(i,i) += m; }
+         }
+
+         DenseTensor Ainv;
+         BatchInverse(A, Ainv);
+         DenseTensor C;
+         BatchMult(A, B, C);
+         BatchAddMult_a(-1.0, A, B, C);
+         REQUIRE(Vector(C.Data(), m*m*NE).Normlinf() == 0.0);
+         BatchMult(Ainv, A, C);
+         Vector Y;
+         BatchMult(A, X, Y);
+
+         DenseTensor L(S);
+         BatchCholeskyFactor(L);
+         Vector W(X);
+         BatchCholeskySolve(L, W);
+
+         for (int e = 0; e < NE; e++)
+         {
+            // Ainv(e) A(e) = I
+            DenseMatrix &Ce = C(e);
+            for (int i = 0; i < m; i++) { Ce(i,i) -= 1.0; }
+            REQUIRE(Ce.MaxMaxNorm() < tol);
+
+            // y_e = A(e) x_e
+            Vector xe(X.GetData() + e*m, m), ye(Y.GetData() + e*m, m);
+            Vector ye_ref(m);
+            A(e).Mult(xe, ye_ref);
+            ye_ref -= ye;
+            REQUIRE(ye_ref.Normlinf() < tol);
+
+            // L(e) L(e)^t = S(e) with L(e) lower triangular
+            DenseMatrix LLt(m);
+            MultABt(L(e), L(e), LLt);
+            LLt -= S(e);
+            REQUIRE(LLt.MaxMaxNorm() < tol*S(e).MaxMaxNorm());
+            REQUIRE(L(e)(0,m-1) == 0.0);
+
+            // S(e) w_e = x_e
+            Vector we(W.GetData() + e*m, m), r(m);
+            S(e).Mult(we, r);
+            r -= xe;
+            REQUIRE(r.Normlinf() < tol);
+         }
+
+         // In place inversion
+         BatchInverse(Ainv, Ainv);
+         for (int e = 0; e < NE; e++)
+         {
+            Ainv(e) -= A(e);
+            REQUIRE(Ainv(e).MaxMaxNorm() < 1e-8);
+         }
+      }
+   }
+}
@@ -0,0 +1,203 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace multivector
+{
+
+TEST_CASE("MultiVector operations", "[MultiVector]")
+{
+   const int n = 1000, nx = 3, ny = 4;
+   MultiVector X(n, nx), Y(n, ny);
+   X.Randomize(1);
+   Y.Randomize(2);
+
+   DenseMatrix G;
+   X.InnerProducts(Y, G);
+   DenseMatrix C(nx, ny);
+   for (int i = 0; i < nx; i++)
+   {
+      for (int j = 0; j < ny; j++)
+      {
+         Vector xi, yj;
+         X.GetVectorView(i, xi);
+         Y.GetVectorView(j, yj);
+         REQUIRE(std::abs(G(i,j) - xi*yj) <= 1e-12*std::abs(xi*yj));
+         C(i,j) = i - 2.0*j;
+      }
+   }
+
+   MultiVector Z(Y);
+   X.AddMult(C, Z, 0.5);
+   for (int j = 0; j < ny; j++)
+   {
+      Vector yj, zj, xi;
+      Y.GetVectorView(j, yj);
+      Z.GetVectorView(j, zj);
+      zj -= yj;
+      for (int i = 0; i < nx; i++)
+      {
+         X.GetVectorView(i, xi);
+         zj.Add(-0.5*C(i,j), xi);
+      }
+      REQUIRE(zj.Normlinf() <= 1e-12);
+   }
+}
+
+TEST_CASE("SparseMatrix and ConstrainedOperator MultiMult", "[MultiVector]")
+{
+   Mesh mesh(6, 6, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   a.Finalize();
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   ConstrainedOperator C(&a.SpMat(), ess_tdofs);
+
+   const int n = fes.GetTrueVSize(), nvec = 5;
+   MultiVector X(n, nvec), Y(n, nvec), Yc(n, nvec);
+   X.Randomize(3);
+   a.SpMat().MultiMult(X, Y);
+   C.MultiMult(X, Yc);
+
+   for (int j = 0; j < nvec; j++)
+   {
+      Vector xj, yj, ycj, y_ref(n);
+      X.GetVectorView(j, xj);
+      Y.GetVectorView(j, yj);
+      Yc.GetVectorView(j, ycj);
+      a.SpMat().Mult(xj, y_ref);
+      y_ref -= yj;
+      REQUIRE(y_ref.Normlinf() <= 1e-12);
+      C.Mult(xj, y_ref);
+      y_ref -= ycj;
+      REQUIRE(y_ref.Normlinf() <= 1e-12);
+   }
+}
+
+TEST_CASE("Partial assembly MultiMult", "[MultiVector]")
+{
+   Mesh mesh(6, 6, Element::QUADRILATERAL, true);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   PABilinearFormExtension pa_ext(&a);
+   pa_ext.Assemble();
+
+   const int n = fes.GetVSize(), nvec = 3;
+   MultiVector X(n, nvec), Y(n, nvec);
+   X.Randomize(5);
+   for (int nb = 0; nb <= 7; nb += 7)
+   {
+      // The default batches, and batches that do not divide the elements
+      pa_ext.SetElementBatchSize(nb);
+      pa_ext.MultiMult(X, Y);
+      for (int j = 0; j < nvec; j++)
+      {
+         Vector xj, yj, y_ref(n);
+         X.GetVectorView(j, xj);
+         Y.GetVectorView(j, yj);
+         pa_ext.Mult(xj, y_ref);
+         y_ref -= yj;
+         REQUIRE(y_ref.Normlinf() <= 1e-12*yj.Normlinf());
+      }
+   }
+}
+
+// Count the calls of the monitor of an IterativeSolver
+class CountingMonitor : public IterativeSolverMonitor
+{
+public:
+   int calls = 0, final_calls = 0;
+   virtual void MonitorResidual(int it, double norm, const Vector &r,
+                                bool final)
+   {
+      calls++;
+      if (final) { final_calls++; }
+   }
+};
+
+TEST_CASE("Block CG", "[MultiVector][CGSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdofs, A);
+
+   const int n = A.Height();
+   for (int nvec = 1; nvec <= 8; nvec *= 8)
+   {
+      MultiVector B(n, nvec), X(n, nvec);
+      B.Randomize(4);
+      for (int use_prec = 0; use_prec <= 1; use_prec++)
+      {
+         DSmoother jacobi(A);
+
+         BlockCGSolver bcg;
+         bcg.SetRelTol(1e-10);
+         bcg.SetAbsTol(0.0);
+         bcg.SetMaxIter(500);
+         if (use_prec) { bcg.SetPreconditioner(jacobi); }
+         bcg.SetOperator(A);
+         CountingMonitor monitor;
+         bcg.SetMonitor(monitor);
+         X = 0.0;
+         bcg.MultiMult(B, X);
+         REQUIRE(bcg.GetConverged());
+         REQUIRE(monitor.calls == bcg.GetNumIterations() + 2);
+         REQUIRE(monitor.final_calls == 1);
+
+         CGSolver cg;
+         cg.SetRelTol(1e-10);
+         cg.SetAbsTol(0.0);
+         cg.SetMaxIter(500);
+         if (use_prec) { cg.SetPreconditioner(jacobi); }
+         cg.SetOperator(A);
+         for (int j = 0; j < nvec; j++)
+         {
+            Vector bj, xj, x_ref(n);
+            B.GetVectorView(j, bj);
+            X.GetVectorView(j, xj);
+            x_ref = 0.0;
+            cg.Mult(bj, x_ref);
+            REQUIRE(cg.GetConverged());
+            // The block Krylov space contains the Krylov space of each vector
+            REQUIRE(bcg.GetNumIterations() <= cg.GetNumIterations());
+            x_ref -= xj;
+            REQUIRE(x_ref.Normlinf() <= 1e-6*xj.Normlinf());
+         }
+      }
+   }
+}
+
+} // namespace multivector
@@ -181,6 +181,30 @@ TEST_CASE("First order ODE methods",
       REQUIRE(check.order(new RK4Solver) + tol > 4.0 );
    }
 
+   SECTION("LowStorageRK3Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK3Solver" << std::endl;
+      REQUIRE(check.order(new LowStorageRK3Solver) + tol > 3.0 );
+   }
+
+   SECTION("LowStorageRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK4Solver" << std::endl;
+      REQUIRE(check.order(new LowStorageRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("SSPRK43Solver")
+   {
+      std::cout <<"\nTesting SSPRK43Solver" << std::endl;
+      REQUIRE(check.order(new SSPRK43Solver) + tol > 3.0 );
+   }
+
+   SECTION("SSPRK104Solver")
+   {
+      std::cout <<"\nTesting SSPRK104Solver" << std::endl;
+      REQUIRE(check.order(new SSPRK104Solver) + tol > 4.0 );
+   }
+
    SECTION("ImplicitMidpointSolver")
    {
       std::cout <<"\nTesting ImplicitMidpointSolver" << std::endl;
@@ -281,3 +305,319 @@ TEST_CASE("First order ODE methods",
    }
 }
 
+
+TEST_CASE("Explicit RK methods in tableau and low-storage form",
+          "[ODE1]")
+{
+   // du/dt = -A u + sin(t) e with a nonsymmetric A
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A;
+      Vector e;
+   public:
+      ODE() : TimeDependentOperator(3, 0.0), A(3), e(3)
+      {
+         e = 1.0;
+         const double a[9] = { 2.0, -1.0, 0.5, 0.3, 1.0, -0.7, 0.0, 0.4, 3.0 };
+         for (int i = 0; i < 9; i++) { A.Data()[i] = a[i]; }
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         A.Mult(u, dudt);
+         dudt.Neg();
+         dudt.Add(sin(GetTime()), e);
+      }
+   };
+
+   // The classical RK4 method as a Butcher tableau and in 3S* form
+   const double a[6] = { 0.5, 0.0, 0.5, 0.0, 0.0, 1.0 };
+   const double b[4] = { 1./6, 1./3, 1./3, 1./6 };
+   const double c[3] = { 0.5, 0.5, 1.0 };
+   const double delta[4] = { -1./3, 1./3, 2./3, 1./3 };
+   const double gamma1[4] = { 1.0, 0.0, 0.0, 0.0 };
+   const double gamma2[4] = { 0.0, 0.0, 0.0, 1.0 };
+   const double gamma3[4] = { 0.0, 1.0, 1.0, 0.0 };
+   const double beta[4] = { 0.5, 0.5, 1.0, 1./6 };
+   const double c3s[4] = { 0.0, 0.5, 0.5, 1.0 };
+
+   RK4Solver rk4;
+   ExplicitRKSolver tableau(4, a, b, c);
+   LowStorageRK3SSolver ls3s(4, delta, gamma1, gamma2, gamma3, beta, c3s);
+   ODESolver *solvers[3] = { &rk4, &tableau, &ls3s };
+
+   ODE ode;
+   Vector u[3];
+   for (int k = 0; k < 3; k++)
+   {
+      u[k].SetSize(3);
+      u[k] = 1.0;
+      double t = 0.0, dt = 0.05;
+      solvers[k]->Init(ode);
+      for (int ti = 0; ti < 20; ti++)
+      {
+         solvers[k]->Step(u[k], t, dt);
+      }
+      REQUIRE(fabs(t - 1.0) < 1e-12);
+   }
+   for (int k = 1; k < 3; k++)
+   {
+      Vector d(u[k]);
+      d -= u[0];
+      REQUIRE(d.Normlinf() < 1e-13);
+   }
+}
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // Harmonic oscillator, du/dt = A u with A = [0 1; -1 0]
+   class Oscillator : public TimeDependentOperator
+   {
+   public:
+      Oscillator() : TimeDependentOperator(2, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = u(1);
+         dudt(1) = -u(0);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         // k = A (u + dt k)
+         const double d = 1.0 + dt*dt;
+         k(0) = (u(1) - dt*u(0))/d;
+         k(1) = (-u(0) - dt*u(1))/d;
+      }
+   };
+
+   // Prothero-Robinson problem with a stiff initial transient,
+   // du/dt = -lambda (u - sin(t)) + cos(t), u(0) = 1
+   class ProtheroRobinson : public TimeDependentOperator
+   {
+   protected:
+      double lambda;
+   public:
+      ProtheroRobinson(double l) : TimeDependentOperator(1, 0.0), lambda(l) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         const double t = GetTime();
+         dudt(0) = -lambda*(u(0) - sin(t)) + cos(t);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         const double t = GetTime();
+         k(0) = (-lambda*(u(0) - sin(t)) + cos(t))/(1.0 + lambda*dt);
+      }
+   };
+
+   // Error norm counting its evaluations
+   class CountingNorm : public ODEWRMSNorm
+   {
+   public:
+      mutable int count;
+      CountingNorm(double tol) : ODEWRMSNorm(tol, tol), count(0) { }
+
+      virtual double Eval(const Vector &err, const Vector &x0,
+                          const Vector &x1) const
+      {
+         count++;
+         return ODEWRMSNorm::Eval(err, x0, x1);
+      }
+   };
+
+   // Integrate to tf, stopping exactly there
+   struct Integrate
+   {
+      static void Run(AdaptiveODESolver &solver, TimeDependentOperator &f,
+                      Vector &u, double tf)
+      {
+         double t = 0.0, dt = 1e-3;
+         solver.Init(f);
+         while (t < tf)
+         {
+            dt = std::min(dt, tf - t);
+            solver.Step(u, t, dt);
+         }
+         REQUIRE(fabs(t - tf) < 1e-12);
+      }
+   };
+
+   BogackiShampineSolver bs;
+   DormandPrinceSolver dp;
+   HairerWannerSDIRKSolver hw;
+   AdaptiveODESolver *solvers[3] = { &bs, &dp, &hw };
+   // Order of the embedded methods
+   const int order[3] = { 2, 4, 3 };
+
+   SECTION("Error control")
+   {
+      Oscillator osc;
+      for (int m = 0; m < 3; m++)
+      {
+         int steps[2];
+         for (int l = 0; l < 2; l++)
+         {
+            const double tol = l == 0 ? 1e-6 : 1e-9;
+            CountingNorm norm(tol);
+            solvers[m]->SetErrorNorm(norm);
+            Vector u(2);
+            u = 1.0;
+            Integrate::Run(*solvers[m], osc, u, 2*M_PI);
+            steps[l] = solvers[m]->GetNumAcceptedSteps();
+            REQUIRE(norm.count == steps[l] + solvers[m]->GetNumRejectedSteps());
+
+            // The solution is periodic with period 2 pi
+            u -= 1.0;
+            REQUIRE(u.Normlinf() < 20*tol);
+         }
+         // The number of steps grows as tol^(-1/(order+1))
+         const double ratio = pow(1e3, 1.0/(order[m] + 1));
+         REQUIRE(steps[1] < 1.5*ratio*steps[0]);
+         REQUIRE(steps[1] > ratio*steps[0]/1.5);
+      }
+   }
+
+   SECTION("Stiff transient")
+   {
+      ProtheroRobinson pr(1e4);
+      int steps[3];
+      for (int m = 0; m < 3; m++)
+      {
+         solvers[m]->SetTolerances(1e-6, 1e-6);
+         Vector u(1);
+         u = 1.0;
+         Integrate::Run(*solvers[m], pr, u, 10.0);
+         steps[m] = solvers[m]->GetNumAcceptedSteps();
+         REQUIRE(fabs(u(0) - sin(10.0)) < 1e-5);
+      }
+      // The explicit methods are limited by stability after the transient
+      REQUIRE(5*steps[2] < steps[0]);
+      REQUIRE(5*steps[2] < steps[1]);
+   }
+
+   SECTION("Restart")
+   {
+      // Change the solution between the steps of the first same as last
+      // pairs, without calling Init(); the changed solution requires Reset()
+      Oscillator osc;
+      EmbeddedRKSolver *erk[2] = { &bs, &dp };
+      for (int m = 0; m < 2; m++)
+      {
+         erk[m]->SetTolerances(1e-9, 1e-9);
+         erk[m]->Init(osc);
+         Vector u(2);
+         u = 2.0;
+         double t = 0.0, dt = 1e-3;
+         for (int i = 0; i < 5; i++)
+         {
+            erk[m]->Step(u, t, dt);
+         }
+         u = 1.0;
+         erk[m]->Reset();
+         const double tf = t + 2*M_PI;
+         while (t < tf)
+         {
+            dt = std::min(dt, tf - t);
+            erk[m]->Step(u, t, dt);
+         }
+         u -= 1.0;
+         REQUIRE(u.Normlinf() < 2e-8);
+      }
+   }
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // du/dt = f1(u) + f2(u) with the explicit term f1(u) = A u,
+   // A = [0 1; -1 0], and the implicit term f2(u) = -mu u, so that
+   // u(t) = exp(-mu t) R(t) u(0) with the rotation R(t)
+   class SplitODE : public TimeDependentOperator
+   {
+   protected:
+      double mu;
+   public:
+      SplitODE(double m) : TimeDependentOperator(2, 0.0), mu(m) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         const bool f1 = (eval_mode != ADDITIVE_TERM_2);
+         const bool f2 = (eval_mode != ADDITIVE_TERM_1);
+         dudt(0) = (f1 ? u(1) : 0.0) - (f2 ? mu*u(0) : 0.0);
+         dudt(1) = (f1 ? -u(0) : 0.0) - (f2 ? mu*u(1) : 0.0);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         // k = f2(u + dt k)
+         REQUIRE(eval_mode == ADDITIVE_TERM_2);
+         k.Set(-mu/(1.0 + mu*dt), u);
+      }
+
+      void Exact(double t, Vector &u) const
+      {
+         u(0) = exp(-mu*t)*(cos(t) + sin(t));
+         u(1) = exp(-mu*t)*(cos(t) - sin(t));
+      }
+   };
+
+   // Return the error at time tf with n steps
+   struct Integrate
+   {
+      static double Error(ODESolver &solver, SplitODE &f, double tf, int n)
+      {
+         Vector u(2), u_ex(2);
+         u = 1.0;
+         double t = 0.0, dt = tf/n;
+         solver.Init(f);
+         for (int i = 0; i < n; i++)
+         {
+            solver.Step(u, t, dt);
+         }
+         REQUIRE(f.GetEvalMode() == TimeDependentOperator::NORMAL);
+         f.Exact(t, u_ex);
+         u -= u_ex;
+         return u.Normlinf();
+      }
+   };
+
+   IMEXEulerSolver euler;
+   ARS222Solver ars222;
+   ARS443Solver ars443;
+   ARK324L2SASolver ark3;
+   ARK436L2SASolver ark4;
+   BDFEXTSolver bdf1(1), bdf2(2), bdf3(3), bdf3s(3);
+   ARS443Solver startup;
+   bdf3s.SetStartupSolver(startup);
+   ODESolver *solvers[9] = { &euler, &ars222, &ars443, &ark3, &ark4,
+                             &bdf1, &bdf2, &bdf3, &bdf3s
+                           };
+   // The bootstrapping from order 1 limits BDF3/EXT3 to 2nd order
+   const int order[9] = { 1, 2, 3, 3, 4, 1, 2, 2, 3 };
+
+   SECTION("Order of convergence")
+   {
+      SplitODE ode(1.0);
+      for (int m = 0; m < 9; m++)
+      {
+         const double e1 = Integrate::Error(*solvers[m], ode, 2.0, 80);
+         const double e2 = Integrate::Error(*solvers[m], ode, 2.0, 160);
+         REQUIRE(log(e1/e2)/log(2.0) + 0.1 > order[m]);
+      }
+   }
+
+   SECTION("Stiff implicit term")
+   {
+      // The step is limited by the explicit term only
+      SplitODE ode(1e6);
+      for (int m = 0; m < 9; m++)
+      {
+         REQUIRE(Integrate::Error(*solvers[m], ode, 2.0, 20) < 1e-6);
+      }
+   }
+}
@@ -12,10 +12,10 @@
 #include "mfem.hpp"
 #include "catch.hpp"
 
-#ifdef MFEM_USE_EXCEPTIONS
-
 using namespace mfem;
 
+#ifdef MFEM_USE_EXCEPTIONS
+
 TEST_CASE("Operator", "[Operator]")
 {
    // Define diagonal sparse matrix
@@ -52,3 +52,56 @@ TEST_CASE("Operator", "[Operator]")
 }
 
 #endif  // MFEM_USE_EXCEPTIONS
+
+TEST_CASE("Product operators with identity factors", "[Operator]")
+{
+   // Nonsymmetric factors, each paired with an identity of the same size
+   // given either as an IdentityOperator (skipped) or as a matrix (applied)
+   const int n = 5;
+   DenseMatrix M[3], I(n);
+   I = 0.0;
+   for (int i = 0; i < n; i++) { I(i,i) = 1.0; }
+   for (int k = 0; k < 3; k++)
+   {
+      M[k].SetSize(n);
+      for (int i = 0; i < n; i++)
+      {
+         for (int j = 0; j < n; j++) { M[k](i,j) = (i + 2.0*j + k)/(i + 1.0); }
+      }
+   }
+   IdentityOperator Id(n);
+
+   Vector x(n), y(n), z(n);
+   x.Randomize(1);
+   for (int c = 0; c < 8; c++)
+   {
+      const Operator *f[3], *f_ref[3];
+      for (int k = 0; k < 3; k++)
+      {
+         const bool id = (c >> k) & 1;
+         f[k] = id ? (const Operator*)&Id : &M[k];
+         f_ref[k] = id ? &I : &M[k];
+      }
+
+      TripleProductOperator T(f[0], f[1], f[2], false, false, false);
+      TripleProductOperator T_ref(f_ref[0], f_ref[1], f_ref[2],
+                                  false, false, false);
+      ProductOperator P(f[0], f[1], false, false);
+      ProductOperator P_ref(f_ref[0], f_ref[1], false, false);
+      RAPOperator R(*f[0], *f[1], *f[2]);
+      RAPOperator R_ref(*f_ref[0], *f_ref[1], *f_ref[2]);
+      const Operator *ops[3] = { &T, &P, &R };
+      const Operator *ops_ref[3] = { &T_ref, &P_ref, &R_ref };
+      for (int k = 0; k < 3; k++)
+      {
+         ops_ref[k]->Mult(x, y);
+         ops[k]->Mult(x, z);
+         z -= y;
+         REQUIRE(z.Normlinf() <= 1e-12*y.Normlinf());
+         ops_ref[k]->MultTranspose(x, y);
+         ops[k]->MultTranspose(x, z);
+         z -= y;
+         REQUIRE(z.Normlinf() <= 1e-12*y.Normlinf());
+      }
+   }
+}
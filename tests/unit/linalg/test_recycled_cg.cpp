@@ -0,0 +1,84 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace recycled_cg
+{
+
+TEST_CASE("Recycled CG", "[CGSolver]")
+{
+   Mesh mesh(16, 16, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdofs, A);
+
+   const int n = A.Height();
+   for (int use_prec = 0; use_prec <= 1; use_prec++)
+   {
+      DSmoother jacobi(A);
+      RecycledCGSolver rcg;
+      CGSolver cg;
+      IterativeSolver *solvers[2] = { &rcg, &cg };
+      for (int s = 0; s < 2; s++)
+      {
+         solvers[s]->SetRelTol(1e-10);
+         solvers[s]->SetAbsTol(0.0);
+         solvers[s]->SetMaxIter(1000);
+         if (use_prec) { solvers[s]->SetPreconditioner(jacobi); }
+         solvers[s]->SetOperator(A);
+      }
+
+      Vector b(n), x(n), x_ref(n);
+      for (int step = 0; step < 6; step++)
+      {
+         // After a slight change of the operator the subspace is reused
+         if (step == 4)
+         {
+            A *= 1.05;
+            rcg.SetOperator(A);
+            cg.SetOperator(A);
+            REQUIRE(rcg.GetRecycleSpaceDim() == 10);
+         }
+         b.Randomize(step + 1);
+         x = 0.0;
+         x_ref = 0.0;
+         rcg.Mult(b, x);
+         cg.Mult(b, x_ref);
+         REQUIRE(rcg.GetConverged());
+         REQUIRE(cg.GetConverged());
+         if (step == 0)
+         {
+            REQUIRE(rcg.GetNumIterations() == cg.GetNumIterations());
+         }
+         else if (step >= 3)
+         {
+            REQUIRE(rcg.GetNumIterations() < 0.95*cg.GetNumIterations());
+         }
+         x_ref -= x;
+         REQUIRE(x_ref.Normlinf() <= 1e-7*x.Normlinf());
+      }
+   }
+}
+
+} // namespace recycled_cg
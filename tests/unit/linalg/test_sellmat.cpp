@@ -0,0 +1,149 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sellmat
+{
+
+static double MaxDiff(const Vector &x, const Vector &y)
+{
+   Vector d(x);
+   d -= y;
+   return d.Normlinf();
+}
+
+TEST_CASE("Sliced ELLPACK matrix", "[SlicedEllpackMatrix]")
+{
+   // Mixed mesh with rows of different lengths
+   Mesh mesh("../../data/star-mixed.mesh");
+   mesh.UniformRefinement();
+   H1_FECollection h1_fec(2, 2);
+   L2_FECollection l2_fec(1, 2);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec), l2_fes(&mesh, &l2_fec);
+
+   BilinearForm a(&h1_fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   MixedBilinearForm b(&h1_fes, &l2_fes);
+   b.AddDomainIntegrator(new MixedScalarMassIntegrator);
+   b.Assemble();
+   b.Finalize();
+   SparseMatrix *mats[2] = { &a.SpMat(), &b.SpMat() };
+
+   const int configs[][2] = { {1, 1}, {4, 1}, {8, 64}, {32, 256} };
+   for (int m = 0; m < 2; m++)
+   {
+      const SparseMatrix &A = *mats[m];
+      Vector x(A.Width()), xt(A.Height()), y(A.Height()), yt(A.Width());
+      Vector y_ref(A.Height()), yt_ref(A.Width());
+      x.Randomize(1);
+      xt.Randomize(2);
+      A.Mult(x, y_ref);
+      A.MultTranspose(xt, yt_ref);
+      const double tol = 1e-12*y_ref.Normlinf();
+      const double tol_t = 1e-12*yt_ref.Normlinf();
+
+      for (int k = 0; k < 4; k++)
+      {
+         SlicedEllpackMatrix S(A, configs[k][0], configs[k][1]);
+         REQUIRE(S.NumNonZeroElems() == A.NumNonZeroElems());
+         REQUIRE(S.NumStoredEntries() >= A.NumNonZeroElems());
+
+         S.Mult(x, y);
+         REQUIRE(MaxDiff(y, y_ref) <= tol);
+         y = y_ref;
+         S.AddMult(x, y, -1.0);
+         REQUIRE(y.Normlinf() <= tol);
+         S.MultTranspose(xt, yt);
+         REQUIRE(MaxDiff(yt, yt_ref) <= tol_t);
+         S.BuildTranspose();
+         S.MultTranspose(xt, yt);
+         REQUIRE(MaxDiff(yt, yt_ref) <= tol_t);
+
+         SparseMatrix *B = S.ToSparseMatrix();
+         B->Add(-1.0, A);
+         REQUIRE(B->MaxNorm() == 0.0);
+         delete B;
+
+         if (m == 0)
+         {
+            Vector d, d_ref;
+            S.GetDiag(d);
+            A.GetDiag(d_ref);
+            REQUIRE(MaxDiff(d, d_ref) == 0.0);
+         }
+
+         {
+            Device device("threads");
+            S.Mult(x, y);
+            S.MultTranspose(xt, yt);
+         }
+         REQUIRE(MaxDiff(y, y_ref) <= tol);
+         REQUIRE(MaxDiff(yt, yt_ref) <= tol_t);
+      }
+
+      // Sorting the rows within the windows reduces the padding
+      SlicedEllpackMatrix S1(A, 8, 1), S64(A, 8, 64);
+      REQUIRE(S64.NumStoredEntries() <= S1.NumStoredEntries());
+   }
+}
+
+TEST_CASE("Sliced ELLPACK matrix in CG", "[SlicedEllpackMatrix][CGSolver]")
+{
+   Mesh mesh(16, 16, Element::TRIANGLE, true);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdofs, A);
+   SlicedEllpackMatrix S(A);
+
+   Vector diag;
+   Array<int> no_ess_tdofs;
+   S.GetDiag(diag);
+   OperatorJacobiSmoother jacobi(diag, no_ess_tdofs, 1.0);
+
+   const int n = A.Height();
+   Vector b(n), x(n), x_ref(n);
+   b.Randomize(3);
+   int iters[2];
+   for (int k = 0; k < 2; k++)
+   {
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(500);
+      cg.SetOperator(k == 0 ? (Operator&)A : (Operator&)S);
+      cg.SetPreconditioner(jacobi);
+      Vector &xk = (k == 0) ? x_ref : x;
+      xk = 0.0;
+      cg.Mult(b, xk);
+      REQUIRE(cg.GetConverged());
+      iters[k] = cg.GetNumIterations();
+   }
+   REQUIRE(iters[0] == iters[1]);
+   REQUIRE(MaxDiff(x, x_ref) <= 1e-8*x_ref.Normlinf());
+}
+
+} // namespace sellmat
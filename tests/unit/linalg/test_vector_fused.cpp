@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace vector_fused
+{
+
+static double MaxDiff(const Vector &x, const Vector &y)
+{
+   Vector d(x);
+   d -= y;
+   return d.Normlinf();
+}
+
+static void TestFusedKernels()
+{
+   const int n = 1003, nv = 19;
+   Vector x(n), w(n), y(n), z(n), z_ref(n);
+   x.Randomize(1);
+   w.Randomize(2);
+   y.Randomize(3);
+   const double tol = 1e-12*n;
+
+   // AxpyDot, also with w = *this
+   z = y;
+   const double zw = z.AxpyDot(0.5, x, w);
+   add(y, 0.5, x, z_ref);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-15);
+   REQUIRE(std::abs(zw - z_ref*w) <= tol);
+   z = y;
+   const double zz = z.AxpyDot(-2.0, x, z);
+   add(y, -2.0, x, z_ref);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-15);
+   REQUIRE(std::abs(zz - z_ref*z_ref) <= tol);
+
+   // AxpbyNorm2, also with y = *this
+   const double nz = z.AxpbyNorm2(0.5, x, -1.5, y);
+   add(0.5, x, -1.5, y, z_ref);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-15);
+   REQUIRE(std::abs(nz - z_ref*z_ref) <= tol);
+   const double nz2 = z.AxpbyNorm2(2.0, x, 3.0, z);
+   z_ref *= 3.0;
+   z_ref.Add(2.0, x);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-14);
+   REQUIRE(std::abs(nz2 - z_ref*z_ref) <= tol*nz2);
+
+   // MultiDot and add with more terms than one group
+   std::vector<Vector> v(nv);
+   std::vector<const Vector*> vp(nv);
+   std::vector<double> a(nv), d(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      v[i].SetSize(n);
+      v[i].Randomize(10 + i);
+      vp[i] = &v[i];
+      a[i] = (i % 5 == 3) ? 0.0 : 1.0/(i + 1);
+   }
+   w.MultiDot(nv, vp.data(), d.data());
+   for (int i = 0; i < nv; i++)
+   {
+      REQUIRE(std::abs(d[i] - v[i]*w) <= tol);
+   }
+
+   z_ref = 0.0;
+   for (int i = 0; i < nv; i++) { z_ref.Add(a[i], v[i]); }
+   add(nv, a.data(), vp.data(), z);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-14);
+
+   // The output may be one of the first terms
+   z = v[1];
+   vp[1] = &z;
+   add(nv, a.data(), vp.data(), z);
+   REQUIRE(MaxDiff(z, z_ref) <= 1e-14);
+}
+
+TEST_CASE("Fused vector kernels", "[Vector]")
+{
+   TestFusedKernels();
+   {
+      Device device("threads");
+      TestFusedKernels();
+   }
+}
+
+TEST_CASE("Krylov solvers with fused vector kernels",
+          "[CGSolver][BiCGSTABSolver][MINRESSolver]")
+{
+   Mesh mesh(12, 12, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdofs, A);
+
+   const int n = A.Height();
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+   DSmoother jacobi(A);
+
+   for (int s = 0; s < 3; s++)
+   {
+      for (int p = 0; p < 2; p++)
+      {
+         IterativeSolver *solver;
+         if (s == 0) { solver = new CGSolver; }
+         else if (s == 1) { solver = new BiCGSTABSolver; }
+         else { solver = new MINRESSolver; }
+         solver->SetRelTol(1e-10);
+         solver->SetAbsTol(0.0);
+         solver->SetMaxIter(1000);
+         solver->SetOperator(A);
+         if (p == 1) { solver->SetPreconditioner(jacobi); }
+         x = 0.0;
+         solver->Mult(b, x);
+         REQUIRE(solver->GetConverged());
+         A.Mult(x, r);
+         r -= b;
+         REQUIRE(r.Norml2() <= 1e-8*b.Norml2());
+         delete solver;
+      }
+   }
+}
+
+} // namespace vector_fused